@@ -0,0 +1,56 @@
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+
+#include <functional>
+
+#include "rrcc/control_actions.hpp"
+#include "rrcc/process_manager.hpp"
+
+class QThread;
+
+namespace rrcc {
+
+class SectionStore;
+
+// Executes process control actions (signals, domain restarts) on a dedicated
+// high-priority thread so they never queue behind polls or ROS probes.
+class ActionExecutor final : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ActionExecutor(const SectionStore* sections);
+    ~ActionExecutor() override;
+
+    static bool handles(const QString& action);
+    // Pids of ROS processes, optionally restricted to one domain.
+    static QJsonArray rosPids(const QJsonArray& processes, const QString& domainId = QString());
+
+    // Called on the executor thread with the pids an action touched, so the
+    // process collector can re-read them ahead of its round-robin.
+    void setInvalidationHandler(std::function<void(const QJsonArray&)> handler);
+
+    void start();
+    void stop();
+
+public slots:
+    void execute(const QString& action, const QJsonObject& payload);
+
+signals:
+    void actionFinished(const QJsonObject& result);
+
+private:
+    void recordSignalLatency(const QJsonObject& payload) const;
+
+    const SectionStore* sections_;
+    // Only the stateless kill helpers are used; the collector keeps its own index.
+    ProcessManager processManager_;
+    ControlActions actions_;
+    std::function<void(const QJsonArray&)> invalidationHandler_;
+    QThread* thread_ = nullptr;
+};
+
+}  // namespace rrcc
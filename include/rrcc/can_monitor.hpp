@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QString>
+
+namespace rrcc {
+
+// SocketCAN interface state and counters from one rtnetlink RTM_GETLINK
+// dump: bitrate, controller state, bus error counters, frame counts, and
+// the kernel's CAN device statistics. Keeps the netlink socket open so a
+// sample costs a send and a recv, cheap enough for 10 Hz. Frame rates and
+// bus load are deltas against the previous sample.
+// Not thread-safe; owned by one collector.
+class CanMonitor final {
+public:
+    // Framing of a classic standard-ID frame, interframe space included:
+    // SOF, ID, RTR, IDE, r0, DLC, CRC, delimiters, ACK, EOF, IFS.
+    static constexpr int kFrameOverheadBits = 47;
+    // Average bit stuffing on real traffic; an estimate, not a bound.
+    static constexpr double kStuffingFactor = 1.1;
+
+    CanMonitor();
+    ~CanMonitor();
+
+    CanMonitor(const CanMonitor&) = delete;
+    CanMonitor& operator=(const CanMonitor&) = delete;
+
+    // Appends one object per CAN interface:
+    // {name, kind, up, bitrate, data_bitrate, state, berr: {tx, rx},
+    //  rx_frames, tx_frames, rx_bytes, tx_bytes, rx_errors, tx_errors,
+    //  rx_dropped, bus_errors, error_warning, error_passive, bus_off,
+    //  arbitration_lost, restarts, rx_fps, tx_fps, bus_load_percent}.
+    // False with error() set when netlink cannot be queried.
+    bool sample(QJsonArray* interfaces);
+    [[nodiscard]] QString error() const { return error_; }
+
+    static QString stateName(int state);
+
+private:
+    struct Counters {
+        quint64 rxFrames = 0;
+        quint64 txFrames = 0;
+        quint64 rxBytes = 0;
+        quint64 txBytes = 0;
+        qint64 atMs = 0;
+    };
+
+    bool openSocket();
+
+    int fd_ = -1;
+    quint32 seq_ = 0;
+    QString error_;
+    QElapsedTimer clock_;
+    // Previous counters by ifindex, for rates.
+    QHash<int, Counters> previous_;
+    // A dump reply part; one part carries several links.
+    char buffer_[32768];
+};
+
+}  // namespace rrcc
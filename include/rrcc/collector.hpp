@@ -0,0 +1,86 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <QStringList>
+
+#include "rrcc/collector_scheduler.hpp"
+#include "rrcc/resource_governor.hpp"
+
+namespace rrcc {
+
+// What a collector may ask of the worker during one run. The worker builds
+// one per run from the current view state; calls are safe from the lane.
+class CollectorContext {
+public:
+    virtual ~CollectorContext() = default;
+
+    // Freshness views asked for, in ms; -1 when nobody wants the section.
+    [[nodiscard]] virtual int freshness(const QString& section) const = 0;
+    // The tightest freshness of section and of everything derived from it,
+    // the watchdog included while it is enabled; -1 when nothing needs it.
+    [[nodiscard]] virtual int demandMs(const QString& section) const = 0;
+    // The tightest demandMs() among sections.
+    [[nodiscard]] int demandMs(const QStringList& sections) const {
+        int tightest = -1;
+        for (const QString& section : sections) {
+            const int value = demandMs(section);
+            if (value >= 0 && (tightest < 0 || value < tightest)) {
+                tightest = value;
+            }
+        }
+        return tightest;
+    }
+    // True while the enabled watchdog reads section, directly or not.
+    [[nodiscard]] virtual bool pinned(const QString& section) const = 0;
+    // True when key is due under the scheduler's plan; marks it refreshed.
+    virtual bool due(const QString& key, int freshnessMs, bool pinned = false) = 0;
+    // Charges the enclosing work, and the probes it spawns, to key in the
+    // scheduler's cost model.
+    [[nodiscard]] virtual CollectorScheduler::Run measure(const QString& key) = 0;
+
+    virtual void publish(const QString& section, const QJsonValue& value) = 0;
+    [[nodiscard]] virtual QJsonValue value(const QString& section) const = 0;
+    [[nodiscard]] virtual bool contains(const QString& section) const = 0;
+
+    [[nodiscard]] virtual QString selectedDomain() const = 0;
+    [[nodiscard]] virtual QString processScope() const = 0;
+    [[nodiscard]] virtual ResourceGovernor::Policy policy() const = 0;
+    // Runs the named collector's lane once delayMs has passed.
+    virtual void wake(const QString& collector, int delayMs = 0) = 0;
+    // True once the worker is shutting down; stop before the next probe.
+    [[nodiscard]] virtual bool cancelled() const = 0;
+};
+
+// One data source behind the snapshot. Register it with a CollectorRegistry
+// and its outputs join the delta sync, the scheduler and the telemetry.
+class Collector {
+public:
+    struct Traits {
+        // Collectors sharing a lane run in registration order on one thread.
+        QString lane;
+        int laneIntervalMs = 1000;
+        // Runs external tools (ros2, ssh, nvidia-smi) rather than reading
+        // /proc; these dominate the CPU budget.
+        bool spawnsProcesses = false;
+        // Floor on its outputs' freshness, whatever a client asks for.
+        int minFreshnessMs = 250;
+        // Sections it reads. A demand on its outputs becomes one on these.
+        QStringList inputs;
+        // Sections it serves other collectors but never sends to clients.
+        QStringList privateOutputs;
+    };
+
+    virtual ~Collector() = default;
+
+    [[nodiscard]] virtual QString name() const = 0;
+    // Snapshot sections it publishes.
+    [[nodiscard]] virtual QStringList outputs() const = 0;
+    [[nodiscard]] virtual Traits traits() const = 0;
+    // {"success": true}, plus "skipped" when nothing was due, or
+    // {"success": false, "error": ...}. Runs on the collector's lane.
+    virtual QJsonObject collect(CollectorContext& context) = 0;
+};
+
+}  // namespace rrcc
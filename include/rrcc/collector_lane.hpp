@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+
+#include <functional>
+
+class QThread;
+class QTimer;
+
+namespace rrcc {
+
+// Runs one collector family on a dedicated thread at its own cadence, so a
+// slow probe in one lane never holds back the others.
+class CollectorLane final : public QObject {
+    Q_OBJECT
+
+public:
+    CollectorLane(const QString& name, int intervalMs, std::function<void()> collect);
+    ~CollectorLane() override;
+
+    void start();
+    // Joins the lane thread; a run in progress finishes first.
+    void stop();
+    // Thread-safe; ends the lane after its current run without waiting.
+    void requestStop();
+    // Thread-safe; runs the collector once the lane is idle and delayMs has
+    // passed, unless its regular run is already due sooner.
+    void requestRun(int delayMs = 0);
+
+    [[nodiscard]] QString name() const { return name_; }
+
+private:
+    void runOnce();
+
+    QString name_;
+    int intervalMs_ = 1000;
+    std::function<void()> collect_;
+    QThread* thread_ = nullptr;
+    QTimer* timer_ = nullptr;
+};
+
+}  // namespace rrcc
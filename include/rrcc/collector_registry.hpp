@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "rrcc/collector.hpp"
+
+namespace rrcc {
+
+// Owns the collectors and the section dependency graph, and runs every
+// collector with the same telemetry: collector.<name>.runs, .skips, .errors,
+// .duration_ms and .staleness_ms (age of its last successful run).
+// Register everything before the lanes start; afterwards it is thread-safe.
+class CollectorRegistry final {
+public:
+    // Called on the collector's lane after every run.
+    using RunListener = std::function<void(const QString& name, const QJsonObject& result)>;
+
+    void add(std::unique_ptr<Collector> collector);
+    // A section assembled outside any collector (e.g. the watchdog) and the
+    // sections it reads.
+    void addDerived(const QString& section, const QStringList& inputs);
+    void setRunListener(RunListener listener) { listener_ = std::move(listener); }
+
+    // Lane names in registration order.
+    [[nodiscard]] QStringList lanes() const;
+    [[nodiscard]] int laneIntervalMs(const QString& lane) const;
+    [[nodiscard]] QList<Collector*> collectorsOn(const QString& lane) const;
+    [[nodiscard]] Collector* find(const QString& name) const;
+    // The collectors that must run for section to change: its producer, or
+    // for a derived section the producers of its inputs.
+    [[nodiscard]] QList<Collector*> producersFor(const QString& section) const;
+    // Snapshot sections published by collectors, in registration order.
+    [[nodiscard]] QStringList snapshotSections() const;
+    // Every section collectors publish or serve, private ones included.
+    [[nodiscard]] QStringList allOutputs() const;
+    // The freshest a client may ask section to be: its producer's floor, or
+    // the default floor for derived sections.
+    [[nodiscard]] int minFreshnessMs(const QString& section) const;
+    // section and everything derived from it, transitively.
+    [[nodiscard]] QStringList consumersOf(const QString& section) const;
+
+    QJsonObject run(Collector* collector, CollectorContext& context);
+    // Per collector counters and staleness; also refreshes the staleness gauges.
+    QJsonObject status();
+
+private:
+    struct Stats {
+        qint64 runs = 0;
+        qint64 skips = 0;
+        qint64 errors = 0;
+        qint64 lastDurationMs = 0;
+        qint64 lastSuccessEpochMs = 0;
+        QString lastError;
+    };
+
+    std::vector<std::unique_ptr<Collector>> collectors_;
+    // section -> sections computed directly from it.
+    QHash<QString, QStringList> consumers_;
+    // derived section -> its inputs.
+    QHash<QString, QStringList> derivedInputs_;
+    QHash<QString, Collector*> producers_;
+    RunListener listener_;
+
+    mutable QMutex mutex_;
+    QHash<QString, Stats> stats_;
+};
+
+}  // namespace rrcc
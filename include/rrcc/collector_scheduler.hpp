@@ -0,0 +1,82 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+
+namespace rrcc {
+
+// Plans how often each collector runs so that their combined CPU cost
+// (including spawned probes) stays within a share of one core. Costs are
+// measured per run and smoothed (EWMA). Collectors demand a freshness; when
+// the demands do not fit the budget, intervals stretch where that costs the
+// least weighted freshness: interval_k = max(freshness_k, mu * sqrt(cost_k /
+// weight_k)), with weight_k = 1000 / freshness_k and mu found by bisection.
+// Pinned collectors (watchdog inputs) never stretch but still use budget.
+// Thread-safe.
+class CollectorScheduler final {
+public:
+    // Measures one collector run from construction to destruction.
+    class Run final {
+    public:
+        Run(CollectorScheduler* scheduler, QString key);
+        ~Run();
+        Run(const Run&) = delete;
+        Run& operator=(const Run&) = delete;
+
+    private:
+        CollectorScheduler* scheduler_;
+        QString key_;
+        QElapsedTimer wall_;
+        qint64 threadCpuUs_ = 0;
+        qint64 childCpuUs_ = 0;
+    };
+
+    // Percent of one core; <= 0 plans every collector at its freshness.
+    void setBudgetPercent(double percent);
+    [[nodiscard]] double budgetPercent() const;
+
+    [[nodiscard]] Run measure(const QString& key) { return Run(this, key); }
+    // Records the demand and returns how long to wait between runs.
+    int plannedIntervalMs(const QString& key, int freshnessMs, bool pinned = false);
+    // The last planned interval for key, or -1 when it has no demand.
+    [[nodiscard]] int currentIntervalMs(const QString& key) const;
+    [[nodiscard]] QJsonObject status() const;
+    // {key: {cpu_ms, wall_ms, runs}}, for the warm start cache.
+    [[nodiscard]] QJsonObject exportCosts() const;
+    // Seeds the cost of keys not measured yet this run, so the first plan
+    // does not assume every collector is free.
+    void importCosts(const QJsonObject& costs);
+
+private:
+    struct Collector {
+        int freshnessMs = -1;
+        bool pinned = false;
+        double cpuMs = 0.0;
+        double wallMs = 0.0;
+        qint64 runs = 0;
+        int intervalMs = -1;
+        qint64 demandedEpochMs = 0;
+    };
+
+    static constexpr double kCostAlpha = 0.3;
+    // Nothing stretches beyond this, even when the budget cannot be met.
+    static constexpr int kMaxIntervalMs = 120000;
+
+    void record(const QString& key, double wallMs, double cpuMs);
+    void replanLocked();
+    [[nodiscard]] double plannedUsageLocked(double mu) const;
+    [[nodiscard]] int intervalLocked(const Collector& collector, double mu) const;
+
+    mutable QMutex mutex_;
+    QHash<QString, Collector> collectors_;
+    double budgetPercent_ = 20.0;
+    bool dirty_ = true;
+    qint64 plannedEpochMs_ = 0;
+    double plannedPercent_ = 0.0;
+    bool overBudget_ = false;
+};
+
+}  // namespace rrcc
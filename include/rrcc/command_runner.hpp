@@ -11,6 +11,9 @@ struct CommandResult {
     QString stdoutText;
     QString stderrText;
     bool timedOut = false;
+    // User plus system CPU of the command and the children it reaped; 0
+    // where the platform cannot report it.
+    qint64 cpuUs = 0;
 
     [[nodiscard]] bool success() const { return !timedOut && exitCode == 0; }
 };
@@ -27,6 +30,10 @@ public:
         const QString& command,
         int timeoutMs = 3000,
         const QMap<QString, QString>& extraEnv = {});
+
+    // Total cpuUs of the commands the calling thread has run, so a collector
+    // run is charged only for the probes it spawned itself.
+    static qint64 threadChildCpuUs();
 };
 
 }  // namespace rrcc
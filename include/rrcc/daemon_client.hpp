@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+
+class QIODevice;
+class QTimer;
+
+namespace rrcc {
+
+// Client side of the rosscoped socket API. Mirrors RuntimeWorker's slots and
+// signals so the UI can drive a daemon the same way it drives a local worker.
+class DaemonClient final : public QObject {
+    Q_OBJECT
+
+public:
+    explicit DaemonClient(const QString& endpoint, QObject* parent = nullptr);
+
+    void connectToDaemon();
+    [[nodiscard]] bool isConnected() const { return connected_; }
+    [[nodiscard]] QString endpoint() const { return endpoint_; }
+
+public slots:
+    void poll(const QJsonObject& request);
+    void runAction(const QString& action, const QJsonObject& payload);
+    void fetchNodeParameters(const QString& domainId, const QString& nodeName);
+
+signals:
+    void snapshotReady(const QJsonObject& snapshot);
+    void actionFinished(const QJsonObject& result);
+    void nodeParametersReady(const QJsonObject& result);
+    void connectionChanged(bool connected, const QString& message);
+
+private:
+    void send(const QJsonObject& message);
+    void readFrames();
+    void handleConnected();
+    void handleDisconnected(const QString& reason);
+
+    QString endpoint_;
+    QIODevice* socket_ = nullptr;
+    QTimer* reconnectTimer_ = nullptr;
+    QByteArray buffer_;
+    bool connected_ = false;
+    // Re-sent on reconnect so an in-flight refresh is not lost.
+    QJsonObject pendingPoll_;
+    bool pollPending_ = false;
+};
+
+}  // namespace rrcc
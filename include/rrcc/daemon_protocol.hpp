@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+#include "rrcc/snapshot_codec.hpp"
+
+namespace rrcc {
+
+// Wire format between rosscoped and attached clients: each message is a
+// 4-byte big-endian length, a one-byte encoding tag ('C' CBOR, 'J' JSON) and
+// the encoded object. Peers answer in the encoding they last received.
+class DaemonProtocol {
+public:
+    static constexpr const char* kDefaultSocketName = "rosscope";
+    static constexpr int kMaxFrameBytes = 64 * 1024 * 1024;
+
+    static QByteArray encode(
+        const QJsonObject& message,
+        SnapshotCodec::Format format = SnapshotCodec::Format::Cbor);
+    // Removes every complete frame from buffer; a partial frame stays for the
+    // next read. ok is cleared when the stream is corrupt; format reports the
+    // encoding of the last decoded frame.
+    static QList<QJsonObject> decode(
+        QByteArray& buffer,
+        bool* ok = nullptr,
+        SnapshotCodec::Format* format = nullptr);
+
+    // "host:port" selects TCP; anything else is a local socket name.
+    static bool isTcpEndpoint(const QString& endpoint);
+
+    // Any local user can reach the TCP port, so TCP clients may only run
+    // actions after a first frame {"type": "hello", "token": ...} with the
+    // token the daemon wrote here, readable by its own user only.
+    static QString tokenPath(quint16 port);
+    // Empty when the file is missing or unreadable.
+    static QByteArray readToken(quint16 port);
+};
+
+}  // namespace rrcc
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+#include "rrcc/self_usage.hpp"
+#include "rrcc/snapshot_codec.hpp"
+
+class QIODevice;
+class QLocalServer;
+class QTcpServer;
+class QThread;
+class QTimer;
+
+namespace rrcc {
+
+class RuntimeWorker;
+
+// Headless host for RuntimeWorker: serves snapshots, deltas and actions to
+// clients attached over a local socket or a localhost TCP port. Each client
+// either pulls deltas or subscribes to a set of sections at its own rate;
+// collection only runs for sections some client wants.
+class DaemonServer final : public QObject {
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString socketName;
+        quint16 tcpPort = 0;
+        // Poll cadence while no client is attached, so lanes, watchdog and
+        // session recording keep running.
+        int keepAliveMs = 1000;
+    };
+
+    explicit DaemonServer(const Options& options, QObject* parent = nullptr);
+    ~DaemonServer() override;
+
+    QJsonObject start();
+
+signals:
+    void pollRequested(const QJsonObject& request);
+    void actionRequested(const QString& action, const QJsonObject& payload);
+    void controlActionRequested(const QString& action, const QJsonObject& payload);
+    void nodeParametersRequested(const QString& domainId, const QString& nodeName);
+
+private:
+    struct Client {
+        QByteArray buffer;
+        // TCP clients run actions only after a hello with the token.
+        bool tcp = false;
+        bool greeted = false;
+        bool controlAllowed = true;
+        // Dropped for falling too far behind; closes on the next event loop turn.
+        bool closing = false;
+        // Answer in whatever encoding the client last spoke.
+        SnapshotCodec::Format format = SnapshotCodec::Format::Cbor;
+        // Pull mode ("poll"): one delta against the client's since_version.
+        bool pollPending = false;
+        qint64 pollSince = -1;
+        bool pulls = false;
+        // The sections the client's view renders and how fresh, from its
+        // last poll; without them the worker's defaults apply.
+        QJsonObject interests;
+        bool declaresInterests = false;
+        // Push mode ("subscribe"): sections (empty = all) at the client's rates.
+        bool subscribed = false;
+        QSet<QString> sections;
+        int intervalMs = 1000;
+        QHash<QString, int> sectionRateMs;
+        QHash<QString, qint64> sentVersions;
+        QHash<QString, qint64> sectionDueEpochMs;
+        qint64 nextDueEpochMs = 0;
+    };
+
+    void addClient(QIODevice* device, bool tcp);
+    void removeClient(QIODevice* device);
+    void readClient(QIODevice* device);
+    void handleMessage(QIODevice* device, const QJsonObject& message);
+    // A TCP client's first frame; true when it was a hello.
+    bool greet(QIODevice* device, const QJsonObject& message);
+    void writeTcpToken(QJsonObject* result);
+    void subscribe(QIODevice* device, const QJsonObject& message);
+    // False with a failed {type: replyType, result} reply when the client may
+    // not run actions or spawn probes.
+    bool controlAllowed(QIODevice* device, const QString& replyType, QJsonObject result);
+    // Every write goes here; a client over the backlog limit is disconnected.
+    bool writeFrame(QIODevice* device, const QByteArray& frame);
+    void send(QIODevice* device, const QJsonObject& message);
+    void broadcast(const QJsonObject& message);
+    void deliverSnapshot(const QJsonObject& snapshot);
+    void updateSectionInterest();
+    // Every client's wanted sections at the tightest freshness any asks for.
+    QJsonObject mergedInterests() const;
+    void requestWorkerPoll();
+    void schedulePush();
+    void keepAlive();
+    void sampleSelfUsage();
+
+    Options options_;
+    QThread* workerThread_ = nullptr;
+    RuntimeWorker* worker_ = nullptr;
+    QLocalServer* localServer_ = nullptr;
+    QTcpServer* tcpServer_ = nullptr;
+    // Empty when it could not be written: TCP clients are then read-only.
+    QByteArray tcpToken_;
+    QString tcpTokenPath_;
+    QHash<QIODevice*, Client> clients_;
+    // Latest filter fields (scope, query, domain, page) from any client; the
+    // worker keeps a single set. Interests are merged per poll instead.
+    QJsonObject viewRequest_;
+    qint64 lastSyncVersion_ = 0;
+    QTimer* pushTimer_ = nullptr;
+    QTimer* keepAliveTimer_ = nullptr;
+    QTimer* statsTimer_ = nullptr;
+    qint64 lastClientPollEpochMs_ = 0;
+    SelfUsage selfUsage_;
+};
+
+}  // namespace rrcc
@@ -21,6 +21,7 @@ public:
         const QJsonObject& graph,
         const QJsonObject& tfNav2,
         const QJsonObject& system,
+        const QJsonObject& thermal,
         const QJsonObject& health,
         const QJsonObject& parameters,
         bool deepSampling,
@@ -40,10 +41,14 @@ private:
     QJsonObject qosMismatchDetector(const QJsonObject& graph) const;
     QJsonObject lifecycleTimeline(const QJsonObject& tfNav2);
     QJsonObject executorLoadMonitor(const QJsonArray& processes, const QJsonObject& graph) const;
+    // One row per evaluation; correlates CPU spikes with ROS degradation and
+    // thermal throttling with topic rate drops.
     QJsonObject crossCorrelationTimeline(
         const QJsonObject& system,
+        const QJsonObject& thermal,
         const QJsonObject& graph,
-        const QJsonObject& tfNav2);
+        const QJsonObject& tfNav2,
+        const QJsonObject& topicRates);
     QJsonObject memoryLeakDetection(const QJsonArray& processes);
     QJsonObject ddsParticipantInspector(const QJsonArray& domains, const QJsonObject& health);
     QJsonObject networkSaturationMonitor(const QJsonObject& system, int pollIntervalMs);
@@ -78,6 +83,7 @@ private:
     QHash<QString, qint64> previousRxBytesByIface_;
     QHash<QString, qint64> previousTxBytesByIface_;
     QHash<QString, int> previousParticipantsByDomain_;
+    qint64 lastThrottleEvents_ = -1;
     QJsonArray timeline_;
     int timelineLimit_ = 600;
 };
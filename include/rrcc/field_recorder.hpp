@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include "rrcc/self_usage.hpp"
+#include "rrcc/snapshot_codec.hpp"
+
+class QFile;
+class QThread;
+class QTimer;
+
+namespace rrcc {
+
+class RuntimeWorker;
+
+// Record-only mode for unattended robots (`rosscoped --record`): polls a
+// RuntimeWorker at a low rate and appends each delta to an on-disk stream.
+// Files use the daemon framing (DaemonProtocol) and start with a header and
+// a full frame, so each rotated file can be read on its own.
+class FieldRecorder final : public QObject {
+    Q_OBJECT
+
+public:
+    struct Options {
+        QString directory = "sessions";
+        int intervalMs = 5000;
+        // Share of one core the whole process may use before it slows down.
+        double cpuCapPercent = 5.0;
+        qint64 rotateBytes = 64LL * 1024 * 1024;
+        int rotateMinutes = 60;
+        // Worker section names; empty records defaultSections(), plus
+        // "watchdog" when the loaded preset enables the watchdog.
+        QStringList sections;
+        SnapshotCodec::Format format = SnapshotCodec::Format::Cbor;
+    };
+
+    // Runtime state only. health is a pass over the ROS probes; the full
+    // diagnostics evaluation behind advanced (and the watchdog) is left out.
+    static const QStringList& defaultSections();
+
+    explicit FieldRecorder(const Options& options, QObject* parent = nullptr);
+    ~FieldRecorder() override;
+
+    QJsonObject start();
+
+signals:
+    void pollRequested(const QJsonObject& request);
+
+private:
+    void requestPoll();
+    void writeFrame(const QJsonObject& snapshot);
+    bool openNextFile();
+    void governCpu();
+
+    Options options_;
+    QThread* workerThread_ = nullptr;
+    RuntimeWorker* worker_ = nullptr;
+    QTimer* pollTimer_ = nullptr;
+    QTimer* governorTimer_ = nullptr;
+    QFile* file_ = nullptr;
+    qint64 fileOpenedEpochMs_ = 0;
+    int fileIndex_ = 0;
+    // -1 forces a full frame (first poll and after every rotation).
+    qint64 sinceVersion_ = -1;
+    // Poll interval multiplier; grows while over the CPU cap.
+    double slowdown_ = 1.0;
+    SelfUsage selfUsage_;
+};
+
+}  // namespace rrcc
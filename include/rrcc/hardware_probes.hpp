@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
+
+namespace rrcc {
+
+// The device probes behind the system section's gpus, usb_devices,
+// serial_ports and can_interfaces. Each probe's tool is looked up once; a
+// probe whose tool is missing or whose run fails is marked unavailable
+// and retried with exponential backoff instead of on every poll.
+// Inventories (USB, serial, CAN) are re-run only when a kernel uevent for
+// their subsystem arrives on the NETLINK_KOBJECT_UEVENT socket, and served
+// from cache in between. Without the socket they fall back to a slow timer.
+// Not thread-safe; owned by one SystemMonitor.
+class HardwareProbes final {
+public:
+    HardwareProbes();
+    ~HardwareProbes();
+
+    HardwareProbes(const HardwareProbes&) = delete;
+    HardwareProbes& operator=(const HardwareProbes&) = delete;
+
+    // Inserts every probe's section into system, running only the due ones.
+    void addTo(QJsonObject* system);
+    // {<section>: {state, tool, failures, retry_in_ms, age_ms}, hotplug}
+    [[nodiscard]] QJsonObject status() const;
+
+private:
+    static constexpr qint64 kInitialBackoffMs = 30000;
+    static constexpr qint64 kMaxBackoffMs = 30 * 60 * 1000;
+    // Inventory refresh when no uevent socket could be opened.
+    static constexpr qint64 kInventoryFallbackMs = 60000;
+
+    struct Probe {
+        QString section;
+        // Executable the probe needs; empty when it reads the filesystem.
+        QString tool;
+        // Returns false when the tool ran but failed.
+        std::function<bool(QJsonArray*)> run;
+        // uevent SUBSYSTEM values that invalidate the cache; empty for live
+        // probes, which run on every call.
+        QStringList subsystems;
+
+        bool toolChecked = false;
+        bool available = true;
+        bool stale = true;
+        int failures = 0;
+        qint64 retryAtMs = 0;
+        qint64 ranAtMs = 0;
+        QJsonArray cached;
+    };
+
+    void refresh(Probe* probe, qint64 nowMs);
+    // Marks inventories stale for each add/remove uevent queued since the
+    // last call.
+    void drainUevents();
+
+    QVector<Probe> probes_;
+    int ueventFd_ = -1;
+    bool ueventChecked_ = false;
+};
+
+}  // namespace rrcc
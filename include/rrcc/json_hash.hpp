@@ -0,0 +1,21 @@
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+namespace rrcc {
+
+// Fast non-cryptographic hash over the JSON structure (types, keys, values).
+// Used for change detection only; never for integrity or identity.
+class JsonHash {
+public:
+    static quint64 hash(const QJsonValue& value);
+    static quint64 hash(const QJsonObject& value);
+    static quint64 hash(const QJsonArray& value);
+    static quint64 hash(const QString& value);
+    static QString toHex(quint64 hash);
+};
+
+}  // namespace rrcc
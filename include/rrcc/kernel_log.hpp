@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+namespace rrcc {
+
+// Kernel log records read incrementally from /dev/kmsg into a fixed-size
+// ring, replacing a `dmesg | tail` spawn per refresh. The fd stays open and
+// non-blocking; poll() only drains records the kernel added since the last
+// call. Falls back to klogctl(2) when /dev/kmsg cannot be read (no
+// CAP_SYSLOG with kptr/dmesg restrictions, or no devtmpfs in a container).
+// Not thread-safe; owned by one collector.
+class KernelLog final {
+public:
+    struct Record {
+        quint64 seq = 0;
+        // Syslog priority 0 (emerg) .. 7 (debug).
+        int level = 6;
+        qint64 epochMs = 0;
+        QString text;
+    };
+
+    explicit KernelLog(int capacity = 300);
+    ~KernelLog();
+
+    KernelLog(const KernelLog&) = delete;
+    KernelLog& operator=(const KernelLog&) = delete;
+
+    // Reads new records into the ring. Returns how many arrived.
+    int poll();
+    // Ring contents, oldest first, with seq > afterSeq; -1 for all of it.
+    [[nodiscard]] QVector<Record> recordsAfter(qint64 afterSeq) const;
+    [[nodiscard]] quint64 lastSeq() const { return lastSeq_; }
+    // {source, last_seq, dropped, records: [{seq, level, epoch_ms, text}]}
+    // with the whole ring, or {source: "unavailable", error} when neither
+    // source can be read.
+    [[nodiscard]] QJsonObject toJson() const;
+
+    static QString levelName(int level);
+
+private:
+    enum class Source { None, Kmsg, Klogctl, Unavailable };
+
+    int pollKmsg();
+    int pollKlogctl();
+    void append(Record record);
+    // Epoch ms of a CLOCK_MONOTONIC timestamp, as the kernel stamps records.
+    static qint64 bootEpochMs();
+
+    QVector<Record> ring_;
+    int head_ = 0;
+    int size_ = 0;
+    quint64 lastSeq_ = 0;
+    qint64 dropped_ = 0;
+
+    Source source_ = Source::None;
+    QString error_;
+    int fd_ = -1;
+    // One /dev/kmsg record; a read with a shorter buffer fails with EINVAL.
+    char recordBuffer_[8192];
+    // klogctl has no sequence numbers: new lines are the ones after the last
+    // timestamp seen, counting duplicates of that timestamp.
+    QByteArray klogBuffer_;
+    qint64 klogLastUs_ = -1;
+    int klogSeenAtLast_ = 0;
+};
+
+}  // namespace rrcc
@@ -8,6 +8,7 @@
 #include <QMainWindow>
 #include <QPlainTextEdit>
 #include <QPushButton>
+#include <QSet>
 #include <QTableWidget>
 #include <QTabWidget>
 #include <QThread>
@@ -22,16 +23,20 @@
 
 namespace rrcc {
 
+class DaemonClient;
+
 class MainWindow final : public QMainWindow {
     Q_OBJECT
 
 public:
-    MainWindow();
+    // With an endpoint, attaches to a running rosscoped instead of starting a worker.
+    explicit MainWindow(const QString& attachEndpoint = QString());
     ~MainWindow() override;
 
 signals:
     void pollRequested(const QJsonObject& request);
     void actionRequested(const QString& action, const QJsonObject& payload);
+    void controlActionRequested(const QString& action, const QJsonObject& payload);
     void nodeParametersRequested(const QString& domainId, const QString& nodeName);
 
 private:
@@ -44,13 +49,16 @@ private:
     void scheduleRefresh(int delayMs = 0, bool force = false);
     QJsonObject buildPollRequest() const;
     QString selectedDomainId() const;
-    static qint64 processMemoryRssKb();
+    void updateGovernorLabel(const QJsonObject& governor);
+    void updateWarmStartLabel(const QJsonObject& warmSections);
     void updateProcessPaginationLabel();
     void pruneNodeParameterCache();
     void updateProcessScopeOptions();
     void applyProcessTableMode();
     bool isAllProcessesScopeActive() const;
 
+    void markPanelsDirty(const QString& section);
+    void markAllPanelsDirty();
     void renderFromSnapshot(const QJsonObject& snapshot);
     void renderProcesses();
     void renderDomains();
@@ -67,10 +75,18 @@ private:
 
     void runProcessAction(const QString& action);
     void runGlobalAction(const QString& action, const QJsonObject& payload = {});
+    void handleSnapshotReady(const QJsonObject& snapshot);
+    // Renders whatever the mailbox holds now; snapshots that arrived while
+    // the previous render ran are already merged into it.
+    void renderPendingSnapshot();
+    void handleActionFinished(const QJsonObject& result);
+    void handleNodeParametersReady(const QJsonObject& result);
     void showMessage(const QString& message, bool error = false) const;
 
     QThread* workerThread_ = nullptr;
     RuntimeWorker* worker_ = nullptr;
+    QString attachEndpoint_;
+    DaemonClient* daemonClient_ = nullptr;
 
     QJsonArray cachedProcessesAll_;
     QJsonArray cachedProcessesVisible_;
@@ -79,6 +95,8 @@ private:
     QJsonObject cachedGraph_;
     QJsonObject cachedTfNav2_;
     QJsonObject cachedSystem_;
+    QJsonObject cachedCan_;
+    QJsonObject cachedThermal_;
     QJsonObject cachedHealth_;
     QJsonObject cachedAdvanced_;
     QJsonObject cachedFleet_;
@@ -86,13 +104,19 @@ private:
     QJsonObject cachedWatchdog_;
     QJsonObject cachedNodeParameters_;
     qint64 cachedSyncVersion_ = -1;
+    QHash<QString, qint64> cachedSectionVersions_;
+    QSet<QString> dirtyPanels_;
+    // Sections that have rendered real data at least once (startup telemetry).
+    QSet<QString> firstRenderedSections_;
     QString cachedEtag_;
     int processOffset_ = 0;
     int processLimit_ = 400;
     int processTotalFiltered_ = 0;
     QStringList nodeParameterOrder_;
     int maxNodeParameterCache_ = 500;
-    QString cachedLogs_;
+    QJsonObject cachedLogs_;
+    // Highest kernel log seq already appended to logsText_; -1 before any.
+    qint64 lastRenderedLogSeq_ = -1;
     QString currentDomain_;
     QString lastProcessRenderHash_;
     QString lastDomainRenderHash_;
@@ -101,6 +125,9 @@ private:
     QComboBox* modeCombo_ = nullptr;
     QLabel* healthLabel_ = nullptr;
     QLabel* presetLabel_ = nullptr;
+    QLabel* governorLabel_ = nullptr;
+    QLabel* warmStartLabel_ = nullptr;
+    int governorLevel_ = 0;
     QPushButton* emergencyStopButton_ = nullptr;
     QPushButton* snapshotJsonButton_ = nullptr;
     QPushButton* snapshotYamlButton_ = nullptr;
@@ -121,6 +148,10 @@ private:
     QTimer* refreshDebounceTimer_ = nullptr;
     QTimer* eventLoopLagTimer_ = nullptr;
     QTimer* memoryWatchTimer_ = nullptr;
+    QTimer* renderTimer_ = nullptr;
+    // The worker's mailbox, or attachedMailbox_ when attached to a daemon.
+    SnapshotMailbox* mailbox_ = nullptr;
+    SnapshotMailbox attachedMailbox_;
     bool refreshInFlight_ = false;
     int refreshIntervalMs_ = 1500;
     int minRefreshIntervalMs_ = 500;
@@ -168,6 +199,10 @@ private:
     QVector<double> memHistory_;
     QVector<double> diskHistory_;
     QVector<double> netHistory_;
+    // Per-core usage, keyed by kernel cpu number.
+    QHash<int, QVector<double>> coreHistory_;
+    // system section version behind the newest history point.
+    qint64 historySystemVersion_ = -1;
     qint64 previousNetBytes_ = 0;
     qint64 previousNetSampleMs_ = 0;
     QPlainTextEdit* usbText_ = nullptr;
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+namespace rrcc {
+
+// Single full collection pass for scripts and CI (`rosscoped --once`).
+// Independent probes run on their own threads; whatever has not finished
+// when the time budget runs out is listed as missing instead of waited on.
+class OneShotCollector final {
+public:
+    struct Options {
+        QStringList sections;
+        int budgetMs = 5000;
+        // Empty selects the first domain with ROS processes.
+        QString domainId;
+    };
+
+    static const QStringList& allSections();
+    static const QStringList& defaultSections();
+
+    explicit OneShotCollector(Options options);
+    ~OneShotCollector();
+
+    // Blocks for at most the budget. The result has every collected section
+    // plus complete, missing_sections, duration_ms and domain_id.
+    QJsonObject collect();
+    // False when probes were still running at the deadline; they keep their
+    // own state alive and are abandoned, so exit the process soon after.
+    [[nodiscard]] bool complete() const { return complete_; }
+
+private:
+    struct State;
+
+    Options options_;
+    std::shared_ptr<State> state_;
+    bool complete_ = false;
+};
+
+}  // namespace rrcc
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <QMutex>
+#include <QtGlobal>
+
+namespace rrcc {
+
+// One "cpu" line of /proc/stat, in clock ticks.
+struct CpuTimes {
+    enum Field { User, Nice, System, Idle, IoWait, Irq, SoftIrq, Steal, Guest, GuestNice, FieldCount };
+    qulonglong field[FieldCount] = {};
+    // Sum of every field, and idle + iowait; computed at parse time.
+    qulonglong total = 0;
+    qulonglong idle = 0;
+};
+
+// One line ("some" or "full") of a /proc/pressure file.
+struct PressureLine {
+    double avg10 = 0.0;
+    double avg60 = 0.0;
+    double avg300 = 0.0;
+    // Cumulative stall time, in microseconds.
+    qulonglong totalUs = 0;
+};
+
+struct Pressure {
+    PressureLine some;
+    // Not reported for cpu on kernels before 5.13; stays zero there.
+    PressureLine full;
+    bool available = false;
+};
+
+// Host-wide counters from /proc/stat, /proc/meminfo, /proc/uptime and
+// /proc/pressure, parsed once per read.
+struct ProcSample {
+    static constexpr int kMaxCores = 128;
+    enum PressureResource { PressureCpu, PressureIo, PressureMemory, PressureCount };
+
+    CpuTimes cpu;
+    // cpu0..cpuN lines; coreIds keeps the kernel's numbering when some
+    // cores are offline.
+    CpuTimes cores[kMaxCores];
+    int coreIds[kMaxCores] = {};
+    int coreCount = 0;
+
+    // /proc/meminfo, in kB.
+    qulonglong memTotalKb = 0;
+    qulonglong memFreeKb = 0;
+    qulonglong memAvailableKb = 0;
+    qulonglong buffersKb = 0;
+    qulonglong cachedKb = 0;
+    qulonglong swapTotalKb = 0;
+    qulonglong swapFreeKb = 0;
+    qulonglong memUsedKb = 0;
+
+    Pressure pressure[PressureCount];
+
+    double uptimeSeconds = 0.0;
+    qint64 epochMs = 0;
+    bool valid = false;
+};
+
+// Keeps the files open and re-reads them with pread() at offset 0, so a
+// sample costs one syscall per file and no allocation. The system and
+// process collectors share one instance; a sample taken within
+// kShareWindowMs is handed to the next caller instead of being re-read.
+// Thread-safe.
+class ProcSampler final {
+public:
+    static ProcSampler& instance();
+
+    [[nodiscard]] ProcSample sample();
+
+    ProcSampler(const ProcSampler&) = delete;
+    ProcSampler& operator=(const ProcSampler&) = delete;
+
+private:
+    ProcSampler();
+    ~ProcSampler();
+
+    static constexpr int kShareWindowMs = 100;
+    // Only the cpu lines are parsed and they come first; the
+    // per-interrupt counts after them can run to tens of kB. 16 kB holds
+    // kMaxCores core lines.
+    static constexpr int kStatBytes = 16384;
+    static constexpr int kMemInfoBytes = 8192;
+    static constexpr int kUptimeBytes = 128;
+    static constexpr int kPressureBytes = 256;
+    // fd value for an optional file the kernel does not provide.
+    static constexpr int kUnavailableFd = -2;
+
+    // Bytes read into buffer, or -1. Reopens the file once on failure; an
+    // optional file that cannot be read is not tried again.
+    int readAt(int* fd, const char* path, char* buffer, int size, bool optional = false);
+    void closeAll();
+
+    QMutex mutex_;
+    int statFd_ = -1;
+    int memInfoFd_ = -1;
+    int uptimeFd_ = -1;
+    int pressureFds_[ProcSample::PressureCount] = {-1, -1, -1};
+    char statBuffer_[kStatBytes];
+    char memInfoBuffer_[kMemInfoBytes];
+    char uptimeBuffer_[kUptimeBytes];
+    char pressureBuffer_[kPressureBytes];
+    ProcSample last_;
+};
+
+}  // namespace rrcc
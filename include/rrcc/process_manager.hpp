@@ -25,6 +25,18 @@ public:
         bool sortByCpu = true);
     QJsonArray filterRosProcesses(const QJsonArray& processes) const;
     QJsonArray workspaceOrigins(const QJsonArray& processes) const;
+    // Re-reads these pids on the next refresh instead of waiting for the round-robin.
+    void invalidate(const QList<qint64>& pids);
+    // Caps the per-tick /proc read budget and the heavy-detail cache; a
+    // smaller cache is trimmed immediately.
+    void setLimits(int maxBudget, int maxHeavyCacheEntries);
+    // Reads every process on each refresh instead of a round-robin share,
+    // so two refreshes give every row a CPU delta. For one-shot probes.
+    void setFullScan(bool fullScan) { fullScan_ = fullScan; }
+    // ROS classification per live process, for the warm start cache.
+    // Imported entries are used once for a first row, then re-read.
+    QJsonArray exportClassifications() const;
+    void importClassifications(const QJsonArray& entries);
 
     bool terminateProcess(qint64 pid) const;
     bool forceKillProcess(qint64 pid) const;
@@ -60,6 +72,25 @@ private:
         int threadCount = 0;
     };
 
+    // Everything deep inspection derives from cmdline, exe and environ. It
+    // does not change while the process lives, so it is read once per pid
+    // and start time, and re-read only if the exe changes (an exec).
+    struct Classification {
+        qulonglong starttimeTicks = 0;
+        QString commandLine;
+        QString executable;
+        QString domainId = "0";
+        bool isRos = false;
+        QString nodeName;
+        QString nameSpace = "/";
+        QString workspaceOrigin;
+        QString packageName;
+        QString launchSource;
+        // Imported from a previous run and not yet re-read.
+        bool stale = false;
+        bool shown = false;
+    };
+
     struct HeapEntry {
         double metric = 0.0;
         qint64 pid = -1;
@@ -85,9 +116,6 @@ private:
         const QMap<QString, QString>& env);
     static double memoryPercentKb(qulonglong vmRssKb, qulonglong memTotalKb);
     static QString uptimeString(double seconds);
-    static qulonglong totalJiffies();
-    static qulonglong memoryTotalKb();
-    static double systemUptimeSeconds();
     static QList<qint64> listChildren(qint64 parentPid);
     static void collectChildrenRecursive(qint64 pid, QSet<qint64>& outSet);
     static QVector<qint64> listProcPids();
@@ -114,10 +142,17 @@ private:
     QHash<qint64, ProcLite> pidIndex_;
     QVector<qint64> rrPids_;
     int rrCursor_ = 0;
+    QSet<qint64> invalidatedPids_;
     qint64 tickCounter_ = 0;
     int updateBudgetPerTick_ = 260;
     int minBudget_ = 60;
     int maxBudget_ = 900;
+    bool fullScan_ = false;
+
+    QHash<qint64, Classification> classifications_;
+    // Drops imported entries whose process is gone, after the next scan.
+    bool pruneClassifications_ = false;
+    qint64 classificationHits_ = 0;
 
     QHash<qint64, ProcHeavy> heavyCache_;
     QQueue<qint64> heavyLru_;
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QMap>
@@ -24,13 +25,17 @@ public:
     void setTargets(const QJsonArray& targets);
     [[nodiscard]] QJsonArray targets() const;
 
-    QJsonObject collectFleetStatus(int timeoutMs = 4500) const;
+    // With dueRetriesOnly, only targets whose deferred retry is due are probed;
+    // the rest report their last known status.
+    QJsonObject collectFleetStatus(int timeoutMs = 4500, bool dueRetriesOnly = false) const;
     QJsonObject executeRemoteAction(
         const QString& targetName,
         const QString& action,
         const QString& domainId = "0",
         int timeoutMs = 4500);
     QJsonObject resumeQueuedActions(int budget = 3, int timeoutMs = 4500);
+    // Milliseconds until the next deferred status or action retry is due, -1 if none.
+    [[nodiscard]] qint64 nextRetryDelayMs() const;
 
 private:
     struct CircuitState {
@@ -41,6 +46,7 @@ private:
     static QJsonObject toJson(const Target& target);
     static Target fromJson(const QJsonObject& object);
     static QString hostKey(const Target& target);
+    static int retryBackoffMs(int attempt);
     QJsonObject executeRemoteActionInternal(
         const QString& targetName,
         const QString& action,
@@ -51,6 +57,7 @@ private:
     void onCircuitSuccess(const QString& key) const;
     void onCircuitFailure(const QString& key) const;
     QString queuePath() const;
+    void ensureQueueLoaded();
     void loadQueue();
     void persistQueue() const;
     void enqueueOfflineAction(const QJsonObject& action);
@@ -58,8 +65,11 @@ private:
     QJsonArray targets_;
     mutable QMap<QString, CircuitState> circuit_;
     mutable QJsonArray offlineQueue_;
+    bool queueLoaded_ = false;
+    // Status probes that failed once get one early retry at the due time.
+    mutable QHash<QString, qint64> statusRetryDueMs_;
+    mutable QHash<QString, QJsonObject> lastRobotStatus_;
     int maxOfflineQueue_ = 600;
-    int maxRetries_ = 3;
     int circuitFailureThreshold_ = 4;
     int circuitCooldownMs_ = 30000;
 };
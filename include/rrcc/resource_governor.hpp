@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QMutex>
+#include <QString>
+
+#include "rrcc/self_usage.hpp"
+
+namespace rrcc {
+
+// Keeps RosScope's own footprint inside a CPU and memory budget. Each
+// sample() reads this process (probe children included); a sustained
+// overrun steps one degradation level down, and a sustained margin steps
+// back up. Collectors read policy() and scale their work to it.
+// Thread-safe.
+class ResourceGovernor final {
+public:
+    enum class Level {
+        Normal = 0,
+        ReducedScan = 1,     // smaller per-tick process budget
+        SlowCollectors = 2,  // collector freshness stretched
+        ShrinkCaches = 3,    // history and caches trimmed
+        Minimal = 4,         // deep topic sampling paused
+    };
+
+    struct Budgets {
+        // Percent of one core.
+        double cpuPercent = 25.0;
+        qint64 rssKb = 800 * 1024;
+    };
+
+    struct Policy {
+        int processBudget = 900;
+        int heavyCacheEntries = 256;
+        // Multiplier on every view's freshness; the watchdog is exempt.
+        double freshnessScale = 1.0;
+        int sessionSamples = 1500;
+        int parameterCacheEntries = 500;
+        bool deepSampling = true;
+    };
+
+    static Policy policyFor(Level level);
+    static QString levelName(Level level);
+
+    void setBudgets(const Budgets& budgets);
+    [[nodiscard]] Budgets budgets() const;
+    // Samples usage and moves at most one level; true when the level changed.
+    bool sample();
+    [[nodiscard]] Level level() const;
+    [[nodiscard]] Policy policy() const;
+    [[nodiscard]] QJsonObject status() const;
+
+private:
+    mutable QMutex mutex_;
+    SelfUsage usage_;
+    Budgets budgets_;
+    Level level_ = Level::Normal;
+    double cpuPercent_ = 0.0;
+    qint64 rssKb_ = 0;
+    int overSamples_ = 0;
+    int underSamples_ = 0;
+    qint64 changedEpochMs_ = 0;
+};
+
+}  // namespace rrcc
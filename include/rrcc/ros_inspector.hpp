@@ -21,9 +21,10 @@ public:
     QJsonObject inspectGraph(const QString& domainId, const QJsonArray& processes) const;
     QJsonObject inspectTfNav2(const QString& domainId) const;
     QJsonObject fetchNodeParameters(const QString& domainId, const QString& nodeName) const;
+    // Spawns a login shell once; the answer is cached afterwards.
+    bool isRos2Available() const;
 
 private:
-    bool isRos2Available() const;
 
     static QMap<QString, QString> rosEnv(const QString& domainId);
     static QStringList parseLines(const QString& text);
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <atomic>
+
+#include "rrcc/can_monitor.hpp"
+#include "rrcc/collector.hpp"
+#include "rrcc/diagnostics_engine.hpp"
+#include "rrcc/health_monitor.hpp"
+#include "rrcc/kernel_log.hpp"
+#include "rrcc/process_manager.hpp"
+#include "rrcc/remote_monitor.hpp"
+#include "rrcc/ros_inspector.hpp"
+#include "rrcc/system_monitor.hpp"
+#include "rrcc/thermal_monitor.hpp"
+
+namespace rrcc {
+
+// The RuntimeWorker's built-in collectors. Each wraps a service the worker
+// owns (it is shared with actions and the warm-start cache) and only touches
+// it from its own lane unless noted.
+
+// The /proc process scan and the per-domain summary derived from it.
+class ProcessCollector final : public Collector {
+public:
+    // listDomains() is pure, so the inspector may be shared with the ROS lane.
+    ProcessCollector(ProcessManager* processManager, const RosInspector* rosInspector);
+
+    QString name() const override { return "processes"; }
+    QStringList outputs() const override { return {"domain_summaries"}; }
+    Traits traits() const override;
+    QJsonObject collect(CollectorContext& context) override;
+
+    // Thread-safe; the next run re-reads these pids whatever the freshness.
+    void invalidate(const QList<qint64>& pids);
+
+private:
+    ProcessManager* processManager_;
+    const RosInspector* rosInspector_;
+    QMutex invalidationMutex_;
+    QList<qint64> invalidatedPids_;
+};
+
+// Host load from /proc plus device probes, and the kernel log ring.
+class SystemCollector final : public Collector {
+public:
+    explicit SystemCollector(SystemMonitor* systemMonitor);
+
+    QString name() const override { return "system"; }
+    QStringList outputs() const override { return {"system", "logs"}; }
+    Traits traits() const override;
+    QJsonObject collect(CollectorContext& context) override;
+
+private:
+    SystemMonitor* systemMonitor_;
+    KernelLog kernelLog_;
+};
+
+// SocketCAN state, error counters, frame rates and bus load over rtnetlink.
+class CanCollector final : public Collector {
+public:
+    // Lets a client asking for "can" at 100 ms get it; the section's
+    // freshness still decides how often the dump actually runs.
+    static constexpr int kLaneIntervalMs = 100;
+
+    QString name() const override { return "can"; }
+    QStringList outputs() const override { return {"can"}; }
+    Traits traits() const override;
+    QJsonObject collect(CollectorContext& context) override;
+
+private:
+    CanMonitor canMonitor_;
+};
+
+// Thermal zones, CPU frequency caps and throttle counters from sysfs.
+class ThermalCollector final : public Collector {
+public:
+    QString name() const override { return "thermal"; }
+    QStringList outputs() const override { return {"thermal"}; }
+    Traits traits() const override;
+    QJsonObject collect(CollectorContext& context) override;
+
+private:
+    ThermalMonitor thermalMonitor_;
+};
+
+// Domain details, the selected domain's graph and TF/Nav2 state via ros2.
+class RosCollector final : public Collector {
+public:
+    explicit RosCollector(RosInspector* rosInspector);
+
+    QString name() const override { return "ros"; }
+    QStringList outputs() const override { return {"domains", "graph", "tf_nav2"}; }
+    Traits traits() const override;
+    QJsonObject collect(CollectorContext& context) override;
+
+private:
+    RosInspector* rosInspector_;
+};
+
+// Health and the advanced diagnostics, judged from the other collectors.
+class DiagnosticsCollector final : public Collector {
+public:
+    DiagnosticsCollector(HealthMonitor* healthMonitor, DiagnosticsEngine* diagnosticsEngine);
+
+    QString name() const override { return "diagnostics"; }
+    QStringList outputs() const override { return {"health", "advanced"}; }
+    Traits traits() const override;
+    QJsonObject collect(CollectorContext& context) override;
+
+    // Thread-safe; applied before the next evaluation.
+    void setExpectedProfile(const QJsonObject& profile);
+
+private:
+    HealthMonitor* healthMonitor_;
+    DiagnosticsEngine* diagnosticsEngine_;
+    QMutex profileMutex_;
+    QJsonObject pendingProfile_;
+    bool profileDirty_ = false;
+};
+
+// Fleet status sweeps and delivery of queued remote actions.
+class FleetCollector final : public Collector {
+public:
+    static constexpr int kSweepIntervalMs = 6000;
+
+    // The monitor is shared with fleet actions; both lock fleetMutex.
+    FleetCollector(RemoteMonitor* remoteMonitor, QMutex* fleetMutex);
+
+    QString name() const override { return "fleet"; }
+    QStringList outputs() const override { return {"fleet"}; }
+    Traits traits() const override;
+    QJsonObject collect(CollectorContext& context) override;
+
+    // Thread-safe; the next run sweeps every target, not just due retries.
+    void requestSweep() { sweepRequested_ = true; }
+
+private:
+    RemoteMonitor* remoteMonitor_;
+    QMutex* fleetMutex_;
+    std::atomic<bool> sweepRequested_{false};
+    // Only touched from the fleet lane.
+    qint64 nextSweepEpochMs_ = 0;
+};
+
+}  // namespace rrcc
@@ -1,30 +1,70 @@
 #pragma once
 
 #include <QObject>
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QList>
+#include <QMutex>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 
-#include "rrcc/control_actions.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+#include "rrcc/action_executor.hpp"
+#include "rrcc/collector_lane.hpp"
+#include "rrcc/collector_registry.hpp"
+#include "rrcc/collector_scheduler.hpp"
 #include "rrcc/diagnostics_engine.hpp"
 #include "rrcc/health_monitor.hpp"
 #include "rrcc/process_manager.hpp"
 #include "rrcc/remote_monitor.hpp"
+#include "rrcc/resource_governor.hpp"
+#include "rrcc/runtime_collectors.hpp"
 #include "rrcc/ros_inspector.hpp"
+#include "rrcc/section_store.hpp"
 #include "rrcc/session_recorder.hpp"
 #include "rrcc/snapshot_manager.hpp"
 #include "rrcc/snapshot_diff.hpp"
+#include "rrcc/snapshot_mailbox.hpp"
 #include "rrcc/system_monitor.hpp"
+#include "rrcc/warm_start_cache.hpp"
+#include "rrcc/watchdog_engine.hpp"
 
 namespace rrcc {
 
-// Background worker that polls ROS/system state and executes control actions.
+// Background worker that assembles snapshots from independent collector
+// lanes and runs export, session and fleet actions. Process control actions
+// run on its ActionExecutor.
 class RuntimeWorker final : public QObject {
     Q_OBJECT
 
 public:
     explicit RuntimeWorker(QObject* parent = nullptr);
+    ~RuntimeWorker() override;
+
+    // Control actions bypass the worker queue; connect to this directly.
+    [[nodiscard]] ActionExecutor* actionExecutor() const { return actionExecutor_.get(); }
+    // Consumers connected to snapshotAvailable() take the newest snapshot
+    // from here when they are ready to render; see SnapshotMailbox.
+    [[nodiscard]] SnapshotMailbox* snapshotMailbox() { return &mailbox_; }
+    // Thread-safe. Lanes only collect sections some consumer wants; "*" means
+    // every section (the default for the embedded UI).
+    void setSectionInterest(const QStringList& sections);
+    // Call before the first poll. Recordings turn this off so cached data
+    // never ends up in a recorded frame.
+    void setWarmStartEnabled(bool enabled) { warmStartEnabled_ = enabled; }
+    // Thread-safe. Set by the loaded preset and the watchdog action.
+    [[nodiscard]] bool watchdogEnabled() const { return watchdogEnabled_.load(); }
+    // Thread-safe. Share of one core the collectors may use together.
+    void setCollectorBudgetPercent(double percent) { scheduler_.setBudgetPercent(percent); }
+    // The freshness applied to a request without "interests", in that form.
+    static QJsonObject defaultInterests();
 
 public slots:
     void poll(const QJsonObject& request);
@@ -33,11 +73,67 @@ public slots:
 
 signals:
     void snapshotReady(const QJsonObject& snapshot);
+    // The mailbox went from empty to holding a snapshot.
+    void snapshotAvailable();
     void actionFinished(const QJsonObject& result);
     void nodeParametersReady(const QJsonObject& result);
 
 private:
+    class LaneContext;
+
+    // View state the collector lanes need; copied out of the latest request.
+    struct PollConfig {
+        QString processScope = "ROS Only";
+        QString processQuery;
+        QString selectedDomain = "0";
+        // How stale each declared section may get, in ms. Views declare the
+        // sections they render ("interests"); nothing else is collected.
+        QHash<QString, int> freshnessMs;
+        // Sections any attached consumer accepts; "*" means all of them.
+        QSet<QString> interest = {QString("*")};
+
+        // Freshness of a wanted section, or -1 when nobody needs it.
+        [[nodiscard]] int freshness(const QString& section) const {
+            // domain_detail is the selected domain's slice of "domains".
+            const QString owner = section == "domain_detail" ? QString("domains") : section;
+            if (!interest.contains(QString("*")) && !interest.contains(owner)) {
+                return -1;
+            }
+            return freshnessMs.value(section, -1);
+        }
+        // The tightest freshness among the wanted sections, or -1.
+        [[nodiscard]] int freshness(const QStringList& sections) const {
+            int tightest = -1;
+            for (const QString& section : sections) {
+                const int value = freshness(section);
+                if (value >= 0 && (tightest < 0 || value < tightest)) {
+                    tightest = value;
+                }
+            }
+            return tightest;
+        }
+        [[nodiscard]] bool wantsAny(const QStringList& sections) const {
+            return freshness(sections) >= 0;
+        }
+    };
+
+    void runScheduledPoll();
     void pollNow();
+    // Latest-wins hand-off to a connected consumer; adapts consumerBackoffMs_.
+    void deliverToMailbox(const QJsonObject& delta);
+    void ensureCollectorLanes();
+    void updatePollConfig(const QJsonObject& request);
+    PollConfig pollConfig() const;
+    // True when a section is due under the scheduler's planned interval for
+    // its freshness; marks it refreshed. Pinned sections are never stretched.
+    bool refreshDue(const QString& key, int freshnessMs, bool pinned = false);
+    // How long a consumer can wait before anything it wants is due again.
+    int suggestedPollIntervalMs(const PollConfig& config) const;
+    // Thread-safe; runs the named collector's lane once delayMs has passed.
+    void wakeCollector(const QString& name, int delayMs = 0);
+    void scheduleFleetRetryLocked();
+    // Thread-safe; the process collector re-reads these pids on its next run.
+    void invalidateProcesses(const QJsonArray& pids);
     QJsonArray applyProcessFilter(
         const QJsonArray& processes,
         bool rosOnly,
@@ -45,67 +141,117 @@ private:
         const QString& scope) const;
     QJsonObject buildResponse(
         const QString& selectedDomain,
-        const QJsonArray& allProcesses,
         const QJsonArray& visibleProcesses,
-        const QJsonArray& domainSummaries,
-        const QJsonArray& domainDetails,
-        const QJsonObject& graph,
-        const QJsonObject& tfNav2,
-        const QJsonObject& system,
-        const QString& logs,
-        const QJsonObject& health,
-        const QJsonObject& advanced,
-        const QJsonObject& fleet,
-        const QJsonObject& session,
-        const QJsonObject& watchdog) const;
-    void applyWatchdog(const QString& selectedDomain);
+        const SectionStore::Sections& sections) const;
+    // Runs on whichever thread published the section.
+    void handleSectionPublished(const QString& name, const SectionStore::SectionPtr& section);
+    // Records time to first data and pushes the section without waiting
+    // for the consumer's next poll.
+    void noteFirstData(const QString& name);
+    void pushFirstData();
+    // Publishes the previous run's sections as stale; before the lanes start.
+    void loadWarmStart();
+    // Once the process lane has stopped; other lanes may still be running.
+    void saveWarmStart();
+    void seedWatchdog();
+    void armWatchdogTimer();
+    void dispatchWatchdog(const QList<WatchdogEngine::Firing>& firings);
+    void publishWatchdogSection();
+    // Worker thread; samples the governor and applies a new level.
+    void sampleGovernor();
+    void applyGovernorPolicy();
     QJsonObject saveRuntimePreset(const QString& name) const;
     QJsonObject loadRuntimePreset(const QString& name);
     void pruneParameterCache();
+    void publishParameterCache();
 
+    // Owned by the process lane (kill helpers are stateless and shared).
     ProcessManager processManager_;
+    // Owned by the ROS lane; listDomains() is pure and also used by the process lane.
     RosInspector rosInspector_;
     HealthMonitor healthMonitor_;
+    DiagnosticsEngine diagnosticsEngine_;
+    // Owned by the system lane.
+    SystemMonitor systemMonitor_;
+    // Shared between the fleet lane and fleet actions; guarded by fleetMutex_.
+    RemoteMonitor remoteMonitor_;
+    mutable QMutex fleetMutex_;
+    // Owned by the worker thread.
+    RosInspector parameterInspector_;
     SnapshotManager snapshotManager_;
     SnapshotDiff snapshotDiff_;
     SessionRecorder sessionRecorder_;
-    DiagnosticsEngine diagnosticsEngine_;
-    RemoteMonitor remoteMonitor_;
-    SystemMonitor systemMonitor_;
-    ControlActions actions_;
+    WatchdogEngine watchdogEngine_;
+    // Sampled on the worker thread; lanes read its policy.
+    ResourceGovernor governor_;
+    CollectorScheduler scheduler_;
+
+    SectionStore sectionStore_;
+    std::unique_ptr<ActionExecutor> actionExecutor_;
+    // Collectors wrap the services above; registered in the constructor.
+    CollectorRegistry collectorRegistry_;
+    ProcessCollector* processCollector_ = nullptr;
+    DiagnosticsCollector* diagnosticsCollector_ = nullptr;
+    FleetCollector* fleetCollector_ = nullptr;
+    // Every snapshot section, collectors' and the worker's own.
+    QStringList deltaSections_;
+    std::vector<std::unique_ptr<CollectorLane>> lanes_;
+    // Filled before the lanes start; read-only afterwards.
+    QHash<QString, CollectorLane*> lanesByName_;
+    mutable QMutex configMutex_;
+    PollConfig config_;
+    QJsonObject expectedProfile_;
+    QMutex freshnessMutex_;
+    QHash<QString, qint64> refreshedEpochMs_;
+    mutable QMutex startupMutex_;
+    QSet<QString> firstDataSections_;
+    // Sections still showing the previous run's data -> when it was collected.
+    QHash<QString, qint64> warmSections_;
+    WarmStartCache warmStartCache_;
+    bool warmStartEnabled_ = true;
+    // As loaded; read again when saving and for parameter change checks.
+    QJsonObject warmState_;
+    std::atomic<bool> loadingWarmStart_{false};
 
     QJsonObject request_;
-    bool busy_ = false;
-    bool pending_ = false;
+    QTimer* pollTimer_ = nullptr;
+    qint64 pollDeadlineEpochMs_ = 0;
     int pollCounter_ = 0;
     qint64 lastPollEpochMs_ = 0;
     int minPollIntervalMs_ = 350;
+    // minPollIntervalMs_, or the tightest wanted freshness when lower.
+    int pollSpacingMs_ = 350;
+    static constexpr int kMaxIdleBackoffMs = 12000;
     int idleBackoffMs_ = 1000;
-    int maxBackoffMs_ = 12000;
-    int consecutiveNoChangePolls_ = 0;
+    SnapshotMailbox mailbox_;
+    // Extra poll spacing while the mailbox consumer lags; 0 when it keeps up.
+    int consumerBackoffMs_ = 0;
     qint64 syncVersion_ = 0;
     QString lastSyncFingerprint_;
+    // Per-section store generation and the sync version at which it last changed.
+    QHash<QString, qint64> lastSectionGenerations_;
+    QHash<QString, qint64> sectionChangeVersions_;
     int maxParameterCacheEntries_ = 500;
     QStringList parameterCacheOrder_;
 
-    QJsonArray lastAllProcesses_;
     QJsonArray lastVisibleProcesses_;
-    QJsonArray lastDomainSummaries_;
-    QJsonArray lastDomainDetails_;
-    QJsonObject lastGraph_;
-    QJsonObject lastTfNav2_;
-    QJsonObject lastSystem_;
-    QString lastLogs_;
-    QJsonObject lastHealth_;
+    QString visiblePageKey_;
+    int lastFilteredTotalCount_ = 0;
     QJsonObject parameterCache_;
-    QJsonObject lastAdvanced_;
-    QJsonObject lastFleet_;
-    QJsonObject lastWatchdog_;
-    QJsonObject previousSnapshot_;
-    QJsonObject penultimateSnapshot_;
+    SectionStore::Frame previousFrame_;
+    SectionStore::Frame penultimateFrame_;
     QString presetName_ = "default";
-    bool watchdogEnabled_ = false;
+    std::atomic<bool> watchdogEnabled_{false};
+    // A recording needs every section regardless of subscriptions.
+    std::atomic<bool> recording_{false};
+    // Set on destruction; lanes and collectors stop between probes.
+    std::atomic<bool> stopping_{false};
+    QTimer* watchdogTimer_ = nullptr;
+    QTimer* governorTimer_ = nullptr;
+    static constexpr int kGovernorSampleIntervalMs = 5000;
+    QMutex watchdogMutex_;
     qint64 lastWatchdogActionMs_ = 0;
+    QString lastWatchdogMessage_;
 };
 
 }  // namespace rrcc
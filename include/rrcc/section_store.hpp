@@ -0,0 +1,83 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace rrcc {
+
+// Latest published value of every snapshot section. Collectors publish from
+// their own threads; the snapshot builder copies the current set without
+// waiting on any producer.
+// A section's version only advances when its structural hash changes, so the
+// version doubles as a generation counter for change detection.
+class SectionStore {
+public:
+    // Published sections are never modified, only replaced, so the worker's
+    // history, the session recorder and the UI can all hold the same one.
+    struct Section {
+        QJsonValue value;
+        qint64 version = 0;
+        quint64 hash = 0;
+        qint64 changedEpochMs = 0;
+        qint64 approxBytes = 0;
+    };
+    using SectionPtr = std::shared_ptr<const Section>;
+
+    // A set of section references; copying it never copies section data.
+    class Sections {
+    public:
+        // Returns an empty section for unknown names.
+        [[nodiscard]] const Section& value(const QString& name) const;
+        [[nodiscard]] SectionPtr ptr(const QString& name) const { return sections_.value(name); }
+        [[nodiscard]] bool contains(const QString& name) const { return sections_.contains(name); }
+        [[nodiscard]] bool isEmpty() const { return sections_.isEmpty(); }
+        [[nodiscard]] QStringList names() const { return sections_.keys(); }
+        void insert(const QString& name, const SectionPtr& section);
+        void remove(const QString& name) { sections_.remove(name); }
+        [[nodiscard]] qint64 approxBytes() const;
+
+    private:
+        QHash<QString, SectionPtr> sections_;
+    };
+
+    // One assembled response: shared sections plus its small scalar fields.
+    struct Frame {
+        Sections sections;
+        QJsonObject meta;
+
+        [[nodiscard]] QJsonObject toJson() const;
+    };
+
+    // Called on the publishing thread after a section changed.
+    using PublishListener = std::function<void(const QString& name, const SectionPtr& section)>;
+
+    SectionStore() = default;
+
+    // Set once, before any collector publishes.
+    void setPublishListener(PublishListener listener) { listener_ = std::move(listener); }
+    qint64 publish(const QString& name, const QJsonValue& value);
+    [[nodiscard]] Section section(const QString& name) const;
+    [[nodiscard]] QJsonValue value(const QString& name) const;
+    [[nodiscard]] qint64 version(const QString& name) const;
+    [[nodiscard]] bool contains(const QString& name) const;
+    [[nodiscard]] Sections sections() const;
+    [[nodiscard]] qint64 latestVersion() const;
+    // Approximate bytes and version of every section.
+    [[nodiscard]] QJsonObject memoryReport() const;
+
+private:
+    mutable QMutex mutex_;
+    Sections sections_;
+    qint64 latestVersion_ = 0;
+    PublishListener listener_;
+};
+
+}  // namespace rrcc
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QString>
+#include <QtGlobal>
+
+namespace rrcc {
+
+// CPU and memory used by this process, including the probe processes it
+// spawns. CPU comes from the cgroup when RosScope has a cgroup v2 to itself
+// (which also covers children that are still running); otherwise from
+// /proc/self, where children count once they have been reaped.
+class SelfUsage final {
+public:
+    // Percent of one core used since the previous call; -1 on the first
+    // call and whenever the source changes.
+    double sampleCpuPercent();
+    // "cgroup" or "proc", as used by the last sample.
+    [[nodiscard]] QString source() const { return lastSource_; }
+    static qint64 rssKb();
+
+private:
+    qulonglong lastCpuUs_ = 0;
+    qint64 lastEpochMs_ = 0;
+    QString lastSource_;
+    QString cgroupDir_;
+    bool cgroupResolved_ = false;
+};
+
+}  // namespace rrcc
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QQueue>
 #include <QString>
 
+#include "rrcc/section_store.hpp"
+
 namespace rrcc {
 
 class SessionRecorder {
@@ -12,7 +16,11 @@ public:
 
     QJsonObject start(const QString& sessionName);
     QJsonObject stop();
-    void recordSample(const QJsonObject& snapshot);
+    // Samples keep references to the published sections, so an unchanged
+    // section costs nothing per sample.
+    void recordSample(const SectionStore::Frame& frame);
+    // Drops the oldest samples when the cap shrinks.
+    void setMaxSamples(int maxSamples);
     QJsonObject status() const;
     QJsonObject exportSession(const QString& format = "json") const;
 
@@ -21,8 +29,14 @@ private:
     QString sessionName_;
     QString startedUtc_;
     QString endedUtc_;
-    QJsonArray samples_;
+    void retain(const SectionStore::Frame& frame);
+    void release(const SectionStore::Frame& frame);
+
+    QQueue<SectionStore::Frame> samples_;
     int maxSamples_ = 1500;
+    // Distinct sections held by samples_, for retained_bytes.
+    QHash<const SectionStore::Section*, int> sectionRefs_;
+    qint64 retainedBytes_ = 0;
 };
 
 }  // namespace rrcc
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+
+namespace rrcc {
+
+// Binary (CBOR) and text (JSON) encodings of snapshot-shaped objects. CBOR is
+// used on the daemon socket and for recorded sessions; JSON stays the
+// human-readable export format.
+class SnapshotCodec {
+public:
+    enum class Format { Json, Cbor };
+
+    static QByteArray encode(const QJsonObject& object, Format format);
+    // Returns false (and leaves out untouched) on malformed input.
+    static bool decode(const QByteArray& bytes, Format format, QJsonObject* out);
+
+    // ".cbor" selects CBOR; everything else is JSON.
+    static Format formatForPath(const QString& path);
+    static QString extension(Format format);
+    static QJsonObject readFile(const QString& path);
+};
+
+}  // namespace rrcc
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QMutex>
+#include <QtGlobal>
+
+namespace rrcc {
+
+// Latest-wins hand-off of snapshots to a consumer that renders at its own
+// pace. A snapshot put while the previous one is still waiting is merged
+// into it (newer sections and fields win; sections only the older delta
+// carried are kept), so the consumer never replays a backlog.
+// Thread-safe.
+class SnapshotMailbox final {
+public:
+    // True when the mailbox was empty, i.e. the consumer needs a nudge.
+    bool put(const QJsonObject& snapshot);
+    // The pending snapshot, or an empty object.
+    QJsonObject take();
+    [[nodiscard]] bool hasPending() const;
+    // ms the last taken snapshot waited, from its first put to take().
+    [[nodiscard]] qint64 lastWaitMs() const;
+    // Snapshots merged away instead of being delivered.
+    [[nodiscard]] qint64 coalescedCount() const;
+
+    static QJsonObject merge(const QJsonObject& older, const QJsonObject& newer);
+
+private:
+    mutable QMutex mutex_;
+    QJsonObject pending_;
+    bool hasPending_ = false;
+    qint64 pendingSinceEpochMs_ = 0;
+    qint64 lastWaitMs_ = 0;
+    qint64 coalesced_ = 0;
+};
+
+}  // namespace rrcc
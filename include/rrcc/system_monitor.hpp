@@ -4,6 +4,9 @@
 #include <QJsonArray>
 #include <QJsonObject>
 
+#include "rrcc/hardware_probes.hpp"
+#include "rrcc/proc_sampler.hpp"
+
 namespace rrcc {
 
 class SystemMonitor {
@@ -11,21 +14,26 @@ public:
     SystemMonitor() = default;
 
     QJsonObject collectSystem();
-    QString tailDmesg(int lines) const;
+    // CPU (aggregate and per core), memory, PSI, disk and network from /proc
+    // and statfs; spawns nothing.
+    QJsonObject collectCore();
+    // Adds gpus, usb_devices, serial_ports and can_interfaces, which run
+    // external tools and can take seconds, plus device_probes. Inventories
+    // come from cache until a hotplug event; see HardwareProbes.
+    void addDeviceProbes(QJsonObject* system);
 
 private:
-    static QJsonObject cpuSnapshot();
-    static QJsonObject memorySnapshot();
+    // usage_percent plus user/system/iowait/irq/softirq/steal splits over
+    // the interval between two samples.
+    static QJsonObject cpuUsage(const CpuTimes& current, const CpuTimes& previous);
+    // PSI averages and stall time since the previous sample, per resource.
+    static QJsonObject pressureSnapshot(const ProcSample& host, const ProcSample& previous);
+    static QJsonObject memorySnapshot(const ProcSample& host);
     static QJsonObject diskSnapshot();
-    static QJsonArray gpuSnapshot();
-    static QJsonArray usbDevices();
-    static QJsonArray serialPorts();
-    static QJsonArray canInterfaces();
     static QJsonArray networkInterfaces();
 
-    qulonglong previousCpuTotal_ = 0;
-    qulonglong previousCpuIdle_ = 0;
-    bool firstCpuSample_ = true;
+    ProcSample previousHost_;
+    HardwareProbes hardwareProbes_;
 };
 
 }  // namespace rrcc
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QElapsedTimer>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QMutex>
@@ -18,12 +19,16 @@ public:
     void recordEvent(const QString& type, const QJsonObject& payload = {});
     void recordRequest();
     void setQueueSize(const QString& key, int size);
+    // Restarts the startup clock; call first thing in main().
+    void markStartup();
+    // Sets gauge `key` to the ms elapsed since markStartup().
+    void recordSinceStartup(const QString& key);
 
     [[nodiscard]] QJsonObject snapshot() const;
     QJsonObject exportToFile(const QString& filePath) const;
 
 private:
-    Telemetry() = default;
+    Telemetry();
 
     struct DurationStats {
         qint64 count = 0;
@@ -40,6 +45,7 @@ private:
     QJsonObject durations_;
     QJsonArray events_;
     QQueue<qint64> requestTimesMs_;
+    QElapsedTimer startup_;
 
     int maxEvents_ = 1500;
     int maxRequestSamples_ = 2400;
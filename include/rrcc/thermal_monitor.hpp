@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+namespace rrcc {
+
+// Thermal zones, cpufreq policies and the x86 thermal_throttle counters
+// from sysfs. The files are found once and kept open; a sample is one
+// pread() per file. A sample is throttled when a CPU cooling device is
+// active, a zone is at its passive trip point, or a throttle counter moved.
+// Without a CPU cooling device, a scaling_max_freq that dropped below the
+// highest value seen counts instead. A static cap (nvpmodel modes, power
+// profiles, user limits) is only reported as capped. Recent samples are
+// kept in a fixed ring.
+// Not thread-safe; owned by one collector.
+class ThermalMonitor final {
+public:
+    static constexpr int kHistoryCapacity = 600;
+    // Points of history published per sample.
+    static constexpr int kPublishedHistory = 60;
+
+    ThermalMonitor() = default;
+    ~ThermalMonitor();
+
+    ThermalMonitor(const ThermalMonitor&) = delete;
+    ThermalMonitor& operator=(const ThermalMonitor&) = delete;
+
+    // {zones: [{name, temp_c, passive_c, critical_c}], cpufreq: [{policy,
+    //  cur_mhz, max_mhz, hw_max_mhz, ratio, capped, limited}],
+    //  cooling_devices: [{name, type, cur_state, max_state}], max_temp_c,
+    //  min_freq_ratio, core_throttle_count, package_throttle_count,
+    //  throttled, throttle_events, history: {epoch_ms, max_temp_c,
+    //  freq_ratio, throttled}}
+    QJsonObject sample();
+
+private:
+    struct Zone {
+        QString name;
+        int tempFd = -1;
+        // Millidegrees; -1 when the zone has no such trip point.
+        qint64 passiveMilliC = -1;
+        qint64 criticalMilliC = -1;
+    };
+    struct Policy {
+        QString name;
+        int curFd = -1;
+        int maxFd = -1;
+        qint64 hardwareMaxKhz = 0;
+        // Highest scaling_max_freq seen, from discovery on; a drop below it
+        // is a limit applied while running.
+        qint64 highestMaxKhz = -1;
+    };
+    struct CoolingDevice {
+        QString name;
+        QString type;
+        int curStateFd = -1;
+        qint64 maxState = 0;
+    };
+    struct HistoryPoint {
+        qint64 epochMs = 0;
+        double maxTempC = 0.0;
+        double freqRatio = 1.0;
+        bool throttled = false;
+    };
+
+    void discover();
+    void closeAll();
+
+    bool discovered_ = false;
+    QVector<Zone> zones_;
+    QVector<Policy> policies_;
+    // cpufreq and ACPI processor cooling devices only.
+    QVector<CoolingDevice> coolingDevices_;
+    QVector<int> coreThrottleFds_;
+    QVector<int> packageThrottleFds_;
+    qint64 previousThrottleCount_ = -1;
+    bool wasThrottled_ = false;
+    qint64 throttleEvents_ = 0;
+
+    HistoryPoint history_[kHistoryCapacity];
+    int historyHead_ = 0;
+    int historySize_ = 0;
+};
+
+}  // namespace rrcc
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+
+namespace rrcc {
+
+// Collector state kept across runs (state/warm_start.cbor), so the first
+// frames after launch show the last known ROS picture instead of nothing.
+// Everything loaded is stale until a collector has revalidated it.
+//
+// Layout: {version, boot_id, saved_epoch_ms, sections, section_epoch_ms,
+// parameter_hashes, classifications, collector_costs}. Classifications are
+// keyed by pid and start time, so they are dropped after a reboot.
+class WarmStartCache final {
+public:
+    explicit WarmStartCache(QString path = {});
+
+    // Empty when the file is missing, unreadable, from another format
+    // version or older than maxAgeMs.
+    [[nodiscard]] QJsonObject load(qint64 maxAgeMs = 24LL * 60 * 60 * 1000) const;
+    QJsonObject save(const QJsonObject& state) const;
+    [[nodiscard]] QString path() const { return path_; }
+
+    // Tags a cached section with cached_epoch_ms (on the object, or on each
+    // object of an array). The tag also makes the first fresh publish differ
+    // from the cached value, even when the content is the same.
+    static QJsonValue markCached(const QJsonValue& value, qint64 cachedEpochMs);
+    static QString bootId();
+
+private:
+    static constexpr int kFormatVersion = 1;
+    QString path_;
+};
+
+}  // namespace rrcc
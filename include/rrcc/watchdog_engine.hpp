@@ -0,0 +1,110 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+
+#include <vector>
+
+namespace rrcc {
+
+// Watchdog rules compiled once from JSON and evaluated incrementally: each
+// rule only runs when a section it depends on is published, and rules with a
+// hold time fire from tick() rather than waiting for the next sample.
+//
+// Rule kinds:
+//   metric            {section, path, op, value | equals}
+//   node_missing      {node, domain_id?}
+//   topic_rate_below  {topic, ratio = 0.5, expected_hz?}
+//   rss_slope         {process, slope_kb_per_s, window_ms = 60000}
+// Common fields: id, action (restart_domain | kill_all_ros | warn),
+// samples = 1, for_ms = 0, cooldown_ms = 12000.
+// Thread-safe.
+class WatchdogEngine final {
+public:
+    struct Firing {
+        QString ruleId;
+        QString action;
+        QString domainId;
+        QString message;
+        qint64 latencyMs = 0;
+    };
+
+    WatchdogEngine();
+
+    // The built-in rules that mirror the original fixed watchdog.
+    static QJsonArray defaultRules();
+
+    // Replaces every rule; on a compile error the current set is kept.
+    QJsonObject loadRules(const QJsonArray& rules);
+    [[nodiscard]] QJsonArray rules() const;
+    [[nodiscard]] bool dependsOn(const QString& section) const;
+    [[nodiscard]] QStringList sections() const;
+    // Forgets partial conditions, e.g. samples taken while disabled.
+    void resetState();
+
+    QList<Firing> ingest(const QString& section, const QJsonValue& value, qint64 sampleEpochMs);
+    QList<Firing> tick(qint64 nowEpochMs);
+    // Earliest time a held rule may fire, or -1.
+    [[nodiscard]] qint64 nextDeadlineEpochMs() const;
+    // Per-rule state; evaluation cost and firing latency go to telemetry.
+    [[nodiscard]] QJsonArray status() const;
+
+private:
+    enum class Kind { Metric, NodeMissing, TopicRateBelow, RssSlope };
+
+    struct Rule {
+        QJsonObject source;
+        QString id;
+        Kind kind = Kind::Metric;
+        QString section;
+        QString action;
+        QString domainId;
+        int samples = 1;
+        qint64 forMs = 0;
+        qint64 cooldownMs = 12000;
+        // metric
+        QStringList path;
+        QString op;
+        double threshold = 0.0;
+        QString equals;
+        // node_missing / topic_rate_below / rss_slope
+        QString target;
+        double ratio = 0.5;
+        double expectedHz = -1.0;
+        qint64 windowMs = 60000;
+        QList<QPair<qint64, double>> series;
+
+        bool active = false;
+        int consecutive = 0;
+        qint64 activeSinceMs = 0;
+        qint64 sampleEpochMs = 0;
+        qint64 lastFiredMs = 0;
+        QString detail;
+        qint64 evaluations = 0;
+        qint64 evalNsTotal = 0;
+        qint64 evalNsMax = 0;
+        qint64 firedCount = 0;
+    };
+
+    static bool compileRule(const QJsonObject& json, Rule* rule, QString* error);
+    // 1 = condition holds, 0 = it does not, -1 = no sample for this rule.
+    int evaluate(Rule& rule, const QJsonValue& value, qint64 sampleEpochMs) const;
+    [[nodiscard]] qint64 dueEpochMs(const Rule& rule) const;
+    void fireDueLocked(qint64 nowEpochMs, QList<Firing>* firings);
+
+    mutable QMutex mutex_;
+    std::vector<Rule> rules_;
+    QHash<QString, QList<int>> rulesBySection_;
+    // Destructive actions share one cooldown so two rules cannot stack kills.
+    qint64 lastDestructiveMs_ = 0;
+    QString lastDomainId_ = "0";
+};
+
+}  // namespace rrcc
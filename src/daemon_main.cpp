@@ -0,0 +1,219 @@
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QJsonObject>
+#include <QSocketNotifier>
+#include <QTextStream>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "rrcc/daemon_protocol.hpp"
+#include "rrcc/daemon_server.hpp"
+#include "rrcc/field_recorder.hpp"
+#include "rrcc/one_shot_collector.hpp"
+#include "rrcc/snapshot_codec.hpp"
+#include "rrcc/telemetry.hpp"
+
+#ifdef __linux__
+#include <csignal>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef __linux__
+int signalFds[2] = {-1, -1};
+
+// Only async-signal-safe work here; the event loop does the actual quit.
+void forwardSignal(int) {
+    const char byte = 1;
+    [[maybe_unused]] const ssize_t written = ::write(signalFds[0], &byte, 1);
+}
+#endif
+
+// Exit codes: 0 complete, 1 usage or I/O error, 2 budget ran out,
+// 3 collected fine but health is critical.
+int runOnce(const QCommandLineParser& parser) {
+    QTextStream err(stderr);
+    rrcc::OneShotCollector::Options options;
+    options.budgetMs = parser.value("budget-ms").toInt();
+    options.domainId = parser.value("domain");
+    const QString sections = parser.value("sections");
+    if (sections == "all") {
+        options.sections = rrcc::OneShotCollector::allSections();
+    } else if (sections.isEmpty()) {
+        options.sections = rrcc::OneShotCollector::defaultSections();
+    } else {
+        options.sections = sections.split(',', Qt::SkipEmptyParts);
+        for (QString& section : options.sections) {
+            section = section.trimmed();
+            if (!rrcc::OneShotCollector::allSections().contains(section)) {
+                err << "rosscoped: unknown section " << section << Qt::endl;
+                return 1;
+            }
+        }
+    }
+
+    const QString output = parser.value("output");
+    rrcc::SnapshotCodec::Format format = rrcc::SnapshotCodec::formatForPath(output);
+    if (parser.isSet("format")) {
+        format = parser.value("format") == "cbor" ? rrcc::SnapshotCodec::Format::Cbor
+                                                  : rrcc::SnapshotCodec::Format::Json;
+    }
+
+    // Leaked on purpose when probes overrun: they may still be running.
+    auto* collector = new rrcc::OneShotCollector(options);
+    const QJsonObject snapshot = collector->collect();
+    const QByteArray bytes = rrcc::SnapshotCodec::encode(snapshot, format);
+    bool written = false;
+    if (output.isEmpty() || output == "-") {
+        written = std::fwrite(bytes.constData(), 1, static_cast<size_t>(bytes.size()), stdout)
+            == static_cast<size_t>(bytes.size());
+        std::fflush(stdout);
+    } else {
+        QFile file(output);
+        written = file.open(QIODevice::WriteOnly | QIODevice::Truncate) && file.write(bytes) == bytes.size();
+    }
+
+    int code = 0;
+    if (!written) {
+        err << "rosscoped: failed to write " << (output.isEmpty() ? QString("stdout") : output) << Qt::endl;
+        code = 1;
+    } else if (!collector->complete()) {
+        err << "rosscoped: budget exhausted, missing "
+            << snapshot.value("missing_sections").toVariant().toStringList().join(", ") << Qt::endl;
+        code = 2;
+    } else if (snapshot.value("health").toObject().value("status").toString() == "critical") {
+        code = 3;
+    }
+    if (!collector->complete()) {
+        // Abandoned probes hold threads; skip teardown rather than join them.
+        err.flush();
+        std::_Exit(code);
+    }
+    delete collector;
+    return code;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    rrcc::Telemetry::instance().markStartup();
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("rosscoped");
+    app.setOrganizationName("Prabal Khare");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Headless RosScope collector daemon.");
+    parser.addHelpOption();
+    const QCommandLineOption socketOption(
+        "socket", "Local socket name to listen on.", "name", rrcc::DaemonProtocol::kDefaultSocketName);
+    const QCommandLineOption tcpOption(
+        "tcp-port", "Also listen on 127.0.0.1:<port> (0 disables).", "port", "0");
+    const QCommandLineOption keepAliveOption(
+        "keepalive-ms", "Collection cadence while no client is attached.", "ms", "1000");
+    parser.addOption(socketOption);
+    parser.addOption(tcpOption);
+    parser.addOption(keepAliveOption);
+    const QCommandLineOption onceOption("once", "Collect one snapshot, write it and exit.");
+    const QCommandLineOption formatOption(
+        "format", "Output encoding for --once (default json) or --record (default cbor).", "format");
+    const QCommandLineOption outputOption("output", "--once output file; stdout when omitted.", "path");
+    const QCommandLineOption sectionsOption(
+        "sections", "Sections for --once or --record, comma separated; \"all\" for --once.", "list");
+    const QCommandLineOption budgetOption("budget-ms", "--once time budget.", "ms", "5000");
+    const QCommandLineOption domainOption(
+        "domain", "--once ROS domain; default is the first active one.", "id");
+    parser.addOption(onceOption);
+    parser.addOption(formatOption);
+    parser.addOption(outputOption);
+    parser.addOption(sectionsOption);
+    parser.addOption(budgetOption);
+    parser.addOption(domainOption);
+    const QCommandLineOption recordOption(
+        "record", "Record-only mode: append deltas to a session stream in <dir>.", "dir");
+    const QCommandLineOption intervalOption("interval-ms", "--record collection interval.", "ms", "5000");
+    const QCommandLineOption cpuCapOption(
+        "cpu-cap", "--record CPU cap, percent of one core.", "percent", "5");
+    const QCommandLineOption rotateMbOption("rotate-mb", "--record rotates files at this size.", "mb", "64");
+    const QCommandLineOption rotateMinutesOption(
+        "rotate-minutes", "--record rotates files after this long.", "minutes", "60");
+    parser.addOption(recordOption);
+    parser.addOption(intervalOption);
+    parser.addOption(cpuCapOption);
+    parser.addOption(rotateMbOption);
+    parser.addOption(rotateMinutesOption);
+    parser.process(app);
+
+    if (parser.isSet(onceOption)) {
+        return runOnce(parser);
+    }
+
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, []() {
+        const QString path = QDir(QDir::currentPath()).filePath("logs/telemetry_last_exit.json");
+        rrcc::Telemetry::instance().exportToFile(path);
+    });
+
+#ifdef __linux__
+    // SIGINT/SIGTERM quit cleanly so the exit telemetry still gets written.
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, signalFds) == 0) {
+        auto* notifier = new QSocketNotifier(signalFds[1], QSocketNotifier::Read, &app);
+        QObject::connect(notifier, &QSocketNotifier::activated, &app, []() {
+            char byte = 0;
+            [[maybe_unused]] const ssize_t bytesRead = ::read(signalFds[1], &byte, 1);
+            QCoreApplication::quit();
+        });
+        std::signal(SIGINT, forwardSignal);
+        std::signal(SIGTERM, forwardSignal);
+    }
+#endif
+
+    QTextStream err(stderr);
+    if (parser.isSet(recordOption)) {
+        rrcc::FieldRecorder::Options options;
+        options.directory = parser.value(recordOption);
+        options.intervalMs = parser.value(intervalOption).toInt();
+        options.cpuCapPercent = parser.value(cpuCapOption).toDouble();
+        options.rotateBytes = qMax(1LL, parser.value(rotateMbOption).toLongLong()) * 1024 * 1024;
+        options.rotateMinutes = qMax(1, parser.value(rotateMinutesOption).toInt());
+        for (const QString& section : parser.value(sectionsOption).split(',', Qt::SkipEmptyParts)) {
+            // Same section names as --once.
+            options.sections.append(section.trimmed() == "processes" ? QString("processes_visible") : section.trimmed());
+        }
+        if (parser.value(formatOption) == "json") {
+            options.format = rrcc::SnapshotCodec::Format::Json;
+        }
+        rrcc::FieldRecorder recorder(options);
+        const QJsonObject started = recorder.start();
+        if (!started.value("success").toBool(false)) {
+            err << "rosscoped: " << started.value("error").toString() << Qt::endl;
+            return 1;
+        }
+        err << "rosscoped: recording to " << started.value("path").toString() << Qt::endl;
+        return QCoreApplication::exec();
+    }
+
+    rrcc::DaemonServer::Options options;
+    options.socketName = parser.value(socketOption);
+    options.tcpPort = parser.value(tcpOption).toUShort();
+    options.keepAliveMs = parser.value(keepAliveOption).toInt();
+    rrcc::DaemonServer server(options);
+    const QJsonObject started = server.start();
+    if (!started.value("success").toBool(false)) {
+        err << "rosscoped: " << started.value("error").toString() << Qt::endl;
+        return 1;
+    }
+    err << "rosscoped: listening on " << started.value("socket").toString();
+    if (started.contains("tcp_port")) {
+        err << " and 127.0.0.1:" << started.value("tcp_port").toInt();
+    }
+    err << Qt::endl;
+    if (started.contains("tcp_warning")) {
+        err << "rosscoped: " << started.value("tcp_warning").toString() << Qt::endl;
+    }
+
+    return QCoreApplication::exec();
+}
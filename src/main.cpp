@@ -1,19 +1,31 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDir>
 
 #include "rrcc/main_window.hpp"
 #include "rrcc/telemetry.hpp"
 
 int main(int argc, char* argv[]) {
+    rrcc::Telemetry::instance().markStartup();
     QApplication app(argc, argv);
     app.setApplicationName("RosScope");
     app.setOrganizationName("Prabal Khare");
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    const QCommandLineOption attachOption(
+        "attach",
+        "Attach to a running rosscoped (local socket name or host:port).",
+        "endpoint");
+    parser.addOption(attachOption);
+    parser.process(app);
+
     QObject::connect(&app, &QCoreApplication::aboutToQuit, []() {
         const QString path = QDir(QDir::currentPath()).filePath("logs/telemetry_last_exit.json");
         rrcc::Telemetry::instance().exportToFile(path);
     });
 
-    rrcc::MainWindow window;
+    rrcc::MainWindow window(parser.value(attachOption));
     window.show();
 
     return QApplication::exec();
@@ -0,0 +1,209 @@
+#include "rrcc/action_executor.hpp"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonValue>
+#include <QMap>
+#include <QStringList>
+#include <QThread>
+
+#include <utility>
+
+#include "rrcc/command_runner.hpp"
+#include "rrcc/section_store.hpp"
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+ActionExecutor::ActionExecutor(const SectionStore* sections)
+    : sections_(sections),
+      actions_(&processManager_) {}
+
+ActionExecutor::~ActionExecutor() {
+    stop();
+}
+
+bool ActionExecutor::handles(const QString& action) {
+    static const QStringList kActions = {
+        "terminate_pid",
+        "kill_pid",
+        "kill_tree",
+        "kill_all_ros",
+        "restart_domain",
+        "isolate_domain",
+        "clear_shared_memory",
+        "restart_workspace",
+    };
+    return kActions.contains(action);
+}
+
+QJsonArray ActionExecutor::rosPids(const QJsonArray& processes, const QString& domainId) {
+    QJsonArray pids;
+    for (const QJsonValue& value : processes) {
+        const QJsonObject proc = value.toObject();
+        if (!proc.value("is_ros").toBool()) {
+            continue;
+        }
+        if (!domainId.isEmpty() && proc.value("ros_domain_id").toString("0") != domainId) {
+            continue;
+        }
+        pids.append(proc.value("pid"));
+    }
+    return pids;
+}
+
+void ActionExecutor::setInvalidationHandler(std::function<void(const QJsonArray&)> handler) {
+    invalidationHandler_ = std::move(handler);
+}
+
+void ActionExecutor::start() {
+    if (thread_ != nullptr) {
+        return;
+    }
+    thread_ = new QThread();
+    thread_->setObjectName("rrcc-actions");
+    moveToThread(thread_);
+    thread_->start(QThread::HighPriority);
+}
+
+void ActionExecutor::stop() {
+    if (thread_ == nullptr) {
+        return;
+    }
+    thread_->quit();
+    thread_->wait();
+    delete thread_;
+    thread_ = nullptr;
+}
+
+void ActionExecutor::recordSignalLatency(const QJsonObject& payload) const {
+    const qint64 requestedAtMs = payload.value("requested_epoch_ms").toInteger(0);
+    if (requestedAtMs <= 0) {
+        return;
+    }
+    const qint64 latencyMs = qMax<qint64>(0, QDateTime::currentMSecsSinceEpoch() - requestedAtMs);
+    Telemetry::instance().recordDurationMs("actions.click_to_signal_ms", latencyMs);
+    if (latencyMs > 50) {
+        Telemetry::instance().incrementCounter("actions.click_to_signal_over_budget");
+    }
+}
+
+void ActionExecutor::execute(const QString& action, const QJsonObject& payload) {
+    QElapsedTimer actionTimer;
+    actionTimer.start();
+    Telemetry::instance().incrementCounter("actions.count");
+    const qint64 requestedAtMs = payload.value("requested_epoch_ms").toInteger(0);
+    if (requestedAtMs > 0) {
+        Telemetry::instance().recordDurationMs(
+            "actions.click_to_dispatch_ms",
+            qMax<qint64>(0, QDateTime::currentMSecsSinceEpoch() - requestedAtMs));
+    }
+
+    QJsonObject result;
+    result.insert("action", action);
+    result.insert("success", false);
+    const QJsonArray allProcesses = sections_->value("processes_all").toArray();
+    QJsonArray touchedPids;
+
+    if (action == "terminate_pid") {
+        const qint64 pid = static_cast<qint64>(payload.value("pid").toDouble(-1));
+        const bool ok = processManager_.terminateProcess(pid);
+        recordSignalLatency(payload);
+        touchedPids.append(pid);
+        result.insert("success", ok);
+        result.insert("message", ok ? QString("SIGTERM sent to %1").arg(pid)
+                                    : QString("Failed to SIGTERM %1").arg(pid));
+    } else if (action == "kill_pid") {
+        const qint64 pid = static_cast<qint64>(payload.value("pid").toDouble(-1));
+        const bool ok = processManager_.forceKillProcess(pid);
+        recordSignalLatency(payload);
+        touchedPids.append(pid);
+        result.insert("success", ok);
+        result.insert("message", ok ? QString("SIGKILL sent to %1").arg(pid)
+                                    : QString("Failed to SIGKILL %1").arg(pid));
+    } else if (action == "kill_tree") {
+        const qint64 pid = static_cast<qint64>(payload.value("pid").toDouble(-1));
+        const bool ok = processManager_.killProcessTree(pid, true);
+        recordSignalLatency(payload);
+        touchedPids.append(pid);
+        result.insert("success", ok);
+        result.insert("message", ok ? QString("Killed process tree for %1").arg(pid)
+                                    : QString("Failed killing process tree for %1").arg(pid));
+    } else if (action == "kill_all_ros") {
+        result = actions_.killAllRosProcesses(allProcesses);
+        recordSignalLatency(payload);
+        touchedPids = rosPids(allProcesses);
+        result.insert(
+            "message",
+            QString("Killed %1 ROS processes, %2 failed.")
+                .arg(result.value("killed_count").toInt())
+                .arg(result.value("failed_count").toInt()));
+    } else if (action == "restart_domain") {
+        const QString domainId = payload.value("domain_id").toString("0");
+        result = actions_.restartDomain(domainId, allProcesses);
+        recordSignalLatency(payload);
+        touchedPids = rosPids(allProcesses, domainId);
+        result.insert(
+            "message",
+            QString("Domain %1 restart: %2 terminated.")
+                .arg(domainId)
+                .arg(result.value("terminated_processes").toInt()));
+    } else if (action == "clear_shared_memory") {
+        result = actions_.clearSharedMemory();
+        result.insert("message", "Shared memory cleanup executed.");
+    } else if (action == "restart_workspace") {
+        result = actions_.restartWorkspace(
+            payload.value("workspace_path").toString(),
+            payload.value("relaunch_command").toString(),
+            allProcesses);
+        recordSignalLatency(payload);
+        touchedPids = rosPids(allProcesses);
+        result.insert(
+            "message",
+            QString("Workspace restart: %1 terminated.")
+                .arg(result.value("terminated_processes").toInt()));
+    } else if (action == "isolate_domain") {
+        const QString domainId = payload.value("domain_id").toString("0");
+        int killed = 0;
+        int failed = 0;
+        touchedPids = rosPids(allProcesses, domainId);
+        for (const QJsonValue& value : touchedPids) {
+            const qint64 pid = static_cast<qint64>(value.toDouble(-1));
+            if (pid <= 0) {
+                continue;
+            }
+            if (processManager_.killProcessTree(pid, true)) {
+                killed++;
+            } else {
+                failed++;
+            }
+        }
+        recordSignalLatency(payload);
+        const QMap<QString, QString> env = {{"ROS_DOMAIN_ID", domainId}};
+        const CommandResult daemonStop = CommandRunner::run("ros2", {"daemon", "stop"}, 3000, env);
+        result.insert("success", failed == 0);
+        result.insert("killed_count", killed);
+        result.insert("failed_count", failed);
+        result.insert("daemon_stop_ok", daemonStop.success());
+        result.insert("message", QString("Domain %1 isolated: %2 killed, %3 failed.")
+                                     .arg(domainId)
+                                     .arg(killed)
+                                     .arg(failed));
+    } else {
+        result.insert("message", "Unsupported action");
+    }
+
+    if (!touchedPids.isEmpty() && invalidationHandler_) {
+        invalidationHandler_(touchedPids);
+    }
+    if (requestedAtMs > 0) {
+        result.insert("requested_epoch_ms", static_cast<double>(requestedAtMs));
+    }
+    emit actionFinished(result);
+    Telemetry::instance().recordDurationMs("actions.duration_ms", actionTimer.elapsed());
+    if (!result.value("success").toBool(false)) {
+        Telemetry::instance().incrementCounter("actions.failures");
+    }
+}
+
+}  // namespace rrcc
@@ -0,0 +1,280 @@
+#include "rrcc/can_monitor.hpp"
+
+#include <QJsonObject>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/can/netlink.h>
+#include <linux/if_arp.h>
+#include <linux/if_link.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+// Replies slower than this mean netlink is wedged; the sample is dropped.
+constexpr int kReplyTimeoutMs = 200;
+
+#ifdef __linux__
+template <typename T>
+T readAttr(const struct rtattr* attr) {
+    T value {};
+    std::memcpy(&value, RTA_DATA(attr), std::min(sizeof(T), static_cast<size_t>(RTA_PAYLOAD(attr))));
+    return value;
+}
+
+int attrType(const struct rtattr* attr) {
+    return attr->rta_type & NLA_TYPE_MASK;
+}
+
+// IFLA_INFO_DATA of a "can" link.
+void parseCanData(const struct rtattr* data, QJsonObject* out) {
+    int length = static_cast<int>(RTA_PAYLOAD(data));
+    for (const struct rtattr* attr = static_cast<const struct rtattr*>(RTA_DATA(data)); RTA_OK(attr, length);
+         attr = RTA_NEXT(attr, length)) {
+        switch (attrType(attr)) {
+        case IFLA_CAN_BITTIMING:
+            out->insert("bitrate", static_cast<qint64>(readAttr<struct can_bittiming>(attr).bitrate));
+            break;
+        case IFLA_CAN_DATA_BITTIMING:
+            out->insert("data_bitrate", static_cast<qint64>(readAttr<struct can_bittiming>(attr).bitrate));
+            break;
+        case IFLA_CAN_STATE:
+            out->insert("state", CanMonitor::stateName(static_cast<int>(readAttr<quint32>(attr))));
+            break;
+        case IFLA_CAN_BERR_COUNTER: {
+            const struct can_berr_counter berr = readAttr<struct can_berr_counter>(attr);
+            out->insert("berr", QJsonObject{{"tx", berr.txerr}, {"rx", berr.rxerr}});
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+// IFLA_LINKINFO: kind, driver data and the CAN device statistics.
+void parseLinkInfo(const struct rtattr* linkInfo, QJsonObject* out) {
+    int length = static_cast<int>(RTA_PAYLOAD(linkInfo));
+    QString kind;
+    const struct rtattr* data = nullptr;
+    const struct rtattr* xstats = nullptr;
+    for (const struct rtattr* attr = static_cast<const struct rtattr*>(RTA_DATA(linkInfo)); RTA_OK(attr, length);
+         attr = RTA_NEXT(attr, length)) {
+        switch (attrType(attr)) {
+        case IFLA_INFO_KIND:
+            kind = QString::fromLatin1(static_cast<const char*>(RTA_DATA(attr)));
+            break;
+        case IFLA_INFO_DATA:
+            data = attr;
+            break;
+        case IFLA_INFO_XSTATS:
+            xstats = attr;
+            break;
+        default:
+            break;
+        }
+    }
+    out->insert("kind", kind);
+    // vcan and slcan carry no controller data.
+    if (kind != "can") {
+        return;
+    }
+    if (data != nullptr) {
+        parseCanData(data, out);
+    }
+    if (xstats != nullptr) {
+        const struct can_device_stats stats = readAttr<struct can_device_stats>(xstats);
+        out->insert("bus_errors", static_cast<qint64>(stats.bus_error));
+        out->insert("error_warning", static_cast<qint64>(stats.error_warning));
+        out->insert("error_passive", static_cast<qint64>(stats.error_passive));
+        out->insert("bus_off", static_cast<qint64>(stats.bus_off));
+        out->insert("arbitration_lost", static_cast<qint64>(stats.arbitration_lost));
+        out->insert("restarts", static_cast<qint64>(stats.restarts));
+    }
+}
+#endif
+
+}  // namespace
+
+CanMonitor::CanMonitor() {
+    clock_.start();
+}
+
+CanMonitor::~CanMonitor() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+}
+
+QString CanMonitor::stateName(int state) {
+    static const char* const kNames[] = {
+        "error-active", "error-warning", "error-passive", "bus-off", "stopped", "sleeping"};
+    return (state >= 0 && state < 6) ? QString(kNames[state]) : QString("unknown");
+}
+
+bool CanMonitor::openSocket() {
+#ifdef __linux__
+    fd_ = ::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd_ < 0) {
+        error_ = QString("netlink: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+        return false;
+    }
+    struct timeval timeout {};
+    timeout.tv_usec = kReplyTimeoutMs * 1000;
+    ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return true;
+#else
+    error_ = "SocketCAN is Linux-only.";
+    return false;
+#endif
+}
+
+bool CanMonitor::sample(QJsonArray* interfaces) {
+#ifdef __linux__
+    if (fd_ < 0 && !openSocket()) {
+        return false;
+    }
+
+    struct {
+        struct nlmsghdr header;
+        struct ifinfomsg info;
+    } request {};
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    request.header.nlmsg_type = RTM_GETLINK;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    request.header.nlmsg_seq = ++seq_;
+    request.info.ifi_family = AF_UNSPEC;
+    if (::send(fd_, &request, request.header.nlmsg_len, 0) < 0) {
+        error_ = QString("RTM_GETLINK: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    const qint64 nowMs = clock_.elapsed();
+    QHash<int, Counters> current;
+    bool done = false;
+    while (!done) {
+        const ssize_t bytes = ::recv(fd_, buffer_, sizeof(buffer_), 0);
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // Timed out or failed mid-dump: the rest of the reply would be
+            // read as the next sample's, so start over on a fresh socket.
+            error_ = QString("RTM_GETLINK reply: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+            ::close(fd_);
+            fd_ = -1;
+            Telemetry::instance().incrementCounter("can.netlink_errors");
+            return false;
+        }
+        int length = static_cast<int>(bytes);
+        for (const struct nlmsghdr* message = reinterpret_cast<const struct nlmsghdr*>(buffer_);
+             NLMSG_OK(message, static_cast<unsigned int>(length));
+             message = NLMSG_NEXT(message, length)) {
+            if (message->nlmsg_seq != seq_) {
+                continue;
+            }
+            if (message->nlmsg_type == NLMSG_DONE) {
+                done = true;
+                break;
+            }
+            if (message->nlmsg_type == NLMSG_ERROR) {
+                error_ = "RTM_GETLINK: netlink error reply";
+                return false;
+            }
+            if (message->nlmsg_type != RTM_NEWLINK) {
+                continue;
+            }
+            const auto* info = static_cast<const struct ifinfomsg*>(NLMSG_DATA(message));
+            // Skips every non-CAN link before touching its attributes.
+            if (info->ifi_type != ARPHRD_CAN) {
+                continue;
+            }
+
+            QJsonObject out;
+            out.insert("up", (info->ifi_flags & IFF_UP) != 0);
+            Counters counters;
+            counters.atMs = nowMs;
+            int attrLength = static_cast<int>(IFLA_PAYLOAD(message));
+            for (const struct rtattr* attr = IFLA_RTA(info); RTA_OK(attr, attrLength);
+                 attr = RTA_NEXT(attr, attrLength)) {
+                switch (attrType(attr)) {
+                case IFLA_IFNAME:
+                    out.insert("name", QString::fromLatin1(static_cast<const char*>(RTA_DATA(attr))));
+                    break;
+                case IFLA_STATS64: {
+                    const struct rtnl_link_stats64 stats = readAttr<struct rtnl_link_stats64>(attr);
+                    counters.rxFrames = stats.rx_packets;
+                    counters.txFrames = stats.tx_packets;
+                    counters.rxBytes = stats.rx_bytes;
+                    counters.txBytes = stats.tx_bytes;
+                    out.insert("rx_errors", static_cast<qint64>(stats.rx_errors));
+                    out.insert("tx_errors", static_cast<qint64>(stats.tx_errors));
+                    out.insert("rx_dropped", static_cast<qint64>(stats.rx_dropped));
+                    break;
+                }
+                case IFLA_LINKINFO:
+                    parseLinkInfo(attr, &out);
+                    break;
+                default:
+                    break;
+                }
+            }
+            out.insert("rx_frames", static_cast<qint64>(counters.rxFrames));
+            out.insert("tx_frames", static_cast<qint64>(counters.txFrames));
+            out.insert("rx_bytes", static_cast<qint64>(counters.rxBytes));
+            out.insert("tx_bytes", static_cast<qint64>(counters.txBytes));
+
+            // Rates need a previous sample of the same link; a counter that
+            // went backwards means the interface was recreated.
+            const auto previous = previous_.constFind(info->ifi_index);
+            if (previous != previous_.constEnd() && nowMs > previous->atMs
+                && counters.rxFrames >= previous->rxFrames && counters.txFrames >= previous->txFrames
+                && counters.rxBytes >= previous->rxBytes && counters.txBytes >= previous->txBytes) {
+                const double seconds = static_cast<double>(nowMs - previous->atMs) / 1000.0;
+                const quint64 frames =
+                    (counters.rxFrames - previous->rxFrames) + (counters.txFrames - previous->txFrames);
+                const quint64 payload = (counters.rxBytes - previous->rxBytes) + (counters.txBytes - previous->txBytes);
+                out.insert("rx_fps", static_cast<double>(counters.rxFrames - previous->rxFrames) / seconds);
+                out.insert("tx_fps", static_cast<double>(counters.txFrames - previous->txFrames) / seconds);
+                const double bitrate = out.value("bitrate").toDouble(0);
+                if (bitrate > 0) {
+                    // The data phase of CAN FD frames runs faster; charging it
+                    // at the nominal bitrate overstates FD load.
+                    const double bits = (static_cast<double>(frames) * kFrameOverheadBits
+                                         + static_cast<double>(payload) * 8.0)
+                        * kStuffingFactor;
+                    out.insert("bus_load_percent", std::min(100.0, 100.0 * bits / seconds / bitrate));
+                }
+            }
+            current.insert(info->ifi_index, counters);
+            interfaces->append(out);
+        }
+    }
+    previous_ = std::move(current);
+    error_.clear();
+    return true;
+#else
+    Q_UNUSED(interfaces);
+    error_ = "SocketCAN is Linux-only.";
+    return false;
+#endif
+}
+
+}  // namespace rrcc
@@ -0,0 +1,84 @@
+#include "rrcc/collector_lane.hpp"
+
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QThread>
+#include <QTimer>
+
+#include <utility>
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+CollectorLane::CollectorLane(const QString& name, int intervalMs, std::function<void()> collect)
+    : name_(name),
+      intervalMs_(qMax(50, intervalMs)),
+      collect_(std::move(collect)) {}
+
+CollectorLane::~CollectorLane() {
+    stop();
+}
+
+void CollectorLane::start() {
+    if (thread_ != nullptr) {
+        return;
+    }
+    thread_ = new QThread();
+    thread_->setObjectName("rrcc-" + name_);
+    timer_ = new QTimer(this);
+    timer_->setSingleShot(true);
+    connect(timer_, &QTimer::timeout, this, &CollectorLane::runOnce);
+    // Timer is a child, so it follows the lane onto the collector thread.
+    moveToThread(thread_);
+    connect(thread_, &QThread::started, this, &CollectorLane::runOnce);
+    connect(thread_, &QThread::finished, timer_, &QTimer::stop, Qt::DirectConnection);
+    thread_->start();
+}
+
+void CollectorLane::stop() {
+    if (thread_ == nullptr) {
+        return;
+    }
+    thread_->quit();
+    // Collectors stop between probes once the worker is stopping, and every
+    // probe is bounded by a CommandRunner timeout, so this returns.
+    thread_->wait();
+    delete thread_;
+    thread_ = nullptr;
+}
+
+void CollectorLane::requestStop() {
+    if (thread_ != nullptr) {
+        thread_->quit();
+    }
+}
+
+void CollectorLane::requestRun(int delayMs) {
+    QMetaObject::invokeMethod(
+        this,
+        [this, delayMs]() {
+            if (timer_ == nullptr) {
+                return;
+            }
+            if (!timer_->isActive() || timer_->remainingTime() > delayMs) {
+                timer_->start(qMax(0, delayMs));
+            }
+        },
+        Qt::QueuedConnection);
+}
+
+void CollectorLane::runOnce() {
+    QElapsedTimer elapsed;
+    elapsed.start();
+    collect_();
+    const qint64 durationMs = elapsed.elapsed();
+    Telemetry::instance().incrementCounter("lane." + name_ + ".runs");
+    Telemetry::instance().recordDurationMs("lane." + name_ + ".duration_ms", durationMs);
+
+    // Keep the cadence, but never run back-to-back after an overrun.
+    const qint64 delay = qMax<qint64>(intervalMs_ / 4, intervalMs_ - durationMs);
+    timer_->start(static_cast<int>(delay));
+}
+
+}  // namespace rrcc
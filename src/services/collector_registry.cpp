@@ -0,0 +1,216 @@
+#include "rrcc/collector_registry.hpp"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QMutexLocker>
+#include <QSet>
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+void CollectorRegistry::add(std::unique_ptr<Collector> collector) {
+    Collector* raw = collector.get();
+    const Collector::Traits traits = raw->traits();
+    const QStringList produced = raw->outputs() + traits.privateOutputs;
+    for (const QString& section : produced) {
+        producers_.insert(section, raw);
+    }
+    for (const QString& input : traits.inputs) {
+        for (const QString& section : produced) {
+            if (!consumers_.value(input).contains(section)) {
+                consumers_[input].append(section);
+            }
+        }
+    }
+    collectors_.push_back(std::move(collector));
+}
+
+void CollectorRegistry::addDerived(const QString& section, const QStringList& inputs) {
+    derivedInputs_.insert(section, inputs);
+    for (const QString& input : inputs) {
+        if (!consumers_.value(input).contains(section)) {
+            consumers_[input].append(section);
+        }
+    }
+}
+
+QStringList CollectorRegistry::lanes() const {
+    QStringList names;
+    for (const auto& collector : collectors_) {
+        const QString lane = collector->traits().lane;
+        if (!names.contains(lane)) {
+            names.append(lane);
+        }
+    }
+    return names;
+}
+
+int CollectorRegistry::laneIntervalMs(const QString& lane) const {
+    // The lane ticks as often as its most eager collector asks.
+    int intervalMs = -1;
+    for (const auto& collector : collectors_) {
+        const Collector::Traits traits = collector->traits();
+        if (traits.lane == lane && (intervalMs < 0 || traits.laneIntervalMs < intervalMs)) {
+            intervalMs = traits.laneIntervalMs;
+        }
+    }
+    return intervalMs < 0 ? 1000 : intervalMs;
+}
+
+int CollectorRegistry::minFreshnessMs(const QString& section) const {
+    const Collector* producer = producers_.value(section, nullptr);
+    return producer != nullptr ? producer->traits().minFreshnessMs : Collector::Traits{}.minFreshnessMs;
+}
+
+QList<Collector*> CollectorRegistry::collectorsOn(const QString& lane) const {
+    QList<Collector*> out;
+    for (const auto& collector : collectors_) {
+        if (collector->traits().lane == lane) {
+            out.append(collector.get());
+        }
+    }
+    return out;
+}
+
+Collector* CollectorRegistry::find(const QString& name) const {
+    for (const auto& collector : collectors_) {
+        if (collector->name() == name) {
+            return collector.get();
+        }
+    }
+    return nullptr;
+}
+
+QList<Collector*> CollectorRegistry::producersFor(const QString& section) const {
+    QList<Collector*> out;
+    QSet<QString> visited;
+    QStringList pending = {section};
+    while (!pending.isEmpty()) {
+        const QString next = pending.takeFirst();
+        if (visited.contains(next)) {
+            continue;
+        }
+        visited.insert(next);
+        if (Collector* producer = producers_.value(next, nullptr)) {
+            if (!out.contains(producer)) {
+                out.append(producer);
+            }
+        } else {
+            pending.append(derivedInputs_.value(next));
+        }
+    }
+    return out;
+}
+
+QStringList CollectorRegistry::snapshotSections() const {
+    QStringList sections;
+    for (const auto& collector : collectors_) {
+        sections.append(collector->outputs());
+    }
+    return sections;
+}
+
+QStringList CollectorRegistry::allOutputs() const {
+    QStringList sections;
+    for (const auto& collector : collectors_) {
+        sections.append(collector->outputs() + collector->traits().privateOutputs);
+    }
+    return sections;
+}
+
+QStringList CollectorRegistry::consumersOf(const QString& section) const {
+    QStringList out;
+    QStringList pending = {section};
+    while (!pending.isEmpty()) {
+        const QString next = pending.takeFirst();
+        if (out.contains(next)) {
+            continue;
+        }
+        out.append(next);
+        pending.append(consumers_.value(next));
+    }
+    return out;
+}
+
+QJsonObject CollectorRegistry::run(Collector* collector, CollectorContext& context) {
+    const QString name = collector->name();
+    QElapsedTimer elapsed;
+    elapsed.start();
+    const QJsonObject result = collector->collect(context);
+    const qint64 durationMs = elapsed.elapsed();
+
+    const bool success = result.value("success").toBool(false);
+    const bool skipped = success && result.value("skipped").toBool(false);
+    bool newError = false;
+    {
+        QMutexLocker lock(&mutex_);
+        Stats& stats = stats_[name];
+        if (skipped) {
+            stats.skips++;
+        } else {
+            stats.runs++;
+            stats.lastDurationMs = durationMs;
+            if (success) {
+                stats.lastSuccessEpochMs = QDateTime::currentMSecsSinceEpoch();
+                stats.lastError.clear();
+            } else {
+                stats.errors++;
+                const QString error = result.value("error").toString("unknown error");
+                newError = error != stats.lastError;
+                stats.lastError = error;
+            }
+        }
+    }
+    if (skipped) {
+        Telemetry::instance().incrementCounter("collector." + name + ".skips");
+    } else {
+        Telemetry::instance().incrementCounter("collector." + name + ".runs");
+        Telemetry::instance().recordDurationMs("collector." + name + ".duration_ms", durationMs);
+        if (!success) {
+            Telemetry::instance().incrementCounter("collector." + name + ".errors");
+        }
+        // A failing probe fails every run; record each distinct error once.
+        if (newError) {
+            Telemetry::instance().recordEvent(
+                "collector_error", {{"collector", name}, {"error", result.value("error")}});
+        }
+    }
+    if (listener_) {
+        listener_(name, result);
+    }
+    return result;
+}
+
+QJsonObject CollectorRegistry::status() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QJsonObject out;
+    QMutexLocker lock(&mutex_);
+    for (const auto& collector : collectors_) {
+        const QString name = collector->name();
+        const Collector::Traits traits = collector->traits();
+        const Stats stats = stats_.value(name);
+        QJsonObject entry = {
+            {"lane", traits.lane},
+            {"outputs", QJsonArray::fromStringList(collector->outputs())},
+            {"spawns_processes", traits.spawnsProcesses},
+            {"runs", static_cast<double>(stats.runs)},
+            {"skips", static_cast<double>(stats.skips)},
+            {"errors", static_cast<double>(stats.errors)},
+            {"last_duration_ms", static_cast<double>(stats.lastDurationMs)},
+        };
+        if (stats.lastSuccessEpochMs > 0) {
+            const qint64 stalenessMs = now - stats.lastSuccessEpochMs;
+            entry.insert("staleness_ms", static_cast<double>(stalenessMs));
+            Telemetry::instance().setGauge("collector." + name + ".staleness_ms", static_cast<double>(stalenessMs));
+        }
+        if (!stats.lastError.isEmpty()) {
+            entry.insert("last_error", stats.lastError);
+        }
+        out.insert(name, entry);
+    }
+    return out;
+}
+
+}  // namespace rrcc
@@ -0,0 +1,218 @@
+#include "rrcc/collector_scheduler.hpp"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QMutexLocker>
+
+#include <cmath>
+#include <utility>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+#include "rrcc/command_runner.hpp"
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+// A demand not renewed for this long (a closed view) no longer uses budget.
+constexpr qint64 kDemandExpiryMs = 15000;
+constexpr int kReplanIntervalMs = 5000;
+
+qint64 threadCpuUs() {
+#ifdef __linux__
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#else
+    return 0;
+#endif
+}
+
+}  // namespace
+
+CollectorScheduler::Run::Run(CollectorScheduler* scheduler, QString key)
+    : scheduler_(scheduler),
+      key_(std::move(key)),
+      threadCpuUs_(threadCpuUs()),
+      childCpuUs_(CommandRunner::threadChildCpuUs()) {
+    wall_.start();
+}
+
+CollectorScheduler::Run::~Run() {
+    // Probes this run spawned, as CommandRunner reaped them on this thread.
+    const qint64 cpuUs = (threadCpuUs() - threadCpuUs_) + (CommandRunner::threadChildCpuUs() - childCpuUs_);
+    scheduler_->record(key_, static_cast<double>(wall_.nsecsElapsed()) / 1e6, cpuUs / 1000.0);
+}
+
+void CollectorScheduler::setBudgetPercent(double percent) {
+    QMutexLocker lock(&mutex_);
+    budgetPercent_ = percent;
+    dirty_ = true;
+}
+
+double CollectorScheduler::budgetPercent() const {
+    QMutexLocker lock(&mutex_);
+    return budgetPercent_;
+}
+
+void CollectorScheduler::record(const QString& key, double wallMs, double cpuMs) {
+    QMutexLocker lock(&mutex_);
+    Collector& collector = collectors_[key];
+    if (collector.runs == 0) {
+        collector.wallMs = wallMs;
+        collector.cpuMs = cpuMs;
+    } else {
+        collector.wallMs += kCostAlpha * (wallMs - collector.wallMs);
+        collector.cpuMs += kCostAlpha * (cpuMs - collector.cpuMs);
+    }
+    collector.runs++;
+    dirty_ = true;
+    const double cpuEwma = collector.cpuMs;
+    const double wallEwma = collector.wallMs;
+    lock.unlock();
+    Telemetry::instance().setGauge("collector." + key + ".cpu_ms_ewma", cpuEwma);
+    Telemetry::instance().setGauge("collector." + key + ".wall_ms_ewma", wallEwma);
+}
+
+int CollectorScheduler::plannedIntervalMs(const QString& key, int freshnessMs, bool pinned) {
+    if (freshnessMs < 0) {
+        return -1;
+    }
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker lock(&mutex_);
+    Collector& collector = collectors_[key];
+    if (collector.freshnessMs != freshnessMs || collector.pinned != pinned
+        || now - collector.demandedEpochMs > kDemandExpiryMs) {
+        dirty_ = true;
+    }
+    collector.freshnessMs = freshnessMs;
+    collector.pinned = pinned;
+    collector.demandedEpochMs = now;
+    if (dirty_ || now - plannedEpochMs_ > kReplanIntervalMs) {
+        replanLocked();
+    }
+    return collectors_.value(key).intervalMs;
+}
+
+int CollectorScheduler::currentIntervalMs(const QString& key) const {
+    QMutexLocker lock(&mutex_);
+    const auto it = collectors_.constFind(key);
+    if (it == collectors_.constEnd()
+        || QDateTime::currentMSecsSinceEpoch() - it->demandedEpochMs > kDemandExpiryMs) {
+        return -1;
+    }
+    return it->intervalMs;
+}
+
+int CollectorScheduler::intervalLocked(const Collector& collector, double mu) const {
+    if (collector.pinned || collector.cpuMs <= 0.0 || mu <= 0.0) {
+        return collector.freshnessMs;
+    }
+    const double weight = 1000.0 / qMax(1, collector.freshnessMs);
+    const double stretched = mu * std::sqrt(collector.cpuMs / weight);
+    return static_cast<int>(qBound<double>(collector.freshnessMs, stretched, kMaxIntervalMs));
+}
+
+double CollectorScheduler::plannedUsageLocked(double mu) const {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    double usage = 0.0;
+    for (const Collector& collector : collectors_) {
+        if (collector.freshnessMs < 0 || now - collector.demandedEpochMs > kDemandExpiryMs) {
+            continue;
+        }
+        usage += collector.cpuMs / qMax(1, intervalLocked(collector, mu));
+    }
+    return usage;
+}
+
+void CollectorScheduler::replanLocked() {
+    // CPU ms per wall ms.
+    const double budget = budgetPercent_ / 100.0;
+    double mu = 0.0;
+    overBudget_ = false;
+    if (budget > 0.0 && plannedUsageLocked(0.0) > budget) {
+        double low = 0.0;
+        double high = 1.0;
+        while (plannedUsageLocked(high) > budget && high < 1e7) {
+            high *= 4.0;
+        }
+        overBudget_ = plannedUsageLocked(high) > budget;
+        for (int i = 0; i < 40 && !overBudget_; ++i) {
+            const double middle = (low + high) / 2.0;
+            if (plannedUsageLocked(middle) > budget) {
+                low = middle;
+            } else {
+                high = middle;
+            }
+        }
+        mu = high;
+    }
+    for (Collector& collector : collectors_) {
+        collector.intervalMs = collector.freshnessMs < 0 ? -1 : intervalLocked(collector, mu);
+    }
+    plannedPercent_ = 100.0 * plannedUsageLocked(mu);
+    plannedEpochMs_ = QDateTime::currentMSecsSinceEpoch();
+    dirty_ = false;
+    Telemetry::instance().setGauge("scheduler.planned_cpu_percent", plannedPercent_);
+    Telemetry::instance().setGauge("scheduler.over_budget", overBudget_ ? 1.0 : 0.0);
+}
+
+QJsonObject CollectorScheduler::status() const {
+    QMutexLocker lock(&mutex_);
+    QJsonArray collectors;
+    for (auto it = collectors_.constBegin(); it != collectors_.constEnd(); ++it) {
+        collectors.append(QJsonObject{
+            {"key", it.key()},
+            {"cpu_ms", it->cpuMs},
+            {"wall_ms", it->wallMs},
+            {"runs", static_cast<double>(it->runs)},
+            {"freshness_ms", it->freshnessMs},
+            {"interval_ms", it->intervalMs},
+            {"pinned", it->pinned},
+        });
+    }
+    return {
+        {"budget_percent", budgetPercent_},
+        {"planned_percent", plannedPercent_},
+        {"over_budget", overBudget_},
+        {"collectors", collectors},
+    };
+}
+
+QJsonObject CollectorScheduler::exportCosts() const {
+    QMutexLocker lock(&mutex_);
+    QJsonObject costs;
+    for (auto it = collectors_.constBegin(); it != collectors_.constEnd(); ++it) {
+        if (it->runs == 0) {
+            continue;
+        }
+        costs.insert(it.key(), QJsonObject{
+            {"cpu_ms", it->cpuMs},
+            {"wall_ms", it->wallMs},
+            {"runs", static_cast<double>(it->runs)},
+        });
+    }
+    return costs;
+}
+
+void CollectorScheduler::importCosts(const QJsonObject& costs) {
+    QMutexLocker lock(&mutex_);
+    for (auto it = costs.constBegin(); it != costs.constEnd(); ++it) {
+        const QJsonObject cost = it.value().toObject();
+        Collector& collector = collectors_[it.key()];
+        if (collector.runs > 0 || cost.value("runs").toInteger(0) <= 0) {
+            continue;
+        }
+        collector.cpuMs = qMax(0.0, cost.value("cpu_ms").toDouble());
+        collector.wallMs = qMax(0.0, cost.value("wall_ms").toDouble());
+        // Later runs are smoothed into the imported cost, not replacing it.
+        collector.runs = cost.value("runs").toInteger(0);
+    }
+    dirty_ = true;
+}
+
+}  // namespace rrcc
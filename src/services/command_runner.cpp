@@ -1,27 +1,208 @@
 #include "rrcc/command_runner.hpp"
 
+#include <QByteArray>
 #include <QElapsedTimer>
+#include <QList>
 #include <QProcess>
 #include <QProcessEnvironment>
+#include <QVector>
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 #include "rrcc/telemetry.hpp"
 
 namespace rrcc {
 
+namespace {
+
+// CPU of the commands this thread has run and reaped.
+thread_local qint64 threadChildCpu = 0;
+
+QProcessEnvironment commandEnvironment(const QMap<QString, QString>& extraEnv) {
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    for (auto it = extraEnv.constBegin(); it != extraEnv.constEnd(); ++it) {
+        env.insert(it.key(), it.value());
+    }
+    return env;
+}
+
+#ifdef __linux__
+// Appends whatever fd has ready; false once it reached EOF or failed.
+bool drainPipe(int fd, QByteArray* out) {
+    char buffer[16384];
+    while (true) {
+        const ssize_t bytes = ::read(fd, buffer, sizeof(buffer));
+        if (bytes > 0) {
+            out->append(buffer, static_cast<int>(bytes));
+            continue;
+        }
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        return bytes < 0 && errno == EAGAIN;
+    }
+}
+
+// posix_spawn plus wait4, so the run reports the CPU of the command and of
+// the children it reaped; QProcess reaps without rusage.
+CommandResult spawnAndWait(const QString& program,
+                           const QStringList& args,
+                           int timeoutMs,
+                           const QMap<QString, QString>& extraEnv,
+                           const QElapsedTimer& elapsed) {
+    CommandResult result;
+    QList<QByteArray> argStorage{program.toLocal8Bit()};
+    for (const QString& arg : args) {
+        argStorage.append(arg.toLocal8Bit());
+    }
+    QList<QByteArray> envStorage;
+    for (const QString& entry : commandEnvironment(extraEnv).toStringList()) {
+        envStorage.append(entry.toLocal8Bit());
+    }
+    QVector<char*> argv;
+    for (QByteArray& arg : argStorage) {
+        argv.append(arg.data());
+    }
+    argv.append(nullptr);
+    QVector<char*> envp;
+    for (QByteArray& entry : envStorage) {
+        envp.append(entry.data());
+    }
+    envp.append(nullptr);
+
+    int outPipe[2] = {-1, -1};
+    int errPipe[2] = {-1, -1};
+    if (::pipe2(outPipe, O_CLOEXEC) != 0 || ::pipe2(errPipe, O_CLOEXEC) != 0) {
+        for (int fd : {outPipe[0], outPipe[1], errPipe[0], errPipe[1]}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+        result.timedOut = true;
+        result.stderrText = "Failed to start process.";
+        Telemetry::instance().incrementCounter("commands.start_failures");
+        return result;
+    }
+    ::fcntl(outPipe[0], F_SETFL, O_NONBLOCK);
+    ::fcntl(errPipe[0], F_SETFL, O_NONBLOCK);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, errPipe[1], STDERR_FILENO);
+    // Lane threads may block signals; the command starts with defaults.
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t spawnSignals;
+    sigemptyset(&spawnSignals);
+    posix_spawnattr_setsigmask(&attr, &spawnSignals);
+    sigaddset(&spawnSignals, SIGPIPE);
+    posix_spawnattr_setsigdefault(&attr, &spawnSignals);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    pid_t pid = -1;
+    const int spawnError = ::posix_spawnp(&pid, argv.front(), &actions, &attr, argv.data(), envp.data());
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attr);
+    ::close(outPipe[1]);
+    ::close(errPipe[1]);
+    if (spawnError != 0) {
+        ::close(outPipe[0]);
+        ::close(errPipe[0]);
+        result.timedOut = true;
+        result.stderrText = "Failed to start process.";
+        Telemetry::instance().incrementCounter("commands.start_failures");
+        return result;
+    }
+
+    // Reads until the command exits; grandchildren holding the pipes open
+    // do not keep the run waiting.
+    QByteArray stdoutBytes;
+    QByteArray stderrBytes;
+    bool stdoutOpen = true;
+    bool stderrOpen = true;
+    bool exited = false;
+    while (!exited) {
+        const qint64 remainingMs = timeoutMs - elapsed.elapsed();
+        if (remainingMs <= 0) {
+            ::kill(pid, SIGKILL);
+            result.timedOut = true;
+            break;
+        }
+        pollfd fds[2];
+        nfds_t count = 0;
+        if (stdoutOpen) {
+            fds[count++] = {outPipe[0], POLLIN, 0};
+        }
+        if (stderrOpen) {
+            fds[count++] = {errPipe[0], POLLIN, 0};
+        }
+        ::poll(fds, count, static_cast<int>(qMin<qint64>(remainingMs, count > 0 ? 50 : 5)));
+        if (stdoutOpen) {
+            stdoutOpen = drainPipe(outPipe[0], &stdoutBytes);
+        }
+        if (stderrOpen) {
+            stderrOpen = drainPipe(errPipe[0], &stderrBytes);
+        }
+        siginfo_t info{};
+        exited = ::waitid(P_PID, static_cast<id_t>(pid), &info, WEXITED | WNOHANG | WNOWAIT) == 0
+            && info.si_pid == pid;
+    }
+    if (exited) {
+        drainPipe(outPipe[0], &stdoutBytes);
+        drainPipe(errPipe[0], &stderrBytes);
+    }
+    ::close(outPipe[0]);
+    ::close(errPipe[0]);
+
+    int status = 0;
+    rusage usage{};
+    while (::wait4(pid, &status, 0, &usage) < 0 && errno == EINTR) {
+    }
+    const qint64 cpuUs = static_cast<qint64>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000
+        + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+    result.cpuUs = cpuUs;
+    threadChildCpu += cpuUs;
+    if (result.timedOut) {
+        result.stderrText = "Command timed out.";
+        Telemetry::instance().incrementCounter("commands.timeouts");
+        return result;
+    }
+    result.exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    result.stdoutText = QString::fromUtf8(stdoutBytes);
+    result.stderrText = QString::fromUtf8(stderrBytes);
+    return result;
+}
+#endif
+
+}  // namespace
+
 CommandResult CommandRunner::run(
     const QString& program,
     const QStringList& args,
     int timeoutMs,
     const QMap<QString, QString>& extraEnv) {
-    QProcess process;
     QElapsedTimer elapsed;
     elapsed.start();
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    for (auto it = extraEnv.constBegin(); it != extraEnv.constEnd(); ++it) {
-        env.insert(it.key(), it.value());
+#ifdef __linux__
+    CommandResult result = spawnAndWait(program, args, timeoutMs, extraEnv, elapsed);
+    if (result.timedOut) {
+        Telemetry::instance().recordDurationMs("commands.duration_ms", elapsed.elapsed());
+        return result;
     }
-
-    process.setProcessEnvironment(env);
+#else
+    QProcess process;
+    process.setProcessEnvironment(commandEnvironment(extraEnv));
     process.start(program, args);
 
     CommandResult result;
@@ -46,6 +227,7 @@ CommandResult CommandRunner::run(
     result.exitCode = process.exitCode();
     result.stdoutText = QString::fromUtf8(process.readAllStandardOutput());
     result.stderrText = QString::fromUtf8(process.readAllStandardError());
+#endif
     Telemetry::instance().incrementCounter("commands.count");
     if (result.exitCode != 0) {
         Telemetry::instance().incrementCounter("commands.non_zero_exit");
@@ -61,4 +243,8 @@ CommandResult CommandRunner::runShell(
     return run("/bin/bash", {"-lc", command}, timeoutMs, extraEnv);
 }
 
+qint64 CommandRunner::threadChildCpuUs() {
+    return threadChildCpu;
+}
+
 }  // namespace rrcc
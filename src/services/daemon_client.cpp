@@ -0,0 +1,145 @@
+#include "rrcc/daemon_client.hpp"
+
+#include <QJsonValue>
+#include <QLocalSocket>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "rrcc/daemon_protocol.hpp"
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+DaemonClient::DaemonClient(const QString& endpoint, QObject* parent)
+    : QObject(parent),
+      endpoint_(endpoint.trimmed().isEmpty() ? QString(DaemonProtocol::kDefaultSocketName) : endpoint.trimmed()) {
+    reconnectTimer_ = new QTimer(this);
+    reconnectTimer_->setSingleShot(true);
+    connect(reconnectTimer_, &QTimer::timeout, this, &DaemonClient::connectToDaemon);
+
+    if (DaemonProtocol::isTcpEndpoint(endpoint_)) {
+        auto* socket = new QTcpSocket(this);
+        connect(socket, &QTcpSocket::connected, this, &DaemonClient::handleConnected);
+        connect(socket, &QTcpSocket::disconnected, this, [this]() {
+            handleDisconnected("Daemon connection closed.");
+        });
+        connect(socket, &QTcpSocket::errorOccurred, this, [this, socket]() {
+            handleDisconnected(socket->errorString());
+        });
+        socket_ = socket;
+    } else {
+        auto* socket = new QLocalSocket(this);
+        connect(socket, &QLocalSocket::connected, this, &DaemonClient::handleConnected);
+        connect(socket, &QLocalSocket::disconnected, this, [this]() {
+            handleDisconnected("Daemon connection closed.");
+        });
+        connect(socket, &QLocalSocket::errorOccurred, this, [this, socket]() {
+            handleDisconnected(socket->errorString());
+        });
+        socket_ = socket;
+    }
+    connect(socket_, &QIODevice::readyRead, this, &DaemonClient::readFrames);
+}
+
+void DaemonClient::connectToDaemon() {
+    if (connected_) {
+        return;
+    }
+    buffer_.clear();
+    if (auto* tcp = qobject_cast<QTcpSocket*>(socket_)) {
+        const int colon = endpoint_.lastIndexOf(':');
+        tcp->abort();
+        tcp->connectToHost(endpoint_.left(colon), endpoint_.mid(colon + 1).toUShort());
+    } else if (auto* local = qobject_cast<QLocalSocket*>(socket_)) {
+        local->abort();
+        local->connectToServer(endpoint_);
+    }
+}
+
+void DaemonClient::poll(const QJsonObject& request) {
+    pendingPoll_ = request;
+    pollPending_ = true;
+    if (connected_) {
+        send({{"type", "poll"}, {"request", request}});
+    }
+}
+
+void DaemonClient::runAction(const QString& action, const QJsonObject& payload) {
+    if (!connected_) {
+        emit actionFinished({
+            {"action", action},
+            {"success", false},
+            {"error", QString("Not attached to daemon %1.").arg(endpoint_)},
+        });
+        return;
+    }
+    send({{"type", "action"}, {"action", action}, {"payload", payload}});
+}
+
+void DaemonClient::fetchNodeParameters(const QString& domainId, const QString& nodeName) {
+    if (!connected_) {
+        emit nodeParametersReady({
+            {"node", nodeName},
+            {"success", false},
+            {"error", QString("Not attached to daemon %1.").arg(endpoint_)},
+        });
+        return;
+    }
+    send({{"type", "node_parameters"}, {"domain_id", domainId}, {"node", nodeName}});
+}
+
+void DaemonClient::send(const QJsonObject& message) {
+    socket_->write(DaemonProtocol::encode(message));
+}
+
+void DaemonClient::readFrames() {
+    buffer_.append(socket_->readAll());
+    bool ok = true;
+    const QList<QJsonObject> messages = DaemonProtocol::decode(buffer_, &ok);
+    if (!ok) {
+        Telemetry::instance().incrementCounter("daemon_client.bad_frames");
+    }
+    for (const QJsonObject& message : messages) {
+        const QString type = message.value("type").toString();
+        if (type == "snapshot") {
+            pollPending_ = false;
+            emit snapshotReady(message.value("snapshot").toObject());
+        } else if (type == "action_result") {
+            emit actionFinished(message.value("result").toObject());
+        } else if (type == "node_parameters") {
+            emit nodeParametersReady(message.value("result").toObject());
+        }
+    }
+}
+
+void DaemonClient::handleConnected() {
+    connected_ = true;
+    Telemetry::instance().incrementCounter("daemon_client.connects");
+    emit connectionChanged(true, QString("Attached to daemon %1").arg(endpoint_));
+    if (DaemonProtocol::isTcpEndpoint(endpoint_)) {
+        // Without the token (another user's daemon) the attachment is read-only.
+        const QByteArray token =
+            DaemonProtocol::readToken(endpoint_.mid(endpoint_.lastIndexOf(':') + 1).toUShort());
+        if (!token.isEmpty()) {
+            send({{"type", "hello"}, {"token", QString::fromUtf8(token)}});
+        }
+    }
+    if (pollPending_) {
+        // The daemon has no delta baseline for this connection yet.
+        QJsonObject request = pendingPoll_;
+        request.insert("since_version", -1);
+        send({{"type", "poll"}, {"request", request}});
+    }
+}
+
+void DaemonClient::handleDisconnected(const QString& reason) {
+    connected_ = false;
+    // disconnected and errorOccurred can both fire for one failure.
+    if (reconnectTimer_->isActive()) {
+        return;
+    }
+    reconnectTimer_->start(1000);
+    emit connectionChanged(false, QString("Daemon %1 unavailable: %2").arg(endpoint_, reason));
+}
+
+}  // namespace rrcc
@@ -0,0 +1,88 @@
+#include "rrcc/daemon_protocol.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QStandardPaths>
+#include <QtEndian>
+
+namespace rrcc {
+
+QByteArray DaemonProtocol::encode(const QJsonObject& message, SnapshotCodec::Format format) {
+    const QByteArray body = SnapshotCodec::encode(message, format);
+    QByteArray frame(5, Qt::Uninitialized);
+    qToBigEndian<quint32>(static_cast<quint32>(body.size() + 1), frame.data());
+    frame[4] = format == SnapshotCodec::Format::Cbor ? 'C' : 'J';
+    frame.append(body);
+    return frame;
+}
+
+QList<QJsonObject> DaemonProtocol::decode(
+    QByteArray& buffer,
+    bool* ok,
+    SnapshotCodec::Format* format) {
+    QList<QJsonObject> messages;
+    if (ok != nullptr) {
+        *ok = true;
+    }
+    qsizetype offset = 0;
+    while (buffer.size() - offset >= 4) {
+        const quint32 size = qFromBigEndian<quint32>(buffer.constData() + offset);
+        if (size == 0 || size > static_cast<quint32>(kMaxFrameBytes)) {
+            if (ok != nullptr) {
+                *ok = false;
+            }
+            buffer.clear();
+            return messages;
+        }
+        if (buffer.size() - offset - 4 < static_cast<qsizetype>(size)) {
+            break;
+        }
+        const char tag = buffer.at(offset + 4);
+        const SnapshotCodec::Format frameFormat =
+            tag == 'J' ? SnapshotCodec::Format::Json : SnapshotCodec::Format::Cbor;
+        QJsonObject message;
+        const bool decoded = (tag == 'C' || tag == 'J')
+            && SnapshotCodec::decode(
+                buffer.mid(offset + 5, static_cast<qsizetype>(size) - 1), frameFormat, &message);
+        offset += 4 + static_cast<qsizetype>(size);
+        if (!decoded) {
+            if (ok != nullptr) {
+                *ok = false;
+            }
+            continue;
+        }
+        if (format != nullptr) {
+            *format = frameFormat;
+        }
+        messages.append(message);
+    }
+    buffer.remove(0, offset);
+    return messages;
+}
+
+bool DaemonProtocol::isTcpEndpoint(const QString& endpoint) {
+    const int colon = endpoint.lastIndexOf(':');
+    if (colon <= 0) {
+        return false;
+    }
+    bool numeric = false;
+    endpoint.mid(colon + 1).toUShort(&numeric);
+    return numeric;
+}
+
+QString DaemonProtocol::tokenPath(quint16 port) {
+    // $XDG_RUNTIME_DIR: per user and mode 0700.
+    const QString runtimeDir = QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    return QDir(runtimeDir.isEmpty() ? QDir::tempPath() : runtimeDir)
+        .filePath(QString("rosscope-%1.token").arg(port));
+}
+
+QByteArray DaemonProtocol::readToken(quint16 port) {
+    QFile file(tokenPath(port));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return file.readAll().trimmed();
+}
+
+}  // namespace rrcc
@@ -0,0 +1,573 @@
+#include "rrcc/daemon_server.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QHostAddress>
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QThread>
+#include <QTimer>
+
+#include <utility>
+
+#include "rrcc/action_executor.hpp"
+#include "rrcc/daemon_protocol.hpp"
+#include "rrcc/runtime_worker.hpp"
+#include "rrcc/self_usage.hpp"
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+constexpr qint64 kMaxClientBacklogBytes = 8 * 1024 * 1024;
+
+}  // namespace
+
+DaemonServer::DaemonServer(const Options& options, QObject* parent)
+    : QObject(parent),
+      options_(options) {
+    if (options_.socketName.isEmpty()) {
+        options_.socketName = DaemonProtocol::kDefaultSocketName;
+    }
+}
+
+DaemonServer::~DaemonServer() {
+    if (workerThread_ != nullptr) {
+        workerThread_->quit();
+        // No timeout: destroying a running QThread aborts. Lanes stop between
+        // probes, so this takes at most one probe's timeout.
+        workerThread_->wait();
+    }
+    if (localServer_ != nullptr) {
+        localServer_->close();
+    }
+    if (!tcpTokenPath_.isEmpty()) {
+        QFile::remove(tcpTokenPath_);
+    }
+}
+
+QJsonObject DaemonServer::start() {
+    // Only a dead daemon's socket may be reclaimed; a live one keeps its name.
+    QLocalSocket probe;
+    probe.connectToServer(options_.socketName);
+    if (probe.waitForConnected(500)) {
+        probe.abort();
+        return {
+            {"success", false},
+            {"error", QString("A daemon is already running on %1.").arg(options_.socketName)},
+        };
+    }
+
+    workerThread_ = new QThread(this);
+    worker_ = new RuntimeWorker();
+    worker_->moveToThread(workerThread_);
+    connect(workerThread_, &QThread::finished, worker_, &QObject::deleteLater);
+    workerThread_->start();
+
+    connect(this, &DaemonServer::pollRequested, worker_, &RuntimeWorker::poll, Qt::QueuedConnection);
+    connect(this, &DaemonServer::actionRequested, worker_, &RuntimeWorker::runAction, Qt::QueuedConnection);
+    connect(
+        this,
+        &DaemonServer::controlActionRequested,
+        worker_->actionExecutor(),
+        &ActionExecutor::execute,
+        Qt::QueuedConnection);
+    connect(
+        this,
+        &DaemonServer::nodeParametersRequested,
+        worker_,
+        &RuntimeWorker::fetchNodeParameters,
+        Qt::QueuedConnection);
+    connect(worker_, &RuntimeWorker::snapshotReady, this, &DaemonServer::deliverSnapshot);
+    auto forwardResult = [this](const QJsonObject& result) {
+        broadcast({{"type", "action_result"}, {"result", result}});
+    };
+    connect(worker_, &RuntimeWorker::actionFinished, this, forwardResult);
+    connect(worker_->actionExecutor(), &ActionExecutor::actionFinished, this, forwardResult);
+    connect(worker_, &RuntimeWorker::nodeParametersReady, this, [this](const QJsonObject& result) {
+        broadcast({{"type", "node_parameters"}, {"result", result}});
+    });
+
+    QJsonObject result{{"success", true}};
+    // A crashed daemon leaves its socket file behind.
+    QLocalServer::removeServer(options_.socketName);
+    localServer_ = new QLocalServer(this);
+    localServer_->setSocketOptions(QLocalServer::UserAccessOption);
+    if (localServer_->listen(options_.socketName)) {
+        result.insert("socket", localServer_->fullServerName());
+        connect(localServer_, &QLocalServer::newConnection, this, [this]() {
+            while (QLocalSocket* socket = localServer_->nextPendingConnection()) {
+                connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+                    removeClient(socket);
+                });
+                addClient(socket, false);
+            }
+        });
+    } else {
+        result.insert("success", false);
+        result.insert("error", "Local socket listen failed: " + localServer_->errorString());
+    }
+
+    if (options_.tcpPort > 0) {
+        tcpServer_ = new QTcpServer(this);
+        // Loopback only; remote robots are reached through the SSH fleet path.
+        if (tcpServer_->listen(QHostAddress::LocalHost, options_.tcpPort)) {
+            result.insert("tcp_port", tcpServer_->serverPort());
+            writeTcpToken(&result);
+            connect(tcpServer_, &QTcpServer::newConnection, this, [this]() {
+                while (QTcpSocket* socket = tcpServer_->nextPendingConnection()) {
+                    connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+                        removeClient(socket);
+                    });
+                    addClient(socket, true);
+                }
+            });
+        } else {
+            result.insert("success", false);
+            result.insert("error", "TCP listen failed: " + tcpServer_->errorString());
+        }
+    }
+
+    pushTimer_ = new QTimer(this);
+    pushTimer_->setSingleShot(true);
+    connect(pushTimer_, &QTimer::timeout, this, &DaemonServer::requestWorkerPoll);
+
+    keepAliveTimer_ = new QTimer(this);
+    connect(keepAliveTimer_, &QTimer::timeout, this, &DaemonServer::keepAlive);
+    keepAliveTimer_->start(qMax(250, options_.keepAliveMs));
+
+    statsTimer_ = new QTimer(this);
+    connect(statsTimer_, &QTimer::timeout, this, &DaemonServer::sampleSelfUsage);
+    statsTimer_->start(5000);
+    // Nothing is collected until a client asks for it.
+    worker_->setSectionInterest({});
+    viewRequest_ = {{"process_scope", "ROS Only"}};
+    sampleSelfUsage();
+    keepAlive();
+    return result;
+}
+
+void DaemonServer::writeTcpToken(QJsonObject* result) {
+    QByteArray raw(32, Qt::Uninitialized);
+    QRandomGenerator::system()->fillRange(reinterpret_cast<quint32*>(raw.data()), raw.size() / 4);
+    tcpToken_ = raw.toHex();
+    tcpTokenPath_ = DaemonProtocol::tokenPath(tcpServer_->serverPort());
+    // Recreated rather than truncated so it never keeps looser permissions.
+    QFile::remove(tcpTokenPath_);
+    QFile file(tcpTokenPath_);
+    if (file.open(QIODevice::WriteOnly | QIODevice::NewOnly, QFileDevice::ReadOwner | QFileDevice::WriteOwner)
+        && file.write(tcpToken_) == tcpToken_.size()) {
+        result->insert("tcp_token_file", tcpTokenPath_);
+        return;
+    }
+    result->insert("tcp_warning", "Cannot write " + tcpTokenPath_ + "; TCP clients are read-only.");
+    tcpToken_.clear();
+    tcpTokenPath_.clear();
+}
+
+void DaemonServer::addClient(QIODevice* device, bool tcp) {
+    Client client;
+    client.tcp = tcp;
+    client.controlAllowed = !tcp;
+    clients_.insert(device, client);
+    connect(device, &QIODevice::readyRead, this, [this, device]() { readClient(device); });
+    Telemetry::instance().incrementCounter("daemon.clients_attached");
+    Telemetry::instance().setGauge("daemon.clients", clients_.size());
+}
+
+void DaemonServer::removeClient(QIODevice* device) {
+    if (clients_.remove(device) == 0) {
+        return;
+    }
+    device->deleteLater();
+    Telemetry::instance().setGauge("daemon.clients", clients_.size());
+    updateSectionInterest();
+}
+
+void DaemonServer::readClient(QIODevice* device) {
+    auto it = clients_.find(device);
+    if (it == clients_.end()) {
+        return;
+    }
+    it->buffer.append(device->readAll());
+    bool ok = true;
+    const QList<QJsonObject> messages = DaemonProtocol::decode(it->buffer, &ok, &it->format);
+    if (!ok) {
+        Telemetry::instance().incrementCounter("daemon.bad_frames");
+    }
+    for (const QJsonObject& message : messages) {
+        handleMessage(device, message);
+    }
+}
+
+void DaemonServer::handleMessage(QIODevice* device, const QJsonObject& message) {
+    static const QStringList kTypes = {
+        "hello", "poll", "subscribe", "unsubscribe", "action", "node_parameters", "stats"};
+    const QString type = message.value("type").toString();
+    Telemetry::instance().incrementCounter(
+        "daemon.messages." + (kTypes.contains(type) ? type : QString("unsupported")));
+    if (greet(device, message)) {
+        return;
+    }
+    if (type == "hello") {
+        send(device, {{"type", "hello"}, {"success", true}, {"control", clients_.value(device).controlAllowed}});
+    } else if (type == "poll") {
+        QJsonObject request = message.value("request").toObject();
+        Client& client = clients_[device];
+        client.pollPending = true;
+        client.pollSince = request.value("since_version").toInteger(-1);
+        client.declaresInterests = request.contains("interests");
+        client.interests = request.value("interests").toObject();
+        if (!client.pulls) {
+            client.pulls = true;
+            updateSectionInterest();
+        }
+        request.remove("since_version");
+        request.remove("interests");
+        viewRequest_ = request;
+        lastClientPollEpochMs_ = QDateTime::currentMSecsSinceEpoch();
+        requestWorkerPoll();
+    } else if (type == "subscribe") {
+        subscribe(device, message);
+    } else if (type == "unsubscribe") {
+        clients_[device].subscribed = false;
+        updateSectionInterest();
+    } else if (type == "action") {
+        const QString action = message.value("action").toString();
+        const QJsonObject payload = message.value("payload").toObject();
+        if (!controlAllowed(device, "action_result", {{"action", action}})) {
+            return;
+        }
+        if (ActionExecutor::handles(action)) {
+            emit controlActionRequested(action, payload);
+        } else {
+            emit actionRequested(action, payload);
+        }
+    } else if (type == "node_parameters") {
+        // Each request spawns ros2, so it is gated like an action.
+        if (!controlAllowed(device, "node_parameters", {{"node", message.value("node").toString()}})) {
+            return;
+        }
+        emit nodeParametersRequested(
+            message.value("domain_id").toString("0"), message.value("node").toString());
+    } else if (type == "stats") {
+        send(device, {{"type", "stats"}, {"telemetry", Telemetry::instance().snapshot()}});
+    } else {
+        send(device, {
+            {"type", "error"},
+            {"success", false},
+            {"error", QString("Unsupported message type: %1").arg(type)},
+        });
+    }
+}
+
+bool DaemonServer::greet(QIODevice* device, const QJsonObject& message) {
+    Client& client = clients_[device];
+    if (!client.tcp || client.greeted) {
+        return false;
+    }
+    client.greeted = true;
+    if (message.value("type").toString() != "hello") {
+        return false;
+    }
+    const QByteArray token = message.value("token").toString().toUtf8();
+    // Compared in full so the time taken does not give away a prefix.
+    bool match = !tcpToken_.isEmpty() && token.size() == tcpToken_.size();
+    int difference = 0;
+    for (qsizetype i = 0; match && i < token.size(); ++i) {
+        difference |= token.at(i) ^ tcpToken_.at(i);
+    }
+    client.controlAllowed = match && difference == 0;
+    if (!client.controlAllowed) {
+        Telemetry::instance().incrementCounter("daemon.auth_failures");
+    }
+    send(device, {{"type", "hello"}, {"success", client.controlAllowed}, {"control", client.controlAllowed}});
+    return true;
+}
+
+bool DaemonServer::controlAllowed(QIODevice* device, const QString& replyType, QJsonObject result) {
+    if (clients_.value(device).controlAllowed) {
+        return true;
+    }
+    Telemetry::instance().incrementCounter("daemon.actions_rejected");
+    result.insert("success", false);
+    result.insert("error", "Actions and parameter fetches over TCP need the daemon token (" + tcpTokenPath_ + ").");
+    send(device, {{"type", replyType}, {"result", result}});
+    return false;
+}
+
+void DaemonServer::subscribe(QIODevice* device, const QJsonObject& message) {
+    Client& client = clients_[device];
+    client.subscribed = true;
+    client.sections.clear();
+    for (const QJsonValue& value : message.value("sections").toArray()) {
+        client.sections.insert(value.toString());
+    }
+    client.intervalMs = qBound(100, message.value("interval_ms").toInt(1000), 60000);
+    client.sectionRateMs.clear();
+    const QJsonObject rates = message.value("rates").toObject();
+    for (auto it = rates.constBegin(); it != rates.constEnd(); ++it) {
+        client.sectionRateMs.insert(it.key(), qBound(100, it.value().toInt(client.intervalMs), 600000));
+    }
+    // Resume from the client's last version unless it predates a restart.
+    const qint64 since = message.value("since_version").toInteger(-1);
+    client.sentVersions.clear();
+    client.sectionDueEpochMs.clear();
+    if (since >= 0 && since <= lastSyncVersion_) {
+        for (const QString& section : client.sections) {
+            client.sentVersions.insert(section, since);
+        }
+        client.sentVersions.insert("*", since);
+    }
+    client.nextDueEpochMs = 0;
+    if (message.contains("request")) {
+        viewRequest_ = message.value("request").toObject();
+        viewRequest_.remove("since_version");
+        viewRequest_.remove("interests");
+    }
+
+    QJsonArray sections;
+    for (const QString& section : client.sections) {
+        sections.append(section);
+    }
+    send(device, {
+        {"type", "subscribed"},
+        {"sections", sections},
+        {"interval_ms", client.intervalMs},
+        {"sync_version", static_cast<double>(lastSyncVersion_)},
+    });
+    updateSectionInterest();
+    requestWorkerPoll();
+}
+
+bool DaemonServer::writeFrame(QIODevice* device, const QByteArray& frame) {
+    const auto it = clients_.find(device);
+    if (it == clients_.end() || it->closing) {
+        return false;
+    }
+    if (device->bytesToWrite() > kMaxClientBacklogBytes) {
+        // Replies and events are not resent, so a client this far behind is
+        // dropped rather than buffered for. Closed from the event loop: the
+        // caller may be iterating clients_.
+        it->closing = true;
+        Telemetry::instance().incrementCounter("daemon.slow_client_disconnects");
+        QTimer::singleShot(0, device, [device]() {
+            if (auto* local = qobject_cast<QLocalSocket*>(device)) {
+                local->abort();
+            } else if (auto* tcp = qobject_cast<QTcpSocket*>(device)) {
+                tcp->abort();
+            }
+        });
+        return false;
+    }
+    device->write(frame);
+    Telemetry::instance().incrementCounter("daemon.bytes_sent", frame.size());
+    return true;
+}
+
+void DaemonServer::send(QIODevice* device, const QJsonObject& message) {
+    writeFrame(device, DaemonProtocol::encode(message, clients_.value(device).format));
+}
+
+void DaemonServer::broadcast(const QJsonObject& message) {
+    // Encode at most once per encoding in use.
+    QHash<int, QByteArray> frames;
+    for (auto it = clients_.constBegin(); it != clients_.constEnd(); ++it) {
+        QByteArray& frame = frames[static_cast<int>(it->format)];
+        if (frame.isEmpty()) {
+            frame = DaemonProtocol::encode(message, it->format);
+        }
+        writeFrame(it.key(), frame);
+    }
+}
+
+void DaemonServer::deliverSnapshot(const QJsonObject& snapshot) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const QJsonObject sectionVersions = snapshot.value("section_versions").toObject();
+    const QStringList sectionNames = sectionVersions.keys();
+    lastSyncVersion_ = snapshot.value("sync_version").toInteger(0);
+
+    // Clients that end up with the same sections share one encoded frame.
+    QHash<QString, QByteArray> frames;
+    for (auto it = clients_.begin(); it != clients_.end(); ++it) {
+        Client& client = it.value();
+        const bool pushDue = client.subscribed && now >= client.nextDueEpochMs;
+        if (!client.pollPending && !pushDue) {
+            continue;
+        }
+        // A client that is not draining its socket is skipped, not waited on;
+        // it gets everything it missed once it catches up.
+        if (it.key()->bytesToWrite() > kMaxClientBacklogBytes) {
+            Telemetry::instance().incrementCounter("daemon.slow_client_skips");
+            continue;
+        }
+
+        QStringList included;
+        bool full = false;
+        if (client.pollPending) {
+            full = client.pollSince < 0 || client.pollSince > lastSyncVersion_;
+            for (const QString& name : sectionNames) {
+                if (full || sectionVersions.value(name).toInteger(0) > client.pollSince) {
+                    included.append(name);
+                }
+            }
+            client.pollPending = false;
+        } else {
+            full = client.sentVersions.isEmpty();
+            const qint64 baseline = client.sentVersions.value("*", -1);
+            for (const QString& name : sectionNames) {
+                if (!client.sections.isEmpty() && !client.sections.contains(name)) {
+                    continue;
+                }
+                const qint64 version = sectionVersions.value(name).toInteger(0);
+                if (version <= client.sentVersions.value(name, baseline)
+                    || now < client.sectionDueEpochMs.value(name, 0)) {
+                    continue;
+                }
+                included.append(name);
+                client.sentVersions.insert(name, version);
+                client.sectionDueEpochMs.insert(
+                    name, now + client.sectionRateMs.value(name, client.intervalMs));
+            }
+            client.nextDueEpochMs = now + client.intervalMs;
+            for (const int rateMs : std::as_const(client.sectionRateMs)) {
+                client.nextDueEpochMs = qMin(client.nextDueEpochMs, now + rateMs);
+            }
+            if (included.isEmpty()) {
+                Telemetry::instance().incrementCounter("daemon.push_suppressed");
+                continue;
+            }
+        }
+
+        const QString frameKey = QString::number(static_cast<int>(client.format))
+            + (full ? "F" : "D") + included.join(',');
+        QByteArray& frame = frames[frameKey];
+        if (frame.isEmpty()) {
+            QJsonObject message = snapshot;
+            for (const QString& name : sectionNames) {
+                if (!included.contains(name)) {
+                    message.remove(name);
+                }
+            }
+            message.insert("delta", !full);
+            if (included.isEmpty()) {
+                message.insert("heartbeat_only", true);
+            }
+            frame = DaemonProtocol::encode({{"type", "snapshot"}, {"snapshot", message}}, client.format);
+        }
+        if (writeFrame(it.key(), frame)) {
+            Telemetry::instance().incrementCounter("daemon.sections_sent", included.size());
+        }
+    }
+    schedulePush();
+}
+
+void DaemonServer::updateSectionInterest() {
+    QSet<QString> interest;
+    for (const Client& client : std::as_const(clients_)) {
+        // Pull clients and catch-all subscribers may render any section.
+        if (client.pulls || (client.subscribed && client.sections.isEmpty())) {
+            interest = {QString("*")};
+            break;
+        }
+        if (client.subscribed) {
+            interest.unite(client.sections);
+        }
+    }
+    worker_->setSectionInterest(QStringList(interest.begin(), interest.end()));
+}
+
+QJsonObject DaemonServer::mergedInterests() const {
+    const QJsonObject defaults = RuntimeWorker::defaultInterests();
+    QHash<QString, int> freshnessMs;
+    auto want = [&freshnessMs](const QString& section, int ms) {
+        const auto it = freshnessMs.constFind(section);
+        if (it == freshnessMs.constEnd() || ms < it.value()) {
+            freshnessMs.insert(section, ms);
+        }
+    };
+    for (const Client& client : std::as_const(clients_)) {
+        if (client.pulls) {
+            const QJsonObject& interests = client.declaresInterests ? client.interests : defaults;
+            for (auto it = interests.constBegin(); it != interests.constEnd(); ++it) {
+                want(it.key(), it.value().toInt(defaults.value(it.key()).toInt(2000)));
+            }
+        }
+        if (!client.subscribed) {
+            continue;
+        }
+        if (client.sections.isEmpty()) {
+            // Catch-all subscribers get the defaults, tightened by any rates.
+            for (auto it = defaults.constBegin(); it != defaults.constEnd(); ++it) {
+                want(it.key(), client.sectionRateMs.value(it.key(), it.value().toInt()));
+            }
+            for (auto it = client.sectionRateMs.constBegin(); it != client.sectionRateMs.constEnd(); ++it) {
+                want(it.key(), it.value());
+            }
+        } else {
+            for (const QString& section : client.sections) {
+                want(section, client.sectionRateMs.value(section, client.intervalMs));
+            }
+        }
+    }
+
+    QJsonObject interests;
+    for (auto it = freshnessMs.constBegin(); it != freshnessMs.constEnd(); ++it) {
+        interests.insert(it.key(), it.value());
+    }
+    return interests;
+}
+
+void DaemonServer::requestWorkerPoll() {
+    QJsonObject request = viewRequest_;
+    // One client's view must not starve another's sections.
+    request.insert("interests", mergedInterests());
+    // Per-client deltas are cut here, so the worker always sends everything.
+    request.insert("since_version", -1);
+    request.insert("requested_epoch_ms", static_cast<double>(QDateTime::currentMSecsSinceEpoch()));
+    emit pollRequested(request);
+}
+
+void DaemonServer::schedulePush() {
+    qint64 nextDue = -1;
+    for (const Client& client : std::as_const(clients_)) {
+        if (client.subscribed && (nextDue < 0 || client.nextDueEpochMs < nextDue)) {
+            nextDue = client.nextDueEpochMs;
+        }
+    }
+    if (nextDue < 0) {
+        pushTimer_->stop();
+        return;
+    }
+    const qint64 delayMs = qMax<qint64>(0, nextDue - QDateTime::currentMSecsSinceEpoch());
+    if (!pushTimer_->isActive() || pushTimer_->remainingTime() > delayMs) {
+        pushTimer_->start(static_cast<int>(delayMs));
+    }
+}
+
+void DaemonServer::keepAlive() {
+    if (QDateTime::currentMSecsSinceEpoch() - lastClientPollEpochMs_ < 2 * options_.keepAliveMs
+        || pushTimer_->isActive()) {
+        return;
+    }
+    requestWorkerPoll();
+}
+
+void DaemonServer::sampleSelfUsage() {
+    const double cpuPercent = selfUsage_.sampleCpuPercent();
+    if (cpuPercent >= 0.0) {
+        Telemetry::instance().setGauge("daemon.cpu_percent", cpuPercent);
+    }
+    Telemetry::instance().setGauge("daemon.rss_kb", static_cast<double>(SelfUsage::rssKb()));
+    Telemetry::instance().exportToFile(QDir(QDir::currentPath()).filePath("logs/telemetry_live.json"));
+}
+
+}  // namespace rrcc
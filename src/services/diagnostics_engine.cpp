@@ -79,6 +79,7 @@ QJsonObject DiagnosticsEngine::evaluate(
     const QJsonObject& graph,
     const QJsonObject& tfNav2,
     const QJsonObject& system,
+    const QJsonObject& thermal,
     const QJsonObject& health,
     const QJsonObject& parameters,
     bool deepSampling,
@@ -88,7 +89,7 @@ QJsonObject DiagnosticsEngine::evaluate(
     const QJsonObject qosState = qosMismatchDetector(graph);
     const QJsonObject lifecycleState = lifecycleTimeline(tfNav2);
     const QJsonObject executorState = executorLoadMonitor(processes, graph);
-    const QJsonObject correlationState = crossCorrelationTimeline(system, graph, tfNav2);
+    const QJsonObject correlationState = crossCorrelationTimeline(system, thermal, graph, tfNav2, rateState);
     const QJsonObject leakState = memoryLeakDetection(processes);
     const QJsonObject ddsState = ddsParticipantInspector(domains, health);
     const QJsonObject netState = networkSaturationMonitor(system, pollIntervalMs);
@@ -332,8 +333,10 @@ QJsonObject DiagnosticsEngine::executorLoadMonitor(
 
 QJsonObject DiagnosticsEngine::crossCorrelationTimeline(
     const QJsonObject& system,
+    const QJsonObject& thermal,
     const QJsonObject& graph,
-    const QJsonObject& tfNav2) {
+    const QJsonObject& tfNav2,
+    const QJsonObject& topicRates) {
     QJsonObject row;
     row.insert("timestamp_utc", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
     row.insert("cpu_percent", system.value("cpu").toObject().value("usage_percent").toDouble());
@@ -341,6 +344,32 @@ QJsonObject DiagnosticsEngine::crossCorrelationTimeline(
     row.insert("tf_warnings", tfNav2.value("tf_warnings").toArray().size());
     row.insert("goal_active", tfNav2.value("nav2").toObject().value("goal_active").toBool(false));
 
+    // A topic below its expected rate, or well below its own recent mean.
+    QJsonArray rateDrops = topicRates.value("dropped_topics").toArray();
+    for (const QJsonValue& value : topicRates.value("topic_metrics").toArray()) {
+        const QJsonObject metric = value.toObject();
+        const QString topic = metric.value("topic").toString();
+        const double actual = metric.value("actual_hz").toDouble(-1.0);
+        const double mean = metric.value("mean_hz").toDouble(-1.0);
+        if (actual >= 0.0 && mean > 0.0 && actual < mean * 0.7 && !rateDrops.contains(topic)) {
+            rateDrops.append(topic);
+        }
+    }
+    row.insert("rate_drops", rateDrops);
+
+    if (!thermal.isEmpty()) {
+        // Throttling that came and went between evaluations still counts.
+        const qint64 events = static_cast<qint64>(thermal.value("throttle_events").toDouble(0));
+        const bool throttled = thermal.value("throttled").toBool(false)
+            || (lastThrottleEvents_ >= 0 && events > lastThrottleEvents_);
+        lastThrottleEvents_ = events;
+        row.insert("throttled", throttled);
+        if (thermal.contains("max_temp_c")) {
+            row.insert("max_temp_c", thermal.value("max_temp_c").toDouble());
+        }
+        row.insert("min_freq_ratio", thermal.value("min_freq_ratio").toDouble(1.0));
+    }
+
     timeline_.append(row);
     while (timeline_.size() > timelineLimit_) {
         timeline_.removeAt(0);
@@ -356,6 +385,16 @@ QJsonObject DiagnosticsEngine::crossCorrelationTimeline(
                 {"inference", "CPU spike correlated with ROS degradation"},
             });
         }
+        const QJsonArray drops = s.value("rate_drops").toArray();
+        if (s.value("throttled").toBool(false) && !drops.isEmpty()) {
+            correlated.append(QJsonObject{
+                {"timestamp_utc", s.value("timestamp_utc").toString()},
+                {"inference", "Thermal/frequency throttling coincided with topic rate drops"},
+                {"topics", drops},
+                {"max_temp_c", s.value("max_temp_c")},
+                {"min_freq_ratio", s.value("min_freq_ratio")},
+            });
+        }
     }
     return QJsonObject{{"timeline", timeline_}, {"correlated_events", correlated}};
 }
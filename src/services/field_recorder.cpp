@@ -0,0 +1,205 @@
+#include "rrcc/field_recorder.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QThread>
+#include <QTimer>
+
+#include "rrcc/daemon_protocol.hpp"
+#include "rrcc/runtime_worker.hpp"
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+constexpr double kMaxSlowdown = 16.0;
+constexpr int kGovernorIntervalMs = 10000;
+
+}  // namespace
+
+const QStringList& FieldRecorder::defaultSections() {
+    static const QStringList kSections = {
+        "processes_visible",
+        "domain_summaries",
+        "domains",
+        "graph",
+        "system",
+        "logs",
+        "health",
+    };
+    return kSections;
+}
+
+FieldRecorder::FieldRecorder(const Options& options, QObject* parent)
+    : QObject(parent),
+      options_(options) {
+    options_.intervalMs = qMax(250, options_.intervalMs);
+}
+
+FieldRecorder::~FieldRecorder() {
+    if (workerThread_ != nullptr) {
+        workerThread_->quit();
+        // No timeout: destroying a running QThread aborts. Lanes stop between
+        // probes, so this takes at most one probe's timeout.
+        workerThread_->wait();
+    }
+    if (file_ != nullptr) {
+        file_->close();
+        delete file_;
+    }
+}
+
+QJsonObject FieldRecorder::start() {
+    worker_ = new RuntimeWorker();
+    worker_->setWarmStartEnabled(false);
+    // Collectors plan within most of the cap; the slowdown below covers the rest.
+    worker_->setCollectorBudgetPercent(options_.cpuCapPercent * 0.8);
+    // Resolved before the first file, whose header lists the sections.
+    if (options_.sections.isEmpty()) {
+        options_.sections = defaultSections();
+        // An enabled watchdog evaluates diagnostics anyway; record its state.
+        if (worker_->watchdogEnabled()) {
+            options_.sections.append("watchdog");
+        }
+    }
+    QString error;
+    if (!QDir().mkpath(options_.directory)) {
+        error = "Cannot create " + options_.directory;
+    } else if (!openNextFile()) {
+        error = "Cannot open a stream file in " + options_.directory;
+    }
+    if (!error.isEmpty()) {
+        delete worker_;
+        worker_ = nullptr;
+        return {{"success", false}, {"error", error}};
+    }
+
+    workerThread_ = new QThread(this);
+    worker_->moveToThread(workerThread_);
+    connect(workerThread_, &QThread::finished, worker_, &QObject::deleteLater);
+    workerThread_->start(QThread::LowPriority);
+    connect(this, &FieldRecorder::pollRequested, worker_, &RuntimeWorker::poll, Qt::QueuedConnection);
+    connect(worker_, &RuntimeWorker::snapshotReady, this, &FieldRecorder::writeFrame);
+
+    pollTimer_ = new QTimer(this);
+    pollTimer_->setSingleShot(true);
+    connect(pollTimer_, &QTimer::timeout, this, &FieldRecorder::requestPoll);
+    governorTimer_ = new QTimer(this);
+    connect(governorTimer_, &QTimer::timeout, this, &FieldRecorder::governCpu);
+    governorTimer_->start(kGovernorIntervalMs);
+    selfUsage_.sampleCpuPercent();
+    requestPoll();
+    return {{"success", true}, {"path", file_->fileName()}};
+}
+
+void FieldRecorder::requestPoll() {
+    const int intervalMs = static_cast<int>(options_.intervalMs * slowdown_);
+    // Every recorded section at the recording rate; nothing else runs.
+    QJsonObject interests;
+    for (const QString& section : options_.sections) {
+        interests.insert(section, intervalMs);
+    }
+    emit pollRequested({
+        {"process_scope", "ROS Only"},
+        {"process_limit", 2000},
+        {"interests", interests},
+        {"since_version", static_cast<double>(sinceVersion_)},
+        {"requested_epoch_ms", static_cast<double>(QDateTime::currentMSecsSinceEpoch())},
+    });
+}
+
+void FieldRecorder::writeFrame(const QJsonObject& snapshot) {
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const bool rotate = file_->size() >= options_.rotateBytes
+        || now - fileOpenedEpochMs_ >= static_cast<qint64>(options_.rotateMinutes) * 60000;
+    if (rotate && openNextFile()) {
+        // The new file needs a full frame; skip this delta and ask again.
+        pollTimer_->start(0);
+        return;
+    }
+
+    QJsonObject frame = snapshot;
+    for (auto it = frame.begin(); it != frame.end();) {
+        // Only the recorded sections and the scalar metadata go to disk.
+        const bool structured = it.value().isObject() || it.value().isArray();
+        if (structured && it.key() != "section_versions" && !options_.sections.contains(it.key())) {
+            it = frame.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    const QByteArray bytes =
+        DaemonProtocol::encode({{"type", "snapshot"}, {"epoch_ms", static_cast<double>(now)}, {"snapshot", frame}},
+                               options_.format);
+    if (file_->write(bytes) != bytes.size() || !file_->flush()) {
+        Telemetry::instance().incrementCounter("recorder.write_failures");
+    } else {
+        Telemetry::instance().incrementCounter("recorder.frames");
+        Telemetry::instance().incrementCounter("recorder.bytes_written", bytes.size());
+    }
+    sinceVersion_ = snapshot.value("sync_version").toInteger(sinceVersion_);
+    Telemetry::instance().recordDurationMs("recorder.write_ms", timer.elapsed());
+    pollTimer_->start(static_cast<int>(options_.intervalMs * slowdown_));
+}
+
+bool FieldRecorder::openNextFile() {
+    const QString name = QString("field_%1_%2.rrstream")
+                             .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"))
+                             .arg(fileIndex_, 3, 10, QChar('0'));
+    auto* next = new QFile(QDir(options_.directory).filePath(name));
+    if (!next->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        delete next;
+        Telemetry::instance().incrementCounter("recorder.open_failures");
+        return false;
+    }
+    if (file_ != nullptr) {
+        file_->close();
+        delete file_;
+        Telemetry::instance().incrementCounter("recorder.rotations");
+    }
+    file_ = next;
+    fileIndex_++;
+    fileOpenedEpochMs_ = QDateTime::currentMSecsSinceEpoch();
+    sinceVersion_ = -1;
+
+    QJsonArray sections;
+    for (const QString& section : options_.sections) {
+        sections.append(section);
+    }
+    file_->write(DaemonProtocol::encode(
+        {
+            {"type", "header"},
+            {"started_utc", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+            {"sections", sections},
+            {"interval_ms", options_.intervalMs},
+            {"cpu_cap_percent", options_.cpuCapPercent},
+        },
+        options_.format));
+    return true;
+}
+
+void FieldRecorder::governCpu() {
+    const double cpuPercent = selfUsage_.sampleCpuPercent();
+    if (cpuPercent < 0.0) {
+        return;
+    }
+    // Back off quickly when over the cap, recover slowly well under it.
+    if (cpuPercent > options_.cpuCapPercent) {
+        slowdown_ = qMin(kMaxSlowdown, slowdown_ * 1.5);
+    } else if (cpuPercent < options_.cpuCapPercent * 0.5) {
+        slowdown_ = qMax(1.0, slowdown_ / 1.25);
+    }
+    Telemetry::instance().setGauge("recorder.cpu_percent", cpuPercent);
+    Telemetry::instance().setGauge("recorder.rss_kb", static_cast<double>(SelfUsage::rssKb()));
+    Telemetry::instance().setGauge("recorder.slowdown", slowdown_);
+    Telemetry::instance().setGauge("recorder.effective_interval_ms", options_.intervalMs * slowdown_);
+    Telemetry::instance().exportToFile(QDir(QDir::currentPath()).filePath("logs/telemetry_live.json"));
+}
+
+}  // namespace rrcc
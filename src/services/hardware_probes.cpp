@@ -0,0 +1,270 @@
+#include "rrcc/hardware_probes.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "rrcc/can_monitor.hpp"
+#include "rrcc/command_runner.hpp"
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+bool gpuSnapshot(QJsonArray* gpus) {
+    const CommandResult result = CommandRunner::run(
+        "nvidia-smi",
+        {"--query-gpu=name,utilization.gpu,memory.used,memory.total", "--format=csv,noheader,nounits"},
+        2500);
+    if (!result.success()) {
+        return false;
+    }
+
+    for (const QString& line : result.stdoutText.split('\n', Qt::SkipEmptyParts)) {
+        const QStringList parts = line.split(',', Qt::SkipEmptyParts);
+        if (parts.size() < 4) {
+            continue;
+        }
+        QJsonObject gpu;
+        gpu.insert("name", parts[0].trimmed());
+        gpu.insert("utilization_percent", parts[1].trimmed().toDouble());
+        gpu.insert("memory_used_mb", parts[2].trimmed().toDouble());
+        gpu.insert("memory_total_mb", parts[3].trimmed().toDouble());
+        gpus->append(gpu);
+    }
+    return true;
+}
+
+bool usbDevices(QJsonArray* devices) {
+    const CommandResult result = CommandRunner::run("lsusb", {}, 2500);
+    if (!result.success()) {
+        return false;
+    }
+    for (const QString& line : result.stdoutText.split('\n', Qt::SkipEmptyParts)) {
+        devices->append(line.trimmed());
+    }
+    return true;
+}
+
+bool serialPorts(QJsonArray* ports) {
+    const QDir devDir("/dev");
+    const QStringList patterns = {"ttyUSB*", "ttyACM*", "ttyS*", "ttyAMA*"};
+    const QStringList entries = devDir.entryList(patterns, QDir::System | QDir::NoDotAndDotDot);
+    for (const QString& entry : entries) {
+        ports->append("/dev/" + entry);
+    }
+    return true;
+}
+
+// One line per link, from the same rtnetlink dump the can section uses.
+bool canInterfaces(QJsonArray* can) {
+    CanMonitor monitor;
+    QJsonArray interfaces;
+    if (!monitor.sample(&interfaces)) {
+        return false;
+    }
+    for (const QJsonValue& value : interfaces) {
+        const QJsonObject link = value.toObject();
+        QString line = QString("%1 %2 %3").arg(link.value("name").toString(),
+                                               link.value("up").toBool() ? "UP" : "DOWN",
+                                               link.value("kind").toString());
+        if (link.contains("bitrate")) {
+            line += QString(" %1 %2 bit/s").arg(link.value("state").toString()).arg(link.value("bitrate").toInteger());
+        }
+        can->append(line);
+    }
+    return true;
+}
+
+}  // namespace
+
+HardwareProbes::HardwareProbes() {
+    Probe gpus;
+    gpus.section = "gpus";
+    gpus.tool = "nvidia-smi";
+    gpus.run = gpuSnapshot;
+    probes_.append(gpus);
+
+    Probe usb;
+    usb.section = "usb_devices";
+    usb.tool = "lsusb";
+    usb.run = usbDevices;
+    usb.subsystems = {"usb"};
+    probes_.append(usb);
+
+    Probe serial;
+    serial.section = "serial_ports";
+    serial.run = serialPorts;
+    serial.subsystems = {"tty"};
+    probes_.append(serial);
+
+    Probe can;
+    can.section = "can_interfaces";
+    can.run = canInterfaces;
+    can.subsystems = {"net"};
+    probes_.append(can);
+}
+
+HardwareProbes::~HardwareProbes() {
+#ifdef __linux__
+    if (ueventFd_ >= 0) {
+        ::close(ueventFd_);
+    }
+#endif
+}
+
+void HardwareProbes::drainUevents() {
+#ifdef __linux__
+    if (!ueventChecked_) {
+        ueventChecked_ = true;
+        ueventFd_ = ::socket(AF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+        if (ueventFd_ >= 0) {
+            struct sockaddr_nl addr {};
+            addr.nl_family = AF_NETLINK;
+            // Group 1: events straight from the kernel, before udev rules run.
+            addr.nl_groups = 1;
+            if (::bind(ueventFd_, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) != 0) {
+                ::close(ueventFd_);
+                ueventFd_ = -1;
+            }
+        }
+        if (ueventFd_ < 0) {
+            Telemetry::instance().recordEvent("hardware_probe_uevents_unavailable",
+                                              {{"fallback_interval_ms", kInventoryFallbackMs}});
+        }
+    }
+    if (ueventFd_ < 0) {
+        return;
+    }
+
+    char buffer[8192];
+    while (true) {
+        struct sockaddr_nl sender {};
+        socklen_t senderLength = sizeof(sender);
+        const ssize_t bytes = ::recvfrom(ueventFd_,
+                                         buffer,
+                                         sizeof(buffer),
+                                         MSG_DONTWAIT,
+                                         reinterpret_cast<struct sockaddr*>(&sender),
+                                         &senderLength);
+        if (bytes <= 0) {
+            // EAGAIN once drained. ENOBUFS means events were lost: refresh
+            // everything rather than miss a hotplug.
+            if (bytes < 0 && errno == ENOBUFS) {
+                for (Probe& probe : probes_) {
+                    probe.stale = true;
+                }
+                continue;
+            }
+            break;
+        }
+        if (sender.nl_pid != 0) {
+            // Only the kernel multicasts real uevents.
+            continue;
+        }
+
+        // "ACTION@DEVPATH\0KEY=value\0..."
+        QString action;
+        QString subsystem;
+        const char* end = buffer + bytes;
+        for (const char* field = buffer; field < end; field += std::strlen(field) + 1) {
+            if (std::strncmp(field, "ACTION=", 7) == 0) {
+                action = QString::fromLatin1(field + 7);
+            } else if (std::strncmp(field, "SUBSYSTEM=", 10) == 0) {
+                subsystem = QString::fromLatin1(field + 10);
+            }
+        }
+        if (action != "add" && action != "remove") {
+            continue;
+        }
+        Telemetry::instance().incrementCounter("hardware_probe.uevents");
+        for (Probe& probe : probes_) {
+            if (probe.subsystems.contains(subsystem)) {
+                probe.stale = true;
+            }
+        }
+    }
+#endif
+}
+
+void HardwareProbes::refresh(Probe* probe, qint64 nowMs) {
+    if (!probe->toolChecked || (!probe->available && nowMs >= probe->retryAtMs)) {
+        probe->toolChecked = true;
+        probe->available = probe->tool.isEmpty() || !QStandardPaths::findExecutable(probe->tool).isEmpty();
+        if (!probe->available) {
+            probe->failures++;
+        }
+    }
+
+    if (probe->available) {
+        QJsonArray result;
+        const bool ok = probe->run(&result);
+        Telemetry::instance().incrementCounter(QString("hardware_probe.%1.runs").arg(probe->section));
+        if (ok) {
+            probe->cached = result;
+            probe->failures = 0;
+            probe->stale = false;
+            probe->ranAtMs = nowMs;
+            return;
+        }
+        probe->failures++;
+        probe->available = false;
+        Telemetry::instance().incrementCounter(QString("hardware_probe.%1.failures").arg(probe->section));
+    }
+
+    // 30 s, 60 s, ... up to 30 min between attempts.
+    const int doublings = std::min(probe->failures - 1, 16);
+    probe->retryAtMs = nowMs + std::min(kMaxBackoffMs, kInitialBackoffMs << std::max(0, doublings));
+    probe->cached = QJsonArray();
+}
+
+void HardwareProbes::addTo(QJsonObject* system) {
+    drainUevents();
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    for (Probe& probe : probes_) {
+        bool due = false;
+        if (probe.toolChecked && !probe.available) {
+            due = nowMs >= probe.retryAtMs;
+        } else if (probe.subsystems.isEmpty()) {
+            due = true;
+        } else {
+            due = probe.stale || (ueventFd_ < 0 && nowMs - probe.ranAtMs >= kInventoryFallbackMs);
+        }
+        if (due) {
+            refresh(&probe, nowMs);
+        } else if (probe.available) {
+            Telemetry::instance().incrementCounter(QString("hardware_probe.%1.cache_hits").arg(probe.section));
+        }
+        system->insert(probe.section, probe.cached);
+    }
+    system->insert("device_probes", status());
+}
+
+QJsonObject HardwareProbes::status() const {
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QJsonObject out;
+    for (const Probe& probe : probes_) {
+        QJsonObject entry;
+        entry.insert("state", !probe.toolChecked ? "pending" : (probe.available ? "ok" : "unavailable"));
+        entry.insert("tool", probe.tool);
+        entry.insert("failures", probe.failures);
+        entry.insert("retry_in_ms", probe.available ? 0 : std::max<qint64>(0, probe.retryAtMs - nowMs));
+        entry.insert("age_ms", probe.ranAtMs > 0 ? nowMs - probe.ranAtMs : -1);
+        out.insert(probe.section, entry);
+    }
+    out.insert("hotplug", ueventFd_ >= 0 ? "uevent" : "polling");
+    return out;
+}
+
+}  // namespace rrcc
@@ -0,0 +1,114 @@
+#include "rrcc/json_hash.hpp"
+
+#include <cstring>
+
+namespace rrcc {
+
+namespace {
+
+// 64-bit FNV-1a, fed 16-bit code units and 64-bit words instead of bytes.
+constexpr quint64 kFnvOffset = 14695981039346656037ULL;
+constexpr quint64 kFnvPrime = 1099511628211ULL;
+
+enum : quint64 {
+    kTagNull = 0x11,
+    kTagFalse,
+    kTagTrue,
+    kTagDouble,
+    kTagString,
+    kTagArray,
+    kTagObject,
+};
+
+inline void mix(quint64& state, quint64 word) {
+    state = (state ^ word) * kFnvPrime;
+}
+
+void mixString(quint64& state, const QString& text) {
+    mix(state, static_cast<quint64>(text.size()));
+    const QChar* data = text.constData();
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        mix(state, data[i].unicode());
+    }
+}
+
+void mixValue(quint64& state, const QJsonValue& value);
+
+void mixArray(quint64& state, const QJsonArray& array) {
+    mix(state, kTagArray);
+    mix(state, static_cast<quint64>(array.size()));
+    for (const QJsonValue& item : array) {
+        mixValue(state, item);
+    }
+}
+
+void mixObject(quint64& state, const QJsonObject& object) {
+    mix(state, kTagObject);
+    mix(state, static_cast<quint64>(object.size()));
+    for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+        mixString(state, it.key());
+        mixValue(state, it.value());
+    }
+}
+
+void mixValue(quint64& state, const QJsonValue& value) {
+    switch (value.type()) {
+    case QJsonValue::Bool:
+        mix(state, value.toBool() ? kTagTrue : kTagFalse);
+        break;
+    case QJsonValue::Double: {
+        const double number = value.toDouble();
+        quint64 bits = 0;
+        std::memcpy(&bits, &number, sizeof(bits));
+        mix(state, kTagDouble);
+        mix(state, bits);
+        break;
+    }
+    case QJsonValue::String:
+        mix(state, kTagString);
+        mixString(state, value.toString());
+        break;
+    case QJsonValue::Array:
+        mixArray(state, value.toArray());
+        break;
+    case QJsonValue::Object:
+        mixObject(state, value.toObject());
+        break;
+    default:
+        mix(state, kTagNull);
+        break;
+    }
+}
+
+}  // namespace
+
+quint64 JsonHash::hash(const QJsonValue& value) {
+    quint64 state = kFnvOffset;
+    mixValue(state, value);
+    return state;
+}
+
+quint64 JsonHash::hash(const QJsonObject& value) {
+    quint64 state = kFnvOffset;
+    mixObject(state, value);
+    return state;
+}
+
+quint64 JsonHash::hash(const QJsonArray& value) {
+    quint64 state = kFnvOffset;
+    mixArray(state, value);
+    return state;
+}
+
+quint64 JsonHash::hash(const QString& value) {
+    quint64 state = kFnvOffset;
+    mix(state, kTagString);
+    mixString(state, value);
+    return state;
+}
+
+QString JsonHash::toHex(quint64 hash) {
+    return QString::number(hash, 16).rightJustified(16, '0');
+}
+
+}  // namespace rrcc
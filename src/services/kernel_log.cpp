@@ -0,0 +1,296 @@
+#include "rrcc/kernel_log.hpp"
+
+#include <QDateTime>
+#include <QJsonArray>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/klog.h>
+#include <unistd.h>
+#endif
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+// klogctl(2) actions; glibc does not name them.
+constexpr int kSyslogActionReadAll = 3;
+constexpr int kSyslogActionSizeBuffer = 10;
+
+qulonglong parseUnsigned(const char** at, const char* end) {
+    const char* p = *at;
+    while (p < end && *p == ' ') {
+        ++p;
+    }
+    qulonglong value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<qulonglong>(*p - '0');
+        ++p;
+    }
+    *at = p;
+    return value;
+}
+
+}  // namespace
+
+KernelLog::KernelLog(int capacity) {
+    ring_.resize(std::max(1, capacity));
+}
+
+KernelLog::~KernelLog() {
+#ifdef __linux__
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+#endif
+}
+
+QString KernelLog::levelName(int level) {
+    static const char* const kNames[] = {"emerg", "alert", "crit", "err", "warn", "notice", "info", "debug"};
+    return (level >= 0 && level <= 7) ? QString(kNames[level]) : QString::number(level);
+}
+
+qint64 KernelLog::bootEpochMs() {
+#ifdef __linux__
+    struct timespec ts {};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    const qint64 monotonicMs = static_cast<qint64>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+    return QDateTime::currentMSecsSinceEpoch() - monotonicMs;
+#else
+    return 0;
+#endif
+}
+
+void KernelLog::append(Record record) {
+    lastSeq_ = record.seq;
+    ring_[head_] = std::move(record);
+    head_ = (head_ + 1) % ring_.size();
+    size_ = std::min(size_ + 1, static_cast<int>(ring_.size()));
+}
+
+int KernelLog::poll() {
+    if (source_ == Source::None || source_ == Source::Kmsg) {
+        const int added = pollKmsg();
+        if (added >= 0) {
+            return added;
+        }
+        // Not retried: the restriction that blocked it does not lift.
+        source_ = Source::Klogctl;
+    }
+    if (source_ == Source::Klogctl) {
+        const int added = pollKlogctl();
+        if (added >= 0) {
+            return added;
+        }
+    }
+    source_ = Source::Unavailable;
+    return 0;
+}
+
+// /dev/kmsg: one record per read(), "pri,seq,usec,flags;text\n" followed by
+// " KEY=value" continuation lines, which are skipped.
+int KernelLog::pollKmsg() {
+#ifdef __linux__
+    if (fd_ < 0) {
+        fd_ = ::open("/dev/kmsg", O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd_ < 0) {
+            error_ = QString("/dev/kmsg: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+            return -1;
+        }
+        source_ = Source::Kmsg;
+    }
+
+    const qint64 bootMs = bootEpochMs();
+    int added = 0;
+    while (true) {
+        const ssize_t bytes = ::read(fd_, recordBuffer_, sizeof(recordBuffer_));
+        if (bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EPIPE) {
+                // The kernel overwrote records before we read them; the next
+                // read resumes at the oldest one left.
+                dropped_++;
+                Telemetry::instance().incrementCounter("kernel_log.overruns");
+                continue;
+            }
+            if (errno == EAGAIN) {
+                break;
+            }
+            error_ = QString("/dev/kmsg: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+            ::close(fd_);
+            fd_ = -1;
+            // Readable at open but not at read: dmesg_restrict without CAP_SYSLOG.
+            return added > 0 ? added : -1;
+        }
+        if (bytes == 0) {
+            break;
+        }
+
+        const char* end = recordBuffer_ + bytes;
+        const char* body = static_cast<const char*>(std::memchr(recordBuffer_, ';', static_cast<size_t>(bytes)));
+        if (body == nullptr) {
+            continue;
+        }
+        const char* p = recordBuffer_;
+        const int priority = static_cast<int>(parseUnsigned(&p, body));
+        ++p;
+        const quint64 seq = parseUnsigned(&p, body);
+        ++p;
+        const qulonglong usec = parseUnsigned(&p, body);
+        ++body;
+        // A reopen after a read error starts at the oldest record again.
+        if (size_ > 0 && seq <= lastSeq_) {
+            continue;
+        }
+        const char* textEnd = static_cast<const char*>(std::memchr(body, '\n', static_cast<size_t>(end - body)));
+
+        Record record;
+        record.seq = seq;
+        record.level = priority & 7;
+        record.epochMs = bootMs + static_cast<qint64>(usec / 1000);
+        record.text = QString::fromUtf8(body, static_cast<int>((textEnd != nullptr ? textEnd : end) - body));
+        append(std::move(record));
+        added++;
+    }
+    if (added > 0) {
+        Telemetry::instance().incrementCounter("kernel_log.records", added);
+    }
+    return added;
+#else
+    error_ = "/dev/kmsg is Linux-only.";
+    return -1;
+#endif
+}
+
+// klogctl: the whole buffer as "<pri>[sec.usec] text" lines, re-read per poll.
+int KernelLog::pollKlogctl() {
+#ifdef __linux__
+    if (klogBuffer_.isEmpty()) {
+        const int size = ::klogctl(kSyslogActionSizeBuffer, nullptr, 0);
+        if (size <= 0) {
+            error_ += QString("; klogctl: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+            return -1;
+        }
+        klogBuffer_.resize(size);
+    }
+    const int bytes = ::klogctl(kSyslogActionReadAll, klogBuffer_.data(), static_cast<int>(klogBuffer_.size()));
+    if (bytes < 0) {
+        error_ += QString("; klogctl: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+        return -1;
+    }
+    source_ = Source::Klogctl;
+
+    const qint64 bootMs = bootEpochMs();
+    const qint64 previousLastUs = klogLastUs_;
+    const int previousSeen = klogSeenAtLast_;
+    int atPreviousLast = 0;
+    int added = 0;
+    const char* line = klogBuffer_.constData();
+    const char* end = line + bytes;
+    while (line < end) {
+        const char* next = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        const char* lineEnd = next != nullptr ? next : end;
+        const char* p = line;
+        int level = 6;
+        if (p < lineEnd && *p == '<') {
+            ++p;
+            level = static_cast<int>(parseUnsigned(&p, lineEnd)) & 7;
+            if (p < lineEnd && *p == '>') {
+                ++p;
+            }
+        }
+        // Without printk.time every stamp is 0 and the duplicate count alone
+        // tells new lines apart.
+        qint64 us = 0;
+        if (p < lineEnd && *p == '[') {
+            ++p;
+            us = static_cast<qint64>(parseUnsigned(&p, lineEnd)) * 1000000;
+            if (p < lineEnd && *p == '.') {
+                ++p;
+                us += static_cast<qint64>(parseUnsigned(&p, lineEnd));
+            }
+            if (p < lineEnd && *p == ']') {
+                ++p;
+            }
+            if (p < lineEnd && *p == ' ') {
+                ++p;
+            }
+        }
+        line = lineEnd + 1;
+
+        if (us < previousLastUs) {
+            continue;
+        }
+        if (us == previousLastUs && ++atPreviousLast <= previousSeen) {
+            continue;
+        }
+        if (us > klogLastUs_) {
+            klogLastUs_ = us;
+            klogSeenAtLast_ = 1;
+        } else {
+            klogSeenAtLast_++;
+        }
+        Record record;
+        record.seq = lastSeq_ + 1;
+        record.level = level;
+        record.epochMs = bootMs + us / 1000;
+        record.text = QString::fromUtf8(p, static_cast<int>(lineEnd - p));
+        append(std::move(record));
+        added++;
+    }
+    if (added > 0) {
+        Telemetry::instance().incrementCounter("kernel_log.records", added);
+    }
+    return added;
+#else
+    return -1;
+#endif
+}
+
+QVector<KernelLog::Record> KernelLog::recordsAfter(qint64 afterSeq) const {
+    QVector<Record> records;
+    const int capacity = ring_.size();
+    const int oldest = (head_ - size_ + capacity) % capacity;
+    for (int i = 0; i < size_; ++i) {
+        const Record& record = ring_.at((oldest + i) % capacity);
+        if (static_cast<qint64>(record.seq) > afterSeq) {
+            records.append(record);
+        }
+    }
+    return records;
+}
+
+QJsonObject KernelLog::toJson() const {
+    QJsonObject out;
+    if (source_ == Source::Unavailable || source_ == Source::None) {
+        out.insert("source", "unavailable");
+        out.insert("error", error_.isEmpty() ? QString("kernel log is unavailable.") : error_);
+        return out;
+    }
+    QJsonArray records;
+    for (const Record& record : recordsAfter(-1)) {
+        records.append(QJsonObject{
+            {"seq", static_cast<qint64>(record.seq)},
+            {"level", record.level},
+            {"epoch_ms", record.epochMs},
+            {"text", record.text},
+        });
+    }
+    out.insert("source", source_ == Source::Kmsg ? "kmsg" : "klogctl");
+    out.insert("last_seq", static_cast<qint64>(lastSeq_));
+    out.insert("dropped", dropped_);
+    out.insert("records", records);
+    return out;
+}
+
+}  // namespace rrcc
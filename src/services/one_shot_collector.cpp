@@ -0,0 +1,317 @@
+#include "rrcc/one_shot_collector.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <functional>
+#include <utility>
+
+#include "rrcc/can_monitor.hpp"
+#include "rrcc/diagnostics_engine.hpp"
+#include "rrcc/health_monitor.hpp"
+#include "rrcc/kernel_log.hpp"
+#include "rrcc/process_manager.hpp"
+#include "rrcc/remote_monitor.hpp"
+#include "rrcc/ros_inspector.hpp"
+#include "rrcc/system_monitor.hpp"
+#include "rrcc/telemetry.hpp"
+#include "rrcc/thermal_monitor.hpp"
+
+namespace rrcc {
+
+// Shared with the probe threads, so a probe abandoned at the deadline still
+// has somewhere to write.
+struct OneShotCollector::State : std::enable_shared_from_this<State> {
+    QMutex mutex;
+    QWaitCondition probeFinished;
+    QJsonObject results;
+    QSet<QString> done;
+    QList<QThread*> threads;
+
+    void launch(const QString& name, std::function<QJsonValue()> probe) {
+        std::shared_ptr<State> self = shared_from_this();
+        QThread* thread = QThread::create([self, name, probe]() {
+            QElapsedTimer timer;
+            timer.start();
+            const QJsonValue value = probe();
+            Telemetry::instance().recordDurationMs("once.probe_ms." + name, timer.elapsed());
+            QMutexLocker lock(&self->mutex);
+            self->results.insert(name, value);
+            self->done.insert(name);
+            self->probeFinished.wakeAll();
+        });
+        {
+            QMutexLocker lock(&mutex);
+            threads.append(thread);
+        }
+        thread->start();
+    }
+
+    bool waitFor(const QStringList& names, qint64 deadlineEpochMs) {
+        QMutexLocker lock(&mutex);
+        while (true) {
+            bool all = true;
+            for (const QString& name : names) {
+                all = all && done.contains(name);
+            }
+            if (all) {
+                return true;
+            }
+            const qint64 remainingMs = deadlineEpochMs - QDateTime::currentMSecsSinceEpoch();
+            if (remainingMs <= 0) {
+                return false;
+            }
+            probeFinished.wait(&mutex, static_cast<unsigned long>(remainingMs));
+        }
+    }
+
+    QJsonValue result(const QString& name) {
+        QMutexLocker lock(&mutex);
+        return results.value(name);
+    }
+};
+
+const QStringList& OneShotCollector::allSections() {
+    static const QStringList kSections = {
+        "processes",
+        "domain_summaries",
+        "domains",
+        "graph",
+        "tf_nav2",
+        "system",
+        "thermal",
+        "can",
+        "logs",
+        "health",
+        "advanced",
+        "fleet",
+    };
+    return kSections;
+}
+
+const QStringList& OneShotCollector::defaultSections() {
+    // logs, advanced and fleet are slow or need extra setup; ask for them.
+    static const QStringList kSections = {
+        "processes",
+        "domain_summaries",
+        "domains",
+        "graph",
+        "tf_nav2",
+        "system",
+        "health",
+    };
+    return kSections;
+}
+
+OneShotCollector::OneShotCollector(Options options)
+    : options_(std::move(options)),
+      state_(std::make_shared<State>()) {}
+
+OneShotCollector::~OneShotCollector() {
+    if (!complete_) {
+        return;
+    }
+    for (QThread* thread : std::as_const(state_->threads)) {
+        thread->wait();
+        delete thread;
+    }
+}
+
+QJsonObject OneShotCollector::collect() {
+    QElapsedTimer elapsed;
+    elapsed.start();
+    const qint64 deadline = QDateTime::currentMSecsSinceEpoch() + qMax(250, options_.budgetMs);
+    const QSet<QString> wanted(options_.sections.begin(), options_.sections.end());
+    auto wantsAny = [&wanted](const QStringList& sections) {
+        for (const QString& section : sections) {
+            if (wanted.contains(section)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    const bool needAdvanced = wanted.contains("advanced");
+    const bool needHealth = needAdvanced || wanted.contains("health");
+    const bool needDomains = needHealth || wanted.contains("domains");
+    const bool needGraph = needHealth || wanted.contains("graph");
+    const bool needTf = needHealth || wanted.contains("tf_nav2");
+    const bool needProcesses = needDomains || needGraph || wantsAny({"processes", "domain_summaries"});
+    const bool needSystem = needAdvanced || wanted.contains("system");
+    const bool needThermal = needAdvanced || wanted.contains("thermal");
+
+    // Stage 1: everything that needs nothing else.
+    QStringList launched;
+    auto launch = [this, &launched](const QString& name, std::function<QJsonValue()> probe) {
+        state_->launch(name, std::move(probe));
+        launched.append(name);
+    };
+    if (needProcesses) {
+        launch("processes", []() {
+            // Per-process CPU is a delta too; prime it like the system probe.
+            ProcessManager processManager;
+            processManager.setFullScan(true);
+            processManager.listProcesses(false, "", false);
+            QThread::msleep(250);
+            return QJsonValue(processManager.listProcesses(false, "", true));
+        });
+    }
+    if (needSystem) {
+        launch("system", []() {
+            // CPU usage is a delta; the first sample only primes it.
+            SystemMonitor systemMonitor;
+            systemMonitor.collectCore();
+            QThread::msleep(250);
+            return QJsonValue(systemMonitor.collectSystem());
+        });
+    }
+    if (needThermal) {
+        launch("thermal", []() { return QJsonValue(ThermalMonitor().sample()); });
+    }
+    if (wanted.contains("can")) {
+        launch("can", []() {
+            // Frame rates and bus load are deltas, like CPU usage.
+            CanMonitor canMonitor;
+            QJsonArray interfaces;
+            canMonitor.sample(&interfaces);
+            QThread::msleep(250);
+            interfaces = QJsonArray();
+            QJsonObject can;
+            if (!canMonitor.sample(&interfaces)) {
+                can.insert("error", canMonitor.error());
+            }
+            can.insert("interfaces", interfaces);
+            return QJsonValue(can);
+        });
+    }
+    if (wanted.contains("logs")) {
+        launch("logs", []() {
+            KernelLog kernelLog;
+            kernelLog.poll();
+            return QJsonValue(kernelLog.toJson());
+        });
+    }
+    if (wanted.contains("fleet")) {
+        const int timeoutMs = qBound(500, options_.budgetMs - 250, 4500);
+        launch("fleet", [timeoutMs]() {
+            RemoteMonitor remoteMonitor;
+            const QJsonObject loaded = remoteMonitor.loadTargetsFromFile(
+                QDir(QDir::currentPath()).filePath("fleet_targets.json"));
+            if (!loaded.value("success").toBool(false)) {
+                return QJsonValue(loaded);
+            }
+            return QJsonValue(remoteMonitor.collectFleetStatus(timeoutMs));
+        });
+    }
+    QString domainId = options_.domainId;
+    if (needTf && !domainId.isEmpty()) {
+        launch("tf_nav2", [domainId]() { return QJsonValue(RosInspector().inspectTfNav2(domainId)); });
+    }
+
+    // Stage 2: per-domain probes, once the process list says which domains exist.
+    QJsonArray processes;
+    QJsonArray domainSummaries;
+    QStringList domainIds;
+    const bool processesReady = needProcesses && state_->waitFor({"processes"}, deadline);
+    if (processesReady) {
+        processes = state_->result("processes").toArray();
+        domainSummaries = RosInspector().listDomains(processes);
+        for (const QJsonValue& value : domainSummaries) {
+            domainIds.append(value.toObject().value("domain_id").toString("0"));
+        }
+        if (domainId.isEmpty()) {
+            domainId = domainIds.isEmpty() ? "0" : domainIds.first();
+        }
+        if (needDomains) {
+            for (const QString& id : domainIds) {
+                launch("domain:" + id, [id, processes]() {
+                    return QJsonValue(RosInspector().inspectDomain(id, processes, false));
+                });
+            }
+        }
+        if (needGraph) {
+            launch("graph", [domainId, processes]() {
+                return QJsonValue(RosInspector().inspectGraph(domainId, processes));
+            });
+        }
+        if (needTf && !launched.contains("tf_nav2")) {
+            launch("tf_nav2", [domainId]() { return QJsonValue(RosInspector().inspectTfNav2(domainId)); });
+        }
+    }
+
+    QStringList domainProbes;
+    for (const QString& id : domainIds) {
+        domainProbes.append("domain:" + id);
+    }
+    QJsonArray domains;
+    const bool domainsReady = processesReady && needDomains && state_->waitFor(domainProbes, deadline);
+    if (domainsReady) {
+        for (const QJsonValue& summaryValue : domainSummaries) {
+            const QJsonObject summary = summaryValue.toObject();
+            QJsonObject detail = state_->result("domain:" + summary.value("domain_id").toString("0")).toObject();
+            detail.insert("ros_process_count", summary.value("ros_process_count"));
+            detail.insert("domain_cpu_percent", summary.value("domain_cpu_percent"));
+            detail.insert("domain_memory_percent", summary.value("domain_memory_percent"));
+            detail.insert("workspace_count", summary.value("workspace_count"));
+            domains.append(detail);
+        }
+    }
+
+    // Stage 3: derived sections, only from complete inputs.
+    QJsonObject health;
+    if (needHealth && domainsReady && state_->waitFor({"graph", "tf_nav2"}, deadline)) {
+        health = HealthMonitor().evaluate(
+            domains, state_->result("graph").toObject(), state_->result("tf_nav2").toObject());
+    }
+    if (needAdvanced && !health.isEmpty() && state_->waitFor({"system", "thermal"}, deadline)) {
+        const QJsonObject graph = state_->result("graph").toObject();
+        const QJsonObject tfNav2 = state_->result("tf_nav2").toObject();
+        const QJsonObject system = state_->result("system").toObject();
+        const QJsonObject thermal = state_->result("thermal").toObject();
+        launch("advanced", [domainId, processes, domains, graph, tfNav2, system, thermal, health]() {
+            DiagnosticsEngine diagnosticsEngine;
+            return QJsonValue(diagnosticsEngine.evaluate(
+                domainId, processes, domains, graph, tfNav2, system, thermal, health, QJsonObject{}, false, 2000));
+        });
+    }
+    complete_ = state_->waitFor(launched, deadline);
+
+    QJsonObject snapshot;
+    QJsonArray missing;
+    for (const QString& section : options_.sections) {
+        QJsonValue value;
+        if (section == "domain_summaries") {
+            value = processesReady ? QJsonValue(domainSummaries) : QJsonValue();
+        } else if (section == "domains") {
+            value = domainsReady ? QJsonValue(domains) : QJsonValue();
+        } else if (section == "health") {
+            value = health.isEmpty() ? QJsonValue() : QJsonValue(health);
+        } else {
+            value = state_->result(section);
+        }
+        if (value.isUndefined() || value.isNull()) {
+            missing.append(section);
+        } else {
+            snapshot.insert(section, value);
+        }
+    }
+    complete_ = complete_ && missing.isEmpty();
+    snapshot.insert("domain_id", domainId);
+    snapshot.insert("complete", complete_);
+    snapshot.insert("missing_sections", missing);
+    snapshot.insert("budget_ms", options_.budgetMs);
+    snapshot.insert("duration_ms", static_cast<double>(elapsed.elapsed()));
+    snapshot.insert("timestamp_utc", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
+    return snapshot;
+}
+
+}  // namespace rrcc
@@ -0,0 +1,263 @@
+#include "rrcc/proc_sampler.hpp"
+
+#include <QDateTime>
+#include <QMutexLocker>
+
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+struct MemField {
+    const char* key;
+    int length;
+    qulonglong ProcSample::*field;
+};
+
+constexpr MemField kMemFields[] = {
+    {"MemTotal:", 9, &ProcSample::memTotalKb},
+    {"MemFree:", 8, &ProcSample::memFreeKb},
+    {"MemAvailable:", 13, &ProcSample::memAvailableKb},
+    {"Buffers:", 8, &ProcSample::buffersKb},
+    {"Cached:", 7, &ProcSample::cachedKb},
+    {"SwapTotal:", 10, &ProcSample::swapTotalKb},
+    {"SwapFree:", 9, &ProcSample::swapFreeKb},
+};
+constexpr int kMemFieldCount = static_cast<int>(sizeof(kMemFields) / sizeof(kMemFields[0]));
+
+// Skips blanks, then reads decimal digits; *at ends on the first non-digit.
+qulonglong parseUnsigned(const char** at, const char* end) {
+    const char* p = *at;
+    while (p < end && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    qulonglong value = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + static_cast<qulonglong>(*p - '0');
+        ++p;
+    }
+    *at = p;
+    return value;
+}
+
+// Fields after the "cpuN" label up to the end of the line.
+void parseCpuLine(const char* p, const char* lineEnd, CpuTimes* times) {
+    for (int i = 0; i < CpuTimes::FieldCount; ++i) {
+        // Older kernels stop before guest / guest_nice; those stay zero.
+        if (p >= lineEnd) {
+            break;
+        }
+        times->field[i] = parseUnsigned(&p, lineEnd);
+        times->total += times->field[i];
+    }
+    times->idle = times->field[CpuTimes::Idle] + times->field[CpuTimes::IoWait];
+}
+
+// The aggregate "cpu" line, then one "cpuN" line per online core.
+bool parseStat(const char* data, int size, ProcSample* sample) {
+    const char* end = data + size;
+    const char* line = data;
+    while (line + 3 < end && std::memcmp(line, "cpu", 3) == 0) {
+        const char* next = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        if (next == nullptr) {
+            // Cut off by the buffer; a partial line would read as low counts.
+            break;
+        }
+        const char* p = line + 3;
+        if (*p == ' ') {
+            parseCpuLine(p, next, &sample->cpu);
+        } else if (sample->coreCount < ProcSample::kMaxCores) {
+            const int id = static_cast<int>(parseUnsigned(&p, next));
+            sample->coreIds[sample->coreCount] = id;
+            parseCpuLine(p, next, &sample->cores[sample->coreCount]);
+            sample->coreCount++;
+        }
+        line = next + 1;
+    }
+    return sample->cpu.total > 0;
+}
+
+bool parseMemInfo(const char* data, int size, ProcSample* sample) {
+    const char* end = data + size;
+    const char* line = data;
+    int found = 0;
+    while (line < end && found < kMemFieldCount) {
+        const char* next = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        const char* lineEnd = next != nullptr ? next : end;
+        for (const MemField& field : kMemFields) {
+            if (lineEnd - line > field.length && std::memcmp(line, field.key, static_cast<size_t>(field.length)) == 0) {
+                const char* p = line + field.length;
+                sample->*field.field = parseUnsigned(&p, lineEnd);
+                found++;
+                break;
+            }
+        }
+        line = lineEnd + 1;
+    }
+    const qulonglong total = sample->memTotalKb;
+    const qulonglong available = sample->memAvailableKb;
+    sample->memUsedKb = total > available ? total - available : 0;
+    return total > 0;
+}
+
+// Decimal with an optional fraction, as in /proc/uptime and PSI averages.
+double parseDecimal(const char** at, const char* end) {
+    const char* p = *at;
+    double value = static_cast<double>(parseUnsigned(&p, end));
+    if (p < end && *p == '.') {
+        ++p;
+        double scale = 0.1;
+        while (p < end && *p >= '0' && *p <= '9') {
+            value += scale * (*p - '0');
+            scale /= 10.0;
+            ++p;
+        }
+    }
+    *at = p;
+    return value;
+}
+
+// "avg10=0.00 avg60=0.00 avg300=0.00 total=0"; the kernel keeps that order.
+void parsePressureLine(const char* p, const char* lineEnd, PressureLine* out) {
+    double* averages[] = {&out->avg10, &out->avg60, &out->avg300};
+    for (double* average : averages) {
+        p = static_cast<const char*>(std::memchr(p, '=', static_cast<size_t>(lineEnd - p)));
+        if (p == nullptr) {
+            return;
+        }
+        ++p;
+        *average = parseDecimal(&p, lineEnd);
+    }
+    p = static_cast<const char*>(std::memchr(p, '=', static_cast<size_t>(lineEnd - p)));
+    if (p != nullptr) {
+        ++p;
+        out->totalUs = parseUnsigned(&p, lineEnd);
+    }
+}
+
+bool parsePressure(const char* data, int size, Pressure* pressure) {
+    const char* end = data + size;
+    const char* line = data;
+    while (line + 5 < end) {
+        const char* next = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        const char* lineEnd = next != nullptr ? next : end;
+        if (std::memcmp(line, "some ", 5) == 0) {
+            parsePressureLine(line + 5, lineEnd, &pressure->some);
+            pressure->available = true;
+        } else if (std::memcmp(line, "full ", 5) == 0) {
+            parsePressureLine(line + 5, lineEnd, &pressure->full);
+        }
+        line = lineEnd + 1;
+    }
+    return pressure->available;
+}
+
+constexpr const char* kPressurePaths[ProcSample::PressureCount] = {
+    "/proc/pressure/cpu",
+    "/proc/pressure/io",
+    "/proc/pressure/memory",
+};
+
+}  // namespace
+
+ProcSampler& ProcSampler::instance() {
+    static ProcSampler sampler;
+    return sampler;
+}
+
+ProcSampler::ProcSampler() = default;
+
+ProcSampler::~ProcSampler() {
+    closeAll();
+}
+
+void ProcSampler::closeAll() {
+#ifdef __linux__
+    for (int* fd : {&statFd_, &memInfoFd_, &uptimeFd_, &pressureFds_[0], &pressureFds_[1], &pressureFds_[2]}) {
+        if (*fd >= 0) {
+            ::close(*fd);
+            *fd = -1;
+        }
+    }
+#endif
+}
+
+int ProcSampler::readAt(int* fd, const char* path, char* buffer, int size, bool optional) {
+#ifdef __linux__
+    if (*fd == kUnavailableFd) {
+        return -1;
+    }
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (*fd < 0) {
+            *fd = ::open(path, O_RDONLY | O_CLOEXEC);
+            if (*fd < 0) {
+                // No PSI in this kernel (CONFIG_PSI off); stop probing.
+                *fd = optional ? kUnavailableFd : -1;
+                return -1;
+            }
+            Telemetry::instance().incrementCounter("proc_sampler.opens");
+        }
+        const ssize_t bytes = ::pread(*fd, buffer, static_cast<size_t>(size), 0);
+        if (bytes > 0) {
+            return static_cast<int>(bytes);
+        }
+        ::close(*fd);
+        *fd = -1;
+    }
+    // Booted with psi=0: the files exist but every read fails.
+    if (optional) {
+        *fd = kUnavailableFd;
+    }
+    return -1;
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(path);
+    Q_UNUSED(buffer);
+    Q_UNUSED(size);
+    Q_UNUSED(optional);
+    return -1;
+#endif
+}
+
+ProcSample ProcSampler::sample() {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker lock(&mutex_);
+    if (last_.valid && now - last_.epochMs < kShareWindowMs) {
+        lock.unlock();
+        Telemetry::instance().incrementCounter("proc_sampler.shared_samples");
+        return last_;
+    }
+
+    ProcSample next;
+    next.epochMs = now;
+    const int statBytes = readAt(&statFd_, "/proc/stat", statBuffer_, kStatBytes);
+    const int memInfoBytes = readAt(&memInfoFd_, "/proc/meminfo", memInfoBuffer_, kMemInfoBytes);
+    const int uptimeBytes = readAt(&uptimeFd_, "/proc/uptime", uptimeBuffer_, kUptimeBytes);
+    const bool statOk = statBytes > 0 && parseStat(statBuffer_, statBytes, &next);
+    const bool memOk = memInfoBytes > 0 && parseMemInfo(memInfoBuffer_, memInfoBytes, &next);
+    if (uptimeBytes > 0) {
+        const char* p = uptimeBuffer_;
+        next.uptimeSeconds = parseDecimal(&p, uptimeBuffer_ + uptimeBytes);
+    }
+    for (int i = 0; i < ProcSample::PressureCount; ++i) {
+        const int bytes = readAt(&pressureFds_[i], kPressurePaths[i], pressureBuffer_, kPressureBytes, true);
+        if (bytes > 0) {
+            parsePressure(pressureBuffer_, bytes, &next.pressure[i]);
+        }
+    }
+    next.valid = statOk && memOk;
+    last_ = next;
+    lock.unlock();
+    Telemetry::instance().incrementCounter("proc_sampler.reads");
+    return next;
+}
+
+}  // namespace rrcc
@@ -11,11 +11,13 @@
 
 #include <algorithm>
 #include <csignal>
+#include <utility>
 
 #ifdef __linux__
 #include <unistd.h>
 #endif
 
+#include "rrcc/proc_sampler.hpp"
 #include "rrcc/telemetry.hpp"
 
 namespace {
@@ -260,40 +262,6 @@ QString ProcessManager::uptimeString(double seconds) {
     return QString("%1s").arg(s);
 }
 
-qulonglong ProcessManager::totalJiffies() {
-    const QString stat = readFile("/proc/stat");
-    const QString firstLine = stat.split('\n').value(0);
-    const QStringList fields = firstLine.split(' ', Qt::SkipEmptyParts);
-    if (fields.size() < 8) {
-        return 0;
-    }
-    qulonglong total = 0;
-    for (int i = 1; i < fields.size(); ++i) {
-        total += fields[i].toULongLong();
-    }
-    return total;
-}
-
-qulonglong ProcessManager::memoryTotalKb() {
-    const QString meminfo = readFile("/proc/meminfo");
-    const QStringList lines = meminfo.split('\n', Qt::SkipEmptyParts);
-    for (const QString& line : lines) {
-        if (line.startsWith("MemTotal:")) {
-            const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-            if (parts.size() >= 2) {
-                return parts[1].toULongLong();
-            }
-        }
-    }
-    return 0;
-}
-
-double ProcessManager::systemUptimeSeconds() {
-    const QString uptime = readFile("/proc/uptime");
-    const QString firstToken = uptime.split(' ', Qt::SkipEmptyParts).value(0);
-    return firstToken.toDouble();
-}
-
 QList<qint64> ProcessManager::listChildren(qint64 parentPid) {
     QList<qint64> children;
     const QDir procDir("/proc");
@@ -497,16 +465,42 @@ bool ProcessManager::collectLiteForPid(qint64 pid, bool deepRosInspection) {
         - (static_cast<double>(starttimeTicks) / static_cast<double>(clockTicks_));
 
     if (deepRosInspection) {
-        rec.commandLine = readCmdline(pidPath).left(320);
-        rec.executable = readExePath(pidPath);
-        const QMap<QString, QString> env = readEnviron(pidPath);
-        rec.domainId = env.value("ROS_DOMAIN_ID", "0");
-        rec.isRos = isRosProcess(pidPath, rec.executable, rec.commandLine, env);
-        rec.nodeName = detectNodeName(rec.commandLine);
-        rec.nameSpace = detectNamespace(rec.commandLine);
-        rec.workspaceOrigin = detectWorkspaceOrigin(rec.executable, env);
-        rec.packageName = detectPackage(rec.executable, rec.commandLine);
-        rec.launchSource = detectLaunchSource(rec.commandLine);
+        const QString executable = readExePath(pidPath);
+        auto cached = classifications_.find(pid);
+        bool reuse = cached != classifications_.end() && cached->starttimeTicks == starttimeTicks;
+        if (reuse && cached->stale) {
+            // A previous run's answer fills the first row; the next visit re-reads.
+            reuse = !cached->shown;
+            cached->shown = true;
+        } else if (reuse) {
+            reuse = cached->executable == executable;
+        }
+        if (!reuse) {
+            Classification fresh;
+            fresh.starttimeTicks = starttimeTicks;
+            fresh.executable = executable;
+            fresh.commandLine = readCmdline(pidPath).left(320);
+            const QMap<QString, QString> env = readEnviron(pidPath);
+            fresh.domainId = env.value("ROS_DOMAIN_ID", "0");
+            fresh.isRos = isRosProcess(pidPath, fresh.executable, fresh.commandLine, env);
+            fresh.nodeName = detectNodeName(fresh.commandLine);
+            fresh.nameSpace = detectNamespace(fresh.commandLine);
+            fresh.workspaceOrigin = detectWorkspaceOrigin(fresh.executable, env);
+            fresh.packageName = detectPackage(fresh.executable, fresh.commandLine);
+            fresh.launchSource = detectLaunchSource(fresh.commandLine);
+            cached = classifications_.insert(pid, fresh);
+        } else {
+            classificationHits_++;
+        }
+        rec.commandLine = cached->commandLine;
+        rec.executable = cached->executable;
+        rec.domainId = cached->domainId;
+        rec.isRos = cached->isRos;
+        rec.nodeName = cached->nodeName;
+        rec.nameSpace = cached->nameSpace;
+        rec.workspaceOrigin = cached->workspaceOrigin;
+        rec.packageName = cached->packageName;
+        rec.launchSource = cached->launchSource;
     } else {
         rec.commandLine.clear();
         rec.executable.clear();
@@ -524,6 +518,69 @@ bool ProcessManager::collectLiteForPid(qint64 pid, bool deepRosInspection) {
     return true;
 }
 
+void ProcessManager::invalidate(const QList<qint64>& pids) {
+    for (qint64 pid : pids) {
+        if (pid > 0) {
+            invalidatedPids_.insert(pid);
+        }
+    }
+}
+
+void ProcessManager::setLimits(int maxBudget, int maxHeavyCacheEntries) {
+    maxBudget_ = qMax(minBudget_, maxBudget);
+    updateBudgetPerTick_ = qMin(updateBudgetPerTick_, maxBudget_);
+    maxHeavyCacheEntries_ = qMax(16, maxHeavyCacheEntries);
+    evictHeavyCacheIfNeeded();
+}
+
+QJsonArray ProcessManager::exportClassifications() const {
+    QJsonArray entries;
+    for (auto it = classifications_.constBegin(); it != classifications_.constEnd(); ++it) {
+        const Classification& entry = it.value();
+        if (entry.stale) {
+            continue;
+        }
+        entries.append(QJsonObject{
+            {"pid", it.key()},
+            {"starttime", QString::number(entry.starttimeTicks)},
+            {"command_line", entry.commandLine},
+            {"executable", entry.executable},
+            {"ros_domain_id", entry.domainId},
+            {"is_ros", entry.isRos},
+            {"node_name", entry.nodeName},
+            {"namespace", entry.nameSpace},
+            {"workspace_origin", entry.workspaceOrigin},
+            {"package", entry.packageName},
+            {"launch_source", entry.launchSource},
+        });
+    }
+    return entries;
+}
+
+void ProcessManager::importClassifications(const QJsonArray& entries) {
+    for (const QJsonValue& value : entries) {
+        const QJsonObject json = value.toObject();
+        const qint64 pid = json.value("pid").toInteger(-1);
+        if (pid <= 0 || classifications_.contains(pid)) {
+            continue;
+        }
+        Classification entry;
+        entry.starttimeTicks = json.value("starttime").toString().toULongLong();
+        entry.commandLine = json.value("command_line").toString();
+        entry.executable = json.value("executable").toString();
+        entry.domainId = json.value("ros_domain_id").toString("0");
+        entry.isRos = json.value("is_ros").toBool(false);
+        entry.nodeName = json.value("node_name").toString();
+        entry.nameSpace = json.value("namespace").toString("/");
+        entry.workspaceOrigin = json.value("workspace_origin").toString();
+        entry.packageName = json.value("package").toString();
+        entry.launchSource = json.value("launch_source").toString();
+        entry.stale = true;
+        classifications_.insert(pid, entry);
+    }
+    pruneClassifications_ = true;
+}
+
 void ProcessManager::refreshIncremental(bool deepRosInspection) {
     tickCounter_++;
     if (clockTicks_ <= 0) {
@@ -533,10 +590,11 @@ void ProcessManager::refreshIncremental(bool deepRosInspection) {
         cpuCores_ = std::max(1, static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN)));
     }
 
-    const qulonglong currentTotalJiffies = totalJiffies();
-    memTotalKb_ = memoryTotalKb();
-    tickTotalJiffies_ = currentTotalJiffies;
-    tickUptimeSeconds_ = systemUptimeSeconds();
+    // Shared with the system collector; read once per tick.
+    const ProcSample host = ProcSampler::instance().sample();
+    memTotalKb_ = host.memTotalKb;
+    tickTotalJiffies_ = host.cpu.total;
+    tickUptimeSeconds_ = host.uptimeSeconds;
 
     const QVector<qint64> currentPids = listProcPids();
     for (qint64 pid : currentPids) {
@@ -550,9 +608,25 @@ void ProcessManager::refreshIncremental(bool deepRosInspection) {
         }
     }
 
+    // Pids touched by a control action are refreshed outside the budget.
+    for (qint64 pid : std::as_const(invalidatedPids_)) {
+        if (pidIndex_.contains(pid)) {
+            collectLiteForPid(pid, deepRosInspection);
+        }
+    }
+    invalidatedPids_.clear();
+
     int updated = 0;
     const int rrCount = rrPids_.size();
-    while (updated < updateBudgetPerTick_ && rrCount > 0) {
+    if (fullScan_) {
+        // Once each: a second read in the same tick would zero the CPU delta.
+        for (qint64 pid : std::as_const(rrPids_)) {
+            if (pidIndex_.contains(pid) && collectLiteForPid(pid, deepRosInspection)) {
+                updated++;
+            }
+        }
+    }
+    while (!fullScan_ && updated < updateBudgetPerTick_ && rrCount > 0) {
         if (rrCursor_ >= rrPids_.size()) {
             rrCursor_ = 0;
         }
@@ -576,6 +650,17 @@ void ProcessManager::refreshIncremental(bool deepRosInspection) {
         pidIndex_.remove(pid);
         previousProcJiffies_.remove(pid);
         heavyCache_.remove(pid);
+        classifications_.remove(pid);
+    }
+    if (pruneClassifications_) {
+        for (auto it = classifications_.begin(); it != classifications_.end();) {
+            if (pidIndex_.contains(it.key())) {
+                ++it;
+            } else {
+                it = classifications_.erase(it);
+            }
+        }
+        pruneClassifications_ = false;
     }
 
     rrPids_.erase(
@@ -589,8 +674,8 @@ void ProcessManager::refreshIncremental(bool deepRosInspection) {
     const QVector<HeapEntry> topMem = topKMemory(20);
     prefetchHeavyForTopK(topCpu, topMem, 4);
 
-    const qint64 deltaTotal = static_cast<qint64>(currentTotalJiffies - previousTotalJiffies_);
-    previousTotalJiffies_ = currentTotalJiffies;
+    const qint64 deltaTotal = static_cast<qint64>(host.cpu.total - previousTotalJiffies_);
+    previousTotalJiffies_ = host.cpu.total;
     firstCpuSample_ = false;
 
     if (deltaTotal <= 0 || updated < (updateBudgetPerTick_ / 2)) {
@@ -610,6 +695,7 @@ QJsonObject ProcessManager::toJsonRow(const ProcLite& rec, qulonglong memTotalKb
     row.insert("command_line", rec.commandLine);
     row.insert("cpu_percent", rec.cpuPercent);
     row.insert("memory_percent", memoryPercentKb(rec.rssKb, memTotalKb));
+    row.insert("rss_kb", static_cast<double>(rec.rssKb));
     row.insert("threads", rec.threads);
     row.insert("uptime_seconds", rec.uptimeSeconds);
     row.insert("uptime_human", uptimeString(rec.uptimeSeconds));
@@ -666,6 +752,10 @@ QJsonArray ProcessManager::listProcesses(bool rosOnly, const QString& query, boo
     Telemetry::instance().setGauge("process.last_result_size", static_cast<double>(result.size()));
     Telemetry::instance().setGauge("process.budget_per_tick", static_cast<double>(updateBudgetPerTick_));
     Telemetry::instance().setGauge("process.cache.heavy_size", static_cast<double>(heavyCache_.size()));
+    Telemetry::instance().setGauge(
+        "process.cache.classification_size", static_cast<double>(classifications_.size()));
+    Telemetry::instance().incrementCounter("process.cache.classification_hits", classificationHits_);
+    classificationHits_ = 0;
     Telemetry::instance().recordDurationMs("process.query_ms", timer.elapsed());
     return result;
 #endif
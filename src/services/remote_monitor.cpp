@@ -7,7 +7,6 @@
 #include <QJsonDocument>
 #include <QRandomGenerator>
 #include <QStringList>
-#include <QThread>
 
 #include "rrcc/command_runner.hpp"
 #include "rrcc/telemetry.hpp"
@@ -41,11 +40,24 @@ QString RemoteMonitor::hostKey(const Target& target) {
     return userPrefix + target.host;
 }
 
+int RemoteMonitor::retryBackoffMs(int attempt) {
+    const int base = 250 * (1 << qMin(attempt, 6));
+    const int jitter = static_cast<int>(QRandomGenerator::global()->bounded(350));
+    return qMin(9000, base + jitter);
+}
+
 QString RemoteMonitor::queuePath() const {
     return QDir(QDir::currentPath()).filePath("state/offline_remote_queue.json");
 }
 
+void RemoteMonitor::ensureQueueLoaded() {
+    if (!queueLoaded_) {
+        loadQueue();
+    }
+}
+
 void RemoteMonitor::loadQueue() {
+    queueLoaded_ = true;
     QFile file(queuePath());
     if (!file.exists()) {
         offlineQueue_ = QJsonArray{};
@@ -76,9 +88,7 @@ void RemoteMonitor::persistQueue() const {
 }
 
 void RemoteMonitor::enqueueOfflineAction(const QJsonObject& action) {
-    if (offlineQueue_.isEmpty()) {
-        loadQueue();
-    }
+    ensureQueueLoaded();
     offlineQueue_.append(action);
     while (offlineQueue_.size() > maxOfflineQueue_) {
         offlineQueue_.removeFirst();
@@ -151,7 +161,8 @@ QJsonArray RemoteMonitor::targets() const {
     return targets_;
 }
 
-QJsonObject RemoteMonitor::collectFleetStatus(int timeoutMs) const {
+QJsonObject RemoteMonitor::collectFleetStatus(int timeoutMs, bool dueRetriesOnly) const {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
     QJsonArray robots;
     for (const QJsonValue& value : targets_) {
         const Target target = fromJson(value.toObject());
@@ -160,6 +171,11 @@ QJsonObject RemoteMonitor::collectFleetStatus(int timeoutMs) const {
         }
 
         const QString key = target.name + "|status";
+        const bool retryDue = statusRetryDueMs_.contains(key) && statusRetryDueMs_.value(key) <= now;
+        if (dueRetriesOnly && !retryDue && lastRobotStatus_.contains(target.name)) {
+            robots.append(lastRobotStatus_.value(target.name));
+            continue;
+        }
         QJsonObject robot = toJson(target);
         if (isCircuitOpen(key)) {
             robot.insert("reachable", false);
@@ -186,18 +202,24 @@ QJsonObject RemoteMonitor::collectFleetStatus(int timeoutMs) const {
             "bash", "-lc", remoteScript,
         };
 
-        CommandResult result;
-        for (int attempt = 0; attempt < 2; ++attempt) {
-            Telemetry::instance().recordRequest();
-            result = CommandRunner::run("ssh", args, timeoutMs);
-            if (result.success()) {
-                onCircuitSuccess(key);
-                break;
-            }
+        // One attempt per pass; a failure schedules a single early retry
+        // (see nextRetryDelayMs) instead of sleeping on the caller's thread.
+        const bool retryPass = statusRetryDueMs_.contains(key);
+        Telemetry::instance().recordRequest();
+        const CommandResult result = CommandRunner::run("ssh", args, timeoutMs);
+        if (result.success()) {
+            onCircuitSuccess(key);
+            statusRetryDueMs_.remove(key);
+        } else {
             onCircuitFailure(key);
-            Telemetry::instance().incrementCounter("fleet.status.retry_count");
-            const int jitter = static_cast<int>(QRandomGenerator::global()->bounded(200));
-            QThread::msleep(static_cast<unsigned long>(150 + jitter));
+            if (retryPass) {
+                statusRetryDueMs_.remove(key);
+            } else {
+                const int jitter = static_cast<int>(QRandomGenerator::global()->bounded(200));
+                statusRetryDueMs_.insert(key, QDateTime::currentMSecsSinceEpoch() + 150 + jitter);
+                Telemetry::instance().incrementCounter("fleet.status.retry_count");
+                robot.insert("retry_scheduled", true);
+            }
         }
 
         robot.insert("reachable", result.success());
@@ -212,6 +234,7 @@ QJsonObject RemoteMonitor::collectFleetStatus(int timeoutMs) const {
         } else {
             robot.insert("error", result.stderrText.trimmed());
         }
+        lastRobotStatus_.insert(target.name, robot);
         robots.append(robot);
     }
 
@@ -280,43 +303,40 @@ QJsonObject RemoteMonitor::executeRemoteActionInternal(
             "bash", "-lc", remoteScript,
         };
 
-        CommandResult result;
-        int retriesUsed = 0;
-        for (int attempt = 0; attempt < maxRetries_; ++attempt) {
-            Telemetry::instance().recordRequest();
-            result = CommandRunner::run("ssh", args, timeoutMs);
-            if (result.success()) {
-                onCircuitSuccess(circuitKey);
-                break;
-            }
-            retriesUsed = attempt + 1;
+        // Single attempt; retries are deferred through the queue with an
+        // exponential backoff deadline rather than slept out here.
+        Telemetry::instance().recordRequest();
+        const CommandResult result = CommandRunner::run("ssh", args, timeoutMs);
+        if (result.success()) {
+            onCircuitSuccess(circuitKey);
+        } else {
             onCircuitFailure(circuitKey);
-            Telemetry::instance().incrementCounter("fleet.action.retry_count");
-            const int base = 250 * (1 << attempt);
-            const int jitter = static_cast<int>(QRandomGenerator::global()->bounded(350));
-            const int sleepMs = qMin(9000, base + jitter);
-            QThread::msleep(static_cast<unsigned long>(sleepMs));
         }
 
+        QJsonObject response = {
+            {"success", result.success()},
+            {"target", targetName},
+            {"action", action},
+            {"stderr", result.stderrText.trimmed()},
+        };
         if (!result.success() && allowQueueWrite) {
+            const int retryInMs = retryBackoffMs(0);
             enqueueOfflineAction(
                 {
                     {"target", targetName},
                     {"action", action},
                     {"domain_id", domainId},
                     {"queued_utc", QDateTime::currentDateTimeUtc().toString(Qt::ISODate)},
+                    {"attempts", 1},
+                    {"next_attempt_epoch_ms",
+                     static_cast<double>(QDateTime::currentMSecsSinceEpoch() + retryInMs)},
                 });
             Telemetry::instance().incrementCounter("fleet.action.offline_queued");
+            response.insert("queued_for_retry", true);
+            response.insert("retry_in_ms", retryInMs);
         }
-
-        return {
-            {"success", result.success()},
-            {"target", targetName},
-            {"action", action},
-            {"retry_count", retriesUsed},
-            {"stderr", result.stderrText.trimmed()},
-            {"offline_queue_size", offlineQueue_.size()},
-        };
+        response.insert("offline_queue_size", offlineQueue_.size());
+        return response;
     }
 
     return {
@@ -331,12 +351,12 @@ QJsonObject RemoteMonitor::executeRemoteAction(
     const QString& action,
     const QString& domainId,
     int timeoutMs) {
-    loadQueue();
+    ensureQueueLoaded();
     return executeRemoteActionInternal(targetName, action, domainId, timeoutMs, true);
 }
 
 QJsonObject RemoteMonitor::resumeQueuedActions(int budget, int timeoutMs) {
-    loadQueue();
+    ensureQueueLoaded();
     if (offlineQueue_.isEmpty() || budget <= 0) {
         return {
             {"success", true},
@@ -345,11 +365,16 @@ QJsonObject RemoteMonitor::resumeQueuedActions(int budget, int timeoutMs) {
         };
     }
 
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
     int resumed = 0;
     int failed = 0;
     int idx = 0;
-    while (idx < offlineQueue_.size() && resumed < budget) {
-        const QJsonObject req = offlineQueue_.at(idx).toObject();
+    while (idx < offlineQueue_.size() && resumed + failed < budget) {
+        QJsonObject req = offlineQueue_.at(idx).toObject();
+        if (static_cast<qint64>(req.value("next_attempt_epoch_ms").toDouble(0)) > now) {
+            idx++;
+            continue;
+        }
         const QJsonObject result = executeRemoteActionInternal(
             req.value("target").toString(),
             req.value("action").toString(),
@@ -361,11 +386,20 @@ QJsonObject RemoteMonitor::resumeQueuedActions(int budget, int timeoutMs) {
             resumed++;
             continue;
         }
+        const int attempts = req.value("attempts").toInt(0) + 1;
+        req.insert("attempts", attempts);
+        req.insert(
+            "next_attempt_epoch_ms",
+            static_cast<double>(QDateTime::currentMSecsSinceEpoch() + retryBackoffMs(attempts)));
+        offlineQueue_.replace(idx, req);
+        Telemetry::instance().incrementCounter("fleet.action.retry_count");
         failed++;
         idx++;
     }
 
-    persistQueue();
+    if (resumed + failed > 0) {
+        persistQueue();
+    }
     Telemetry::instance().setQueueSize("offline_remote_actions", offlineQueue_.size());
     return {
         {"success", true},
@@ -375,4 +409,21 @@ QJsonObject RemoteMonitor::resumeQueuedActions(int budget, int timeoutMs) {
     };
 }
 
+qint64 RemoteMonitor::nextRetryDelayMs() const {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    qint64 earliest = -1;
+    auto consider = [&earliest](qint64 dueMs) {
+        if (earliest < 0 || dueMs < earliest) {
+            earliest = dueMs;
+        }
+    };
+    for (auto it = statusRetryDueMs_.constBegin(); it != statusRetryDueMs_.constEnd(); ++it) {
+        consider(it.value());
+    }
+    for (const QJsonValue& value : offlineQueue_) {
+        consider(static_cast<qint64>(value.toObject().value("next_attempt_epoch_ms").toDouble(0)));
+    }
+    return earliest < 0 ? -1 : qMax<qint64>(0, earliest - now);
+}
+
 }  // namespace rrcc
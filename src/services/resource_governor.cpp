@@ -0,0 +1,141 @@
+#include "rrcc/resource_governor.hpp"
+
+#include <QDateTime>
+#include <QMutexLocker>
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+// Samples in a row before the level moves; recovery is slower than
+// degradation so the governor does not oscillate around a budget.
+constexpr int kSamplesToDegrade = 2;
+constexpr int kSamplesToRecover = 3;
+// Usage must fall this far below the budget before a level is restored.
+constexpr double kCpuRecoverFraction = 0.6;
+constexpr double kRssRecoverFraction = 0.85;
+
+}  // namespace
+
+ResourceGovernor::Policy ResourceGovernor::policyFor(Level level) {
+    Policy policy;
+    if (level >= Level::ReducedScan) {
+        policy.processBudget = 300;
+    }
+    if (level >= Level::SlowCollectors) {
+        policy.freshnessScale = 2.0;
+    }
+    if (level >= Level::ShrinkCaches) {
+        policy.heavyCacheEntries = 64;
+        policy.sessionSamples = 300;
+        policy.parameterCacheEntries = 100;
+    }
+    if (level >= Level::Minimal) {
+        policy.processBudget = 150;
+        policy.freshnessScale = 4.0;
+        policy.deepSampling = false;
+    }
+    return policy;
+}
+
+QString ResourceGovernor::levelName(Level level) {
+    switch (level) {
+    case Level::Normal:
+        return "normal";
+    case Level::ReducedScan:
+        return "reduced_scan";
+    case Level::SlowCollectors:
+        return "slow_collectors";
+    case Level::ShrinkCaches:
+        return "shrink_caches";
+    case Level::Minimal:
+        return "minimal";
+    }
+    return "normal";
+}
+
+void ResourceGovernor::setBudgets(const Budgets& budgets) {
+    QMutexLocker lock(&mutex_);
+    budgets_.cpuPercent = qMax(1.0, budgets.cpuPercent);
+    budgets_.rssKb = qMax<qint64>(64 * 1024, budgets.rssKb);
+    overSamples_ = 0;
+    underSamples_ = 0;
+}
+
+ResourceGovernor::Budgets ResourceGovernor::budgets() const {
+    QMutexLocker lock(&mutex_);
+    return budgets_;
+}
+
+bool ResourceGovernor::sample() {
+    QMutexLocker lock(&mutex_);
+    const double cpuPercent = usage_.sampleCpuPercent();
+    rssKb_ = SelfUsage::rssKb();
+    Telemetry::instance().setGauge("governor.rss_kb", static_cast<double>(rssKb_));
+    if (cpuPercent < 0.0) {
+        return false;
+    }
+    cpuPercent_ = cpuPercent;
+    Telemetry::instance().setGauge("governor.cpu_percent", cpuPercent_);
+
+    const bool over = cpuPercent_ > budgets_.cpuPercent || rssKb_ > budgets_.rssKb;
+    const bool under = cpuPercent_ < budgets_.cpuPercent * kCpuRecoverFraction
+        && rssKb_ < static_cast<qint64>(budgets_.rssKb * kRssRecoverFraction);
+    overSamples_ = over ? overSamples_ + 1 : 0;
+    underSamples_ = under ? underSamples_ + 1 : 0;
+
+    const Level previous = level_;
+    if (overSamples_ >= kSamplesToDegrade && level_ < Level::Minimal) {
+        level_ = static_cast<Level>(static_cast<int>(level_) + 1);
+    } else if (underSamples_ >= kSamplesToRecover && level_ > Level::Normal) {
+        level_ = static_cast<Level>(static_cast<int>(level_) - 1);
+    }
+    if (level_ == previous) {
+        return false;
+    }
+    overSamples_ = 0;
+    underSamples_ = 0;
+    changedEpochMs_ = QDateTime::currentMSecsSinceEpoch();
+    Telemetry::instance().setGauge("governor.level", static_cast<double>(level_));
+    Telemetry::instance().incrementCounter("governor.level_changes");
+    Telemetry::instance().recordEvent(
+        "governor_level",
+        {
+            {"from", levelName(previous)},
+            {"to", levelName(level_)},
+            {"cpu_percent", cpuPercent_},
+            {"rss_kb", static_cast<double>(rssKb_)},
+        });
+    return true;
+}
+
+ResourceGovernor::Level ResourceGovernor::level() const {
+    QMutexLocker lock(&mutex_);
+    return level_;
+}
+
+ResourceGovernor::Policy ResourceGovernor::policy() const {
+    return policyFor(level());
+}
+
+QJsonObject ResourceGovernor::status() const {
+    QMutexLocker lock(&mutex_);
+    const Policy policy = policyFor(level_);
+    return {
+        {"level", static_cast<int>(level_)},
+        {"level_name", levelName(level_)},
+        {"cpu_percent", cpuPercent_},
+        {"rss_kb", static_cast<double>(rssKb_)},
+        {"cpu_budget_percent", budgets_.cpuPercent},
+        {"rss_budget_kb", static_cast<double>(budgets_.rssKb)},
+        {"source", usage_.source()},
+        {"changed_epoch_ms", static_cast<double>(changedEpochMs_)},
+        {"process_budget", policy.processBudget},
+        {"freshness_scale", policy.freshnessScale},
+        {"deep_sampling", policy.deepSampling},
+    };
+}
+
+}  // namespace rrcc
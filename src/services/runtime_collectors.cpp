@@ -0,0 +1,385 @@
+#include "rrcc/runtime_collectors.hpp"
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QMutexLocker>
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+// Topic rates are sampled in depth only while diagnostics are on screen.
+constexpr int kDeepSamplingFreshnessMs = 3000;
+
+QJsonObject ran() {
+    return {{"success", true}};
+}
+
+QJsonObject skipped() {
+    return {{"success", true}, {"skipped", true}};
+}
+
+}  // namespace
+
+ProcessCollector::ProcessCollector(ProcessManager* processManager, const RosInspector* rosInspector)
+    : processManager_(processManager),
+      rosInspector_(rosInspector) {}
+
+Collector::Traits ProcessCollector::traits() const {
+    Traits traits;
+    traits.lane = "process";
+    traits.laneIntervalMs = 1000;
+    traits.privateOutputs = {"processes_all"};
+    return traits;
+}
+
+void ProcessCollector::invalidate(const QList<qint64>& pids) {
+    QMutexLocker lock(&invalidationMutex_);
+    invalidatedPids_.append(pids);
+}
+
+QJsonObject ProcessCollector::collect(CollectorContext& context) {
+    QList<qint64> invalidated;
+    {
+        QMutexLocker lock(&invalidationMutex_);
+        invalidated.swap(invalidatedPids_);
+    }
+    if (!invalidated.isEmpty()) {
+        processManager_->invalidate(invalidated);
+    }
+    // Everything built on processes_all (the ROS probes, diagnostics, the
+    // watchdog) keeps this collector running.
+    if (invalidated.isEmpty()) {
+        const int freshnessMs = context.demandMs(QStringList{"processes_all", "domain_summaries"});
+        if (freshnessMs < 0 || !context.due("processes_all", freshnessMs, context.pinned("processes_all"))) {
+            return skipped();
+        }
+    }
+    const CollectorScheduler::Run cost = context.measure("processes_all");
+
+    const ResourceGovernor::Policy policy = context.policy();
+    processManager_->setLimits(policy.processBudget, policy.heavyCacheEntries);
+    const bool deepRosInspection = context.processScope().toLower() != "all processes";
+    const QJsonArray processes = processManager_->listProcesses(false, "", deepRosInspection);
+    const bool firstPass = !context.contains("processes_all");
+    context.publish("processes_all", processes);
+    context.publish("domain_summaries", rosInspector_->listDomains(processes));
+    if (firstPass) {
+        // The ROS collector has been waiting for this list.
+        context.wake("ros");
+    }
+    return ran();
+}
+
+SystemCollector::SystemCollector(SystemMonitor* systemMonitor)
+    : systemMonitor_(systemMonitor) {}
+
+Collector::Traits SystemCollector::traits() const {
+    Traits traits;
+    traits.lane = "system";
+    traits.laneIntervalMs = 1000;
+    traits.spawnsProcesses = true;
+    return traits;
+}
+
+QJsonObject SystemCollector::collect(CollectorContext& context) {
+    bool collected = false;
+    const int systemFreshnessMs = context.demandMs("system");
+    if (systemFreshnessMs >= 0 && context.due("system", systemFreshnessMs, context.pinned("system"))) {
+        const CollectorScheduler::Run cost = context.measure("system");
+        QJsonObject system = systemMonitor_->collectCore();
+        if (!context.contains("system")) {
+            // First pass: show /proc data before the device tools return.
+            context.publish("system", system);
+        }
+        systemMonitor_->addDeviceProbes(&system);
+        context.publish("system", system);
+        collected = true;
+    }
+
+    const int logsFreshnessMs = context.demandMs("logs");
+    if (logsFreshnessMs >= 0 && (context.due("logs", logsFreshnessMs) || !context.contains("logs"))) {
+        const CollectorScheduler::Run cost = context.measure("logs");
+        // Reads only records added since the last poll; republishing an
+        // unchanged ring would only cost a hash. Consumers cut the ring by
+        // the last seq they have shown.
+        if (kernelLog_.poll() > 0 || !context.contains("logs")) {
+            context.publish("logs", kernelLog_.toJson());
+        }
+        collected = true;
+    }
+    return collected ? ran() : skipped();
+}
+
+Collector::Traits CanCollector::traits() const {
+    Traits traits;
+    traits.lane = "can";
+    traits.laneIntervalMs = kLaneIntervalMs;
+    traits.minFreshnessMs = kLaneIntervalMs;
+    return traits;
+}
+
+QJsonObject CanCollector::collect(CollectorContext& context) {
+    const int freshnessMs = context.demandMs("can");
+    if (freshnessMs < 0 || !context.due("can", freshnessMs, context.pinned("can"))) {
+        return skipped();
+    }
+    const CollectorScheduler::Run cost = context.measure("can");
+    QJsonArray interfaces;
+    QJsonObject can;
+    if (!canMonitor_.sample(&interfaces)) {
+        can.insert("error", canMonitor_.error());
+    }
+    can.insert("interfaces", interfaces);
+    context.publish("can", can);
+    return ran();
+}
+
+Collector::Traits ThermalCollector::traits() const {
+    Traits traits;
+    // Its own lane: the system lane can sit in nvidia-smi for seconds.
+    traits.lane = "thermal";
+    traits.laneIntervalMs = 1000;
+    return traits;
+}
+
+QJsonObject ThermalCollector::collect(CollectorContext& context) {
+    const int freshnessMs = context.demandMs("thermal");
+    if (freshnessMs < 0 || !context.due("thermal", freshnessMs, context.pinned("thermal"))) {
+        return skipped();
+    }
+    const CollectorScheduler::Run cost = context.measure("thermal");
+    context.publish("thermal", thermalMonitor_.sample());
+    return ran();
+}
+
+RosCollector::RosCollector(RosInspector* rosInspector)
+    : rosInspector_(rosInspector) {}
+
+Collector::Traits RosCollector::traits() const {
+    Traits traits;
+    traits.lane = "ros";
+    traits.laneIntervalMs = 1500;
+    traits.spawnsProcesses = true;
+    traits.inputs = {"processes_all", "domain_summaries"};
+    // The selected domain's slice of "domains", refreshed on its own.
+    traits.privateOutputs = {"domain_detail"};
+    return traits;
+}
+
+QJsonObject RosCollector::collect(CollectorContext& context) {
+    const int domainsFreshnessMs = context.demandMs("domains");
+    const int detailFreshnessMs = context.demandMs("domain_detail");
+    const int graphFreshnessMs = context.demandMs("graph");
+    const int tfFreshnessMs = context.demandMs("tf_nav2");
+    if (domainsFreshnessMs < 0 && detailFreshnessMs < 0 && graphFreshnessMs < 0 && tfFreshnessMs < 0) {
+        return skipped();
+    }
+    if (!context.contains("processes_all")) {
+        // Startup: probing now would inspect no domains. Run the ros2 check
+        // (a login-shell spawn) meanwhile; the process collector wakes us.
+        rosInspector_->isRos2Available();
+        Telemetry::instance().incrementCounter("collector.ros.waiting_for_processes");
+        return skipped();
+    }
+    const QJsonArray processes = context.value("processes_all").toArray();
+    const QJsonArray domainSummaries = context.value("domain_summaries").toArray();
+    const QJsonArray previousDetails = context.value("domains").toArray();
+    const QString selectedDomain = context.selectedDomain();
+
+    QStringList knownDomains;
+    for (const QJsonValue& value : domainSummaries) {
+        knownDomains.append(value.toObject().value("domain_id").toString("0"));
+    }
+    const bool refreshAllDomainDetails =
+        context.due("domains", domainsFreshnessMs, context.pinned("domains")) || previousDetails.isEmpty();
+    const bool refreshSelectedDomainDetail = context.due("domain_detail", detailFreshnessMs);
+
+    QHash<QString, QJsonObject> detailByDomain;
+    for (const QJsonValue& value : previousDetails) {
+        const QJsonObject detail = value.toObject();
+        detailByDomain.insert(detail.value("domain_id").toString("0"), detail);
+    }
+    if (refreshAllDomainDetails) {
+        const CollectorScheduler::Run cost = context.measure("domains");
+        detailByDomain.clear();
+        for (const QString& domainId : knownDomains) {
+            if (context.cancelled()) {
+                return skipped();
+            }
+            detailByDomain.insert(domainId, rosInspector_->inspectDomain(domainId, processes, false));
+        }
+    } else if (refreshSelectedDomainDetail) {
+        const CollectorScheduler::Run cost = context.measure("domain_detail");
+        detailByDomain.insert(
+            selectedDomain, rosInspector_->inspectDomain(selectedDomain, processes, false));
+    }
+
+    QJsonArray domainDetails;
+    for (const QJsonValue& summaryValue : domainSummaries) {
+        const QJsonObject summary = summaryValue.toObject();
+        const QString domainId = summary.value("domain_id").toString("0");
+
+        QJsonObject detail = detailByDomain.value(domainId);
+        if (detail.isEmpty()) {
+            detail.insert("domain_id", domainId);
+            detail.insert("nodes", QJsonArray{});
+        }
+
+        detail.insert("ros_process_count", summary.value("ros_process_count"));
+        detail.insert("domain_cpu_percent", summary.value("domain_cpu_percent"));
+        detail.insert("domain_memory_percent", summary.value("domain_memory_percent"));
+        detail.insert("workspace_count", summary.value("workspace_count"));
+        domainDetails.append(detail);
+    }
+    context.publish("domains", domainDetails);
+
+    // Heavy ROS graph probes only run as often as some view needs them.
+    if (context.cancelled()) {
+        return skipped();
+    }
+    QString error;
+    const QJsonObject graph = context.value("graph").toObject();
+    if (graphFreshnessMs >= 0
+        && (context.due("graph", graphFreshnessMs, context.pinned("graph")) || graph.isEmpty()
+            || graph.value("domain_id").toString() != selectedDomain)) {
+        const CollectorScheduler::Run cost = context.measure("graph");
+        const QJsonObject next = rosInspector_->inspectGraph(selectedDomain, processes);
+        error = next.value("error").toString();
+        context.publish("graph", next);
+    }
+    const QJsonObject tfNav2 = context.value("tf_nav2").toObject();
+    if (tfFreshnessMs >= 0 && !context.cancelled()
+        && (context.due("tf_nav2", tfFreshnessMs, context.pinned("tf_nav2")) || tfNav2.isEmpty()
+            || tfNav2.value("domain_id").toString() != selectedDomain)) {
+        const CollectorScheduler::Run cost = context.measure("tf_nav2");
+        const QJsonObject next = rosInspector_->inspectTfNav2(selectedDomain);
+        if (error.isEmpty()) {
+            error = next.value("error").toString();
+        }
+        context.publish("tf_nav2", next);
+    }
+    // The sections carry the error for the UI; this feeds the telemetry.
+    if (!error.isEmpty()) {
+        return {{"success", false}, {"error", error}};
+    }
+    return ran();
+}
+
+DiagnosticsCollector::DiagnosticsCollector(HealthMonitor* healthMonitor, DiagnosticsEngine* diagnosticsEngine)
+    : healthMonitor_(healthMonitor),
+      diagnosticsEngine_(diagnosticsEngine) {}
+
+Collector::Traits DiagnosticsCollector::traits() const {
+    Traits traits;
+    // After the ROS collector on the same lane, so it judges fresh probes.
+    traits.lane = "ros";
+    traits.laneIntervalMs = 1500;
+    // Deep topic sampling runs ros2.
+    traits.spawnsProcesses = true;
+    traits.inputs = {"processes_all", "domains", "graph", "tf_nav2", "system", "thermal", "node_parameters"};
+    return traits;
+}
+
+void DiagnosticsCollector::setExpectedProfile(const QJsonObject& profile) {
+    QMutexLocker lock(&profileMutex_);
+    pendingProfile_ = profile;
+    profileDirty_ = true;
+}
+
+QJsonObject DiagnosticsCollector::collect(CollectorContext& context) {
+    // The full evaluation (topic rates, ros2 spawns) runs only for a view of
+    // "advanced" or an enabled watchdog; health alone is a pass over the
+    // latest probes.
+    const int viewMs = context.freshness("advanced");
+    int advancedMs = viewMs;
+    const bool pinned = context.pinned("advanced");
+    if (pinned) {
+        const int watchdogMs = context.demandMs("advanced");
+        advancedMs = advancedMs < 0 ? watchdogMs : qMin(advancedMs, watchdogMs);
+    }
+    const bool advancedDue =
+        advancedMs >= 0 && context.contains("processes_all") && context.due("advanced", advancedMs, pinned);
+    if (!advancedDue) {
+        const int healthMs = context.demandMs("health");
+        if (healthMs < 0 || !context.due("health", healthMs)) {
+            return skipped();
+        }
+        const CollectorScheduler::Run cost = context.measure("health");
+        context.publish("health",
+                        healthMonitor_->evaluate(context.value("domains").toArray(),
+                                                 context.value("graph").toObject(),
+                                                 context.value("tf_nav2").toObject()));
+        // Not a diagnostics pass: the watchdog section is left alone.
+        return {{"success", true}, {"health_only", true}};
+    }
+    const CollectorScheduler::Run cost = context.measure("advanced");
+
+    const QJsonArray domains = context.value("domains").toArray();
+    const QJsonObject graph = context.value("graph").toObject();
+    const QJsonObject tfNav2 = context.value("tf_nav2").toObject();
+    const QJsonObject health = healthMonitor_->evaluate(domains, graph, tfNav2);
+    context.publish("health", health);
+
+    {
+        QMutexLocker lock(&profileMutex_);
+        if (profileDirty_) {
+            diagnosticsEngine_->setExpectedProfile(pendingProfile_);
+            profileDirty_ = false;
+        }
+    }
+    const bool deepSampling = viewMs >= 0 && viewMs <= kDeepSamplingFreshnessMs && context.policy().deepSampling;
+    context.publish(
+        "advanced",
+        diagnosticsEngine_->evaluate(
+            context.selectedDomain(),
+            context.value("processes_all").toArray(),
+            domains,
+            graph,
+            tfNav2,
+            context.value("system").toObject(),
+            context.value("thermal").toObject(),
+            health,
+            context.value("node_parameters").toObject(),
+            deepSampling,
+            2000));
+    return ran();
+}
+
+FleetCollector::FleetCollector(RemoteMonitor* remoteMonitor, QMutex* fleetMutex)
+    : remoteMonitor_(remoteMonitor),
+      fleetMutex_(fleetMutex) {}
+
+Collector::Traits FleetCollector::traits() const {
+    Traits traits;
+    traits.lane = "fleet";
+    traits.laneIntervalMs = kSweepIntervalMs;
+    traits.spawnsProcesses = true;
+    return traits;
+}
+
+QJsonObject FleetCollector::collect(CollectorContext& context) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    // Early wake-ups only serve due retries; the full sweep keeps its cadence.
+    const int freshnessMs = context.demandMs("fleet");
+    const bool fullSweep = sweepRequested_.exchange(false) || now >= nextSweepEpochMs_;
+    if (fullSweep) {
+        nextSweepEpochMs_ = now + qMax(kSweepIntervalMs, freshnessMs) - 250;
+    }
+    QMutexLocker lock(fleetMutex_);
+    if (freshnessMs >= 0) {
+        context.publish("fleet", remoteMonitor_->collectFleetStatus(4500, !fullSweep));
+    }
+    // Queued remote actions are delivered whether or not anyone is watching.
+    remoteMonitor_->resumeQueuedActions(2, 4500);
+    const qint64 retryDelayMs = remoteMonitor_->nextRetryDelayMs();
+    if (retryDelayMs >= 0) {
+        context.wake(name(), static_cast<int>(qBound<qint64>(250, retryDelayMs, kSweepIntervalMs)));
+    }
+    return freshnessMs >= 0 ? ran() : skipped();
+}
+
+}  // namespace rrcc
@@ -7,38 +7,185 @@
 #include <QJsonDocument>
 #include <QJsonValue>
 #include <QFile>
-#include <QCryptographicHash>
-#include <QMap>
+#include <QMetaMethod>
+#include <QMetaObject>
+#include <QMutexLocker>
 #include <QStringList>
-#include <QThread>
+#include <QTimer>
 
-#include "rrcc/command_runner.hpp"
+#include <utility>
+
+#include "rrcc/json_hash.hpp"
 #include "rrcc/telemetry.hpp"
 
 namespace rrcc {
 
 namespace {
 
-QString compactHash(const QJsonValue& value) {
-    const QByteArray payload = QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact);
-    return QString::fromLatin1(QCryptographicHash::hash(payload, QCryptographicHash::Sha1).toHex());
-}
+// Snapshot sections the worker assembles itself; collectors add theirs.
+// Every snapshot section is only sent to the UI when it changed since the
+// client's since_version.
+const QStringList kWorkerSections = {
+    "node_parameters",
+    "session",
+    "watchdog",
+    "governor",
+};
 
-QString compactHashArray(const QJsonArray& value) {
-    const QByteArray payload = QJsonDocument(value).toJson(QJsonDocument::Compact);
-    return QString::fromLatin1(QCryptographicHash::hash(payload, QCryptographicHash::Sha1).toHex());
-}
+// Freshness used when a request declares no interests (daemon clients, the
+// CLI); roughly what the UI gets with every view open.
+const QHash<QString, int> kDefaultFreshnessMs = {
+    {"processes_visible", 1000},
+    {"domain_summaries", 1000},
+    {"domains", 6000},
+    {"graph", 6000},
+    {"tf_nav2", 7500},
+    {"system", 1000},
+    {"can", 1000},
+    {"thermal", 1000},
+    {"logs", 4000},
+    {"health", 1500},
+    {"advanced", 4500},
+    {"fleet", 6000},
+    {"watchdog", 1500},
+};
+
+// ROS inventory restored from the previous run until collectors refresh it.
+// Derived judgments (health, advanced) are never restored.
+const QStringList kWarmStartSections = {
+    "domain_summaries",
+    "domains",
+    "graph",
+    "tf_nav2",
+};
+// Parameter hashes kept for change detection across runs.
+constexpr int kMaxParameterHashes = 2000;
 
-QString compactHashText(const QString& value) {
-    return QString::fromLatin1(
-        QCryptographicHash::hash(value.toUtf8(), QCryptographicHash::Sha1).toHex());
+// The watchdog keeps its inputs this fresh even when nobody is watching.
+constexpr int kWatchdogFreshnessMs = 1500;
+// A mailbox consumer that leaves a snapshot waiting longer than this, or
+// lets the next one land on top of it, is behind; polls space out up to
+// kMaxConsumerBackoffMs until it catches up.
+constexpr int kConsumerLagMs = 500;
+constexpr int kMaxConsumerBackoffMs = 5000;
+// Lanes tick on fixed intervals; without slack a 1000 ms freshness on a
+// 1000 ms lane would be missed every other run.
+constexpr int kFreshnessSlackMs = 250;
+
+// The tighter of two freshness requirements; -1 means not needed.
+int fresher(int a, int b) {
+    if (a < 0) {
+        return b;
+    }
+    return b < 0 ? a : qMin(a, b);
 }
 
 }  // namespace
 
+// One collector run's view of the worker, over the view state at its start.
+class RuntimeWorker::LaneContext final : public CollectorContext {
+public:
+    LaneContext(RuntimeWorker* worker, PollConfig config)
+        : worker_(worker),
+          config_(std::move(config)),
+          watchdogEnabled_(worker->watchdogEnabled_.load()) {}
+
+    using CollectorContext::demandMs;
+
+    int freshness(const QString& section) const override { return config_.freshness(section); }
+    int demandMs(const QString& section) const override {
+        int demand = -1;
+        const QStringList consumers = worker_->collectorRegistry_.consumersOf(section);
+        for (const QString& consumer : consumers) {
+            demand = fresher(demand, config_.freshness(consumer));
+        }
+        if (watchdogEnabled_ && consumers.contains("watchdog")) {
+            demand = fresher(demand, kWatchdogFreshnessMs);
+        }
+        return demand;
+    }
+    bool pinned(const QString& section) const override {
+        return watchdogEnabled_ && worker_->collectorRegistry_.consumersOf(section).contains("watchdog");
+    }
+    bool due(const QString& key, int freshnessMs, bool pinned) override {
+        return worker_->refreshDue(key, freshnessMs, pinned);
+    }
+    CollectorScheduler::Run measure(const QString& key) override { return worker_->scheduler_.measure(key); }
+
+    void publish(const QString& section, const QJsonValue& value) override {
+        worker_->sectionStore_.publish(section, value);
+    }
+    QJsonValue value(const QString& section) const override { return worker_->sectionStore_.value(section); }
+    bool contains(const QString& section) const override { return worker_->sectionStore_.contains(section); }
+
+    QString selectedDomain() const override {
+        // The view's choice while that domain exists, else the first one.
+        QStringList knownDomains;
+        for (const QJsonValue& value : worker_->sectionStore_.value("domain_summaries").toArray()) {
+            knownDomains.append(value.toObject().value("domain_id").toString("0"));
+        }
+        if (config_.selectedDomain.isEmpty() || !knownDomains.contains(config_.selectedDomain)) {
+            return knownDomains.isEmpty() ? "0" : knownDomains.first();
+        }
+        return config_.selectedDomain;
+    }
+    QString processScope() const override { return config_.processScope; }
+    ResourceGovernor::Policy policy() const override { return worker_->governor_.policy(); }
+    void wake(const QString& collector, int delayMs) override { worker_->wakeCollector(collector, delayMs); }
+    bool cancelled() const override { return worker_->stopping_.load(); }
+
+private:
+    RuntimeWorker* worker_;
+    const PollConfig config_;
+    const bool watchdogEnabled_;
+};
+
 RuntimeWorker::RuntimeWorker(QObject* parent)
-    : QObject(parent),
-      actions_(&processManager_) {
+    : QObject(parent) {
+    // Child timers, so they follow the worker onto its thread.
+    pollTimer_ = new QTimer(this);
+    pollTimer_->setSingleShot(true);
+    connect(pollTimer_, &QTimer::timeout, this, &RuntimeWorker::runScheduledPoll);
+    watchdogTimer_ = new QTimer(this);
+    watchdogTimer_->setSingleShot(true);
+    connect(watchdogTimer_, &QTimer::timeout, this, [this]() {
+        dispatchWatchdog(watchdogEngine_.tick(QDateTime::currentMSecsSinceEpoch()));
+        armWatchdogTimer();
+    });
+    governorTimer_ = new QTimer(this);
+    governorTimer_->setInterval(kGovernorSampleIntervalMs);
+    connect(governorTimer_, &QTimer::timeout, this, &RuntimeWorker::sampleGovernor);
+    // Watchdog rules see every change as it is published, from any lane.
+    sectionStore_.setPublishListener([this](const QString& name, const SectionStore::SectionPtr& section) {
+        handleSectionPublished(name, section);
+    });
+
+    // Registration order is run order within a lane: diagnostics follow the
+    // ROS probes they judge.
+    auto processCollector = std::make_unique<ProcessCollector>(&processManager_, &rosInspector_);
+    processCollector_ = processCollector.get();
+    collectorRegistry_.add(std::move(processCollector));
+    collectorRegistry_.add(std::make_unique<SystemCollector>(&systemMonitor_));
+    collectorRegistry_.add(std::make_unique<CanCollector>());
+    collectorRegistry_.add(std::make_unique<ThermalCollector>());
+    collectorRegistry_.add(std::make_unique<RosCollector>(&rosInspector_));
+    auto diagnosticsCollector = std::make_unique<DiagnosticsCollector>(&healthMonitor_, &diagnosticsEngine_);
+    diagnosticsCollector_ = diagnosticsCollector.get();
+    collectorRegistry_.add(std::move(diagnosticsCollector));
+    auto fleetCollector = std::make_unique<FleetCollector>(&remoteMonitor_, &fleetMutex_);
+    fleetCollector_ = fleetCollector.get();
+    collectorRegistry_.add(std::move(fleetCollector));
+    collectorRegistry_.addDerived("processes_visible", {"processes_all"});
+    collectorRegistry_.addDerived("watchdog", {"processes_all", "system", "advanced"});
+    collectorRegistry_.setRunListener([this](const QString& name, const QJsonObject& result) {
+        // Rule status and soft-boundary counts follow each diagnostics pass.
+        if (name == "diagnostics" && result.value("success").toBool(false)
+            && !result.value("skipped").toBool(false) && !result.value("health_only").toBool(false)) {
+            publishWatchdogSection();
+        }
+    });
+    deltaSections_ = QStringList{"processes_visible"} + collectorRegistry_.snapshotSections() + kWorkerSections;
+
     const QString defaultPresetPath = QDir(QDir::currentPath()).filePath("presets/default.json");
     if (QFile::exists(defaultPresetPath)) {
         loadRuntimePreset("default");
@@ -47,6 +194,274 @@ RuntimeWorker::RuntimeWorker(QObject* parent)
     if (QFile::exists(fleetPath)) {
         remoteMonitor_.loadTargetsFromFile(fleetPath);
     }
+
+    actionExecutor_ = std::make_unique<ActionExecutor>(&sectionStore_);
+    actionExecutor_->setInvalidationHandler([this](const QJsonArray& pids) {
+        invalidateProcesses(pids);
+    });
+    actionExecutor_->start();
+}
+
+RuntimeWorker::~RuntimeWorker() {
+    actionExecutor_->stop();
+    // Collectors stop before their next probe; one already running ends
+    // within its CommandRunner timeout.
+    stopping_ = true;
+    for (const auto& lane : lanes_) {
+        lane->requestStop();
+    }
+    if (!lanes_.empty() && warmStartEnabled_) {
+        // The process lane owns the classifications saved here and never
+        // spawns, so it joins quickly; the ROS lanes may still be in a probe.
+        if (CollectorLane* processLane = lanesByName_.value(processCollector_->traits().lane, nullptr)) {
+            processLane->stop();
+        }
+        saveWarmStart();
+    }
+    // Join the lanes before the services they reference are destroyed.
+    for (const auto& lane : lanes_) {
+        lane->stop();
+    }
+    lanes_.clear();
+}
+
+QJsonObject RuntimeWorker::defaultInterests() {
+    QJsonObject interests;
+    for (auto it = kDefaultFreshnessMs.constBegin(); it != kDefaultFreshnessMs.constEnd(); ++it) {
+        interests.insert(it.key(), it.value());
+    }
+    return interests;
+}
+
+void RuntimeWorker::ensureCollectorLanes() {
+    if (!lanes_.empty()) {
+        return;
+    }
+    if (warmStartEnabled_) {
+        loadWarmStart();
+    }
+    // Lanes are created on the worker thread so they can be moved to their own.
+    for (const QString& name : collectorRegistry_.lanes()) {
+        const QList<Collector*> collectors = collectorRegistry_.collectorsOn(name);
+        lanes_.push_back(std::make_unique<CollectorLane>(
+            name, collectorRegistry_.laneIntervalMs(name), [this, collectors]() {
+                LaneContext context(this, pollConfig());
+                for (Collector* collector : collectors) {
+                    if (stopping_.load()) {
+                        break;
+                    }
+                    collectorRegistry_.run(collector, context);
+                }
+            }));
+        lanesByName_.insert(name, lanes_.back().get());
+    }
+    for (const auto& lane : lanes_) {
+        lane->start();
+    }
+    sectionStore_.publish("governor", governor_.status());
+    governorTimer_->start();
+}
+
+void RuntimeWorker::updatePollConfig(const QJsonObject& request) {
+    PollConfig next;
+    next.processScope = request.value("process_scope").toString("ROS Only");
+    next.processQuery = request.value("process_query").toString();
+    next.selectedDomain = request.value("selected_domain").toString("0");
+    if (request.contains("interests")) {
+        const QJsonObject interests = request.value("interests").toObject();
+        for (auto it = interests.constBegin(); it != interests.constEnd(); ++it) {
+            const int freshnessMs = it.value().toInt(kDefaultFreshnessMs.value(it.key(), 2000));
+            next.freshnessMs.insert(it.key(), qMax(collectorRegistry_.minFreshnessMs(it.key()), freshnessMs));
+        }
+    } else {
+        next.freshnessMs = kDefaultFreshnessMs;
+    }
+
+    PollConfig previous;
+    {
+        QMutexLocker lock(&configMutex_);
+        previous = config_;
+        next.interest = previous.interest;
+        config_ = next;
+    }
+    // Snapshots go out no faster than minPollIntervalMs_ unless a wanted
+    // section is meant to be fresher than that (can at 100 ms).
+    const int tightestMs = next.freshness(next.freshnessMs.keys());
+    pollSpacingMs_ = tightestMs < 0 ? minPollIntervalMs_ : qMin(minPollIntervalMs_, tightestMs);
+
+    if (lanesByName_.isEmpty()) {
+        return;
+    }
+    // A view that appeared or wants fresher data wakes the collectors its
+    // section comes from instead of waiting a full cycle.
+    QSet<Collector*> wake;
+    auto wakeProducers = [this, &wake](const QString& section) {
+        for (Collector* collector : collectorRegistry_.producersFor(section)) {
+            wake.insert(collector);
+        }
+    };
+    for (auto it = next.freshnessMs.constBegin(); it != next.freshnessMs.constEnd(); ++it) {
+        const int before = previous.freshnessMs.value(it.key(), -1);
+        if (before >= 0 && before <= it.value()) {
+            continue;
+        }
+        {
+            QMutexLocker lock(&freshnessMutex_);
+            refreshedEpochMs_.remove(it.key());
+        }
+        if (it.key() == "fleet") {
+            fleetCollector_->requestSweep();
+        }
+        wakeProducers(it.key());
+    }
+    if (previous.processScope != next.processScope) {
+        wakeProducers("processes_all");
+        wakeProducers("domains");
+    }
+    if (previous.selectedDomain != next.selectedDomain) {
+        wakeProducers("graph");
+    }
+    for (Collector* collector : std::as_const(wake)) {
+        wakeCollector(collector->name());
+    }
+}
+
+RuntimeWorker::PollConfig RuntimeWorker::pollConfig() const {
+    QMutexLocker lock(&configMutex_);
+    PollConfig config = config_;
+    if (recording_.load()) {
+        config.interest = {QString("*")};
+        for (auto it = kDefaultFreshnessMs.constBegin(); it != kDefaultFreshnessMs.constEnd(); ++it) {
+            config.freshnessMs.insert(it.key(), fresher(config.freshnessMs.value(it.key(), -1), it.value()));
+        }
+    }
+    // A degraded governor stretches every view; watchdog inputs keep
+    // kWatchdogFreshnessMs, which the lanes apply separately.
+    const double scale = governor_.policy().freshnessScale;
+    if (scale > 1.0) {
+        for (auto it = config.freshnessMs.begin(); it != config.freshnessMs.end(); ++it) {
+            it.value() = static_cast<int>(it.value() * scale);
+        }
+    }
+    return config;
+}
+
+bool RuntimeWorker::refreshDue(const QString& key, int freshnessMs, bool pinned) {
+    if (freshnessMs < 0) {
+        return false;
+    }
+    const int intervalMs = scheduler_.plannedIntervalMs(key, freshnessMs, pinned);
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QMutexLocker lock(&freshnessMutex_);
+    const qint64 ageMs = now - refreshedEpochMs_.value(key, 0);
+    if (ageMs < intervalMs - kFreshnessSlackMs) {
+        lock.unlock();
+        Telemetry::instance().incrementCounter(
+            "collector." + key
+            + (ageMs < freshnessMs - kFreshnessSlackMs ? ".fresh_skips" : ".budget_deferrals"));
+        return false;
+    }
+    refreshedEpochMs_.insert(key, now);
+    return true;
+}
+
+int RuntimeWorker::suggestedPollIntervalMs(const PollConfig& config) const {
+    // Nothing new can arrive before the soonest scheduled collector runs.
+    int soonest = -1;
+    for (const QString& key : collectorRegistry_.allOutputs()) {
+        const int intervalMs = scheduler_.currentIntervalMs(key);
+        if (intervalMs >= 0 && (soonest < 0 || intervalMs < soonest)) {
+            soonest = intervalMs;
+        }
+    }
+    if (soonest < 0) {
+        soonest = config.freshness(config.freshnessMs.keys());
+    }
+    return qBound(pollSpacingMs_, soonest < 0 ? 1000 : soonest, kMaxIdleBackoffMs);
+}
+
+void RuntimeWorker::setSectionInterest(const QStringList& sections) {
+    QSet<QString> next(sections.begin(), sections.end());
+    QSet<QString> added;
+    {
+        QMutexLocker lock(&configMutex_);
+        if (config_.interest == next) {
+            return;
+        }
+        if (!config_.interest.contains(QString("*"))) {
+            added = next - config_.interest;
+        }
+        config_.interest = next;
+    }
+    Telemetry::instance().setGauge("sections.interest_count", next.contains("*") ? -1 : next.size());
+    if (added.isEmpty()) {
+        return;
+    }
+    // Newly wanted sections may be stale; refresh them now instead of next cycle.
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            for (const auto& lane : lanes_) {
+                lane->requestRun();
+            }
+        },
+        Qt::QueuedConnection);
+}
+
+void RuntimeWorker::invalidateProcesses(const QJsonArray& pids) {
+    QList<qint64> invalidated;
+    for (const QJsonValue& value : pids) {
+        invalidated.append(static_cast<qint64>(value.toDouble(-1)));
+    }
+    processCollector_->invalidate(invalidated);
+    Telemetry::instance().incrementCounter("actions.process_invalidations");
+    // Lanes live on the worker thread; wake the process lane and refresh from there.
+    QMetaObject::invokeMethod(
+        this,
+        [this]() {
+            wakeCollector(processCollector_->name());
+            poll(request_);
+        },
+        Qt::QueuedConnection);
+}
+
+void RuntimeWorker::wakeCollector(const QString& name, int delayMs) {
+    const Collector* collector = collectorRegistry_.find(name);
+    CollectorLane* lane = collector != nullptr ? lanesByName_.value(collector->traits().lane, nullptr) : nullptr;
+    if (lane != nullptr) {
+        lane->requestRun(delayMs);
+    }
+}
+
+void RuntimeWorker::scheduleFleetRetryLocked() {
+    const qint64 retryDelayMs = remoteMonitor_.nextRetryDelayMs();
+    if (retryDelayMs >= 0) {
+        wakeCollector(
+            fleetCollector_->name(),
+            static_cast<int>(qBound<qint64>(250, retryDelayMs, FleetCollector::kSweepIntervalMs)));
+    }
+}
+
+void RuntimeWorker::sampleGovernor() {
+    // Refreshes the collector.<name>.staleness_ms gauges on the same cadence.
+    collectorRegistry_.status();
+    if (governor_.sample()) {
+        applyGovernorPolicy();
+    }
+}
+
+void RuntimeWorker::applyGovernorPolicy() {
+    // Lanes read the policy themselves on their next run; only state owned
+    // by the worker thread is trimmed here.
+    const ResourceGovernor::Policy policy = governor_.policy();
+    sessionRecorder_.setMaxSamples(policy.sessionSamples);
+    maxParameterCacheEntries_ = policy.parameterCacheEntries;
+    if (parameterCacheOrder_.size() > maxParameterCacheEntries_) {
+        pruneParameterCache();
+        publishParameterCache();
+    }
+    // Only level changes are published, so idle polls stay unchanged.
+    sectionStore_.publish("governor", governor_.status());
 }
 
 void RuntimeWorker::pruneParameterCache() {
@@ -56,6 +471,10 @@ void RuntimeWorker::pruneParameterCache() {
     }
 }
 
+void RuntimeWorker::publishParameterCache() {
+    sectionStore_.publish("node_parameters", parameterCache_);
+}
+
 QJsonArray RuntimeWorker::applyProcessFilter(
     const QJsonArray& processes,
     bool rosOnly,
@@ -100,37 +519,28 @@ QJsonArray RuntimeWorker::applyProcessFilter(
 
 QJsonObject RuntimeWorker::buildResponse(
     const QString& selectedDomain,
-    const QJsonArray& allProcesses,
     const QJsonArray& visibleProcesses,
-    const QJsonArray& domainSummaries,
-    const QJsonArray& domainDetails,
-    const QJsonObject& graph,
-    const QJsonObject& tfNav2,
-    const QJsonObject& system,
-    const QString& logs,
-    const QJsonObject& health,
-    const QJsonObject& advanced,
-    const QJsonObject& fleet,
-    const QJsonObject& session,
-    const QJsonObject& watchdog) const {
+    const SectionStore::Sections& sections) const {
     QJsonObject snapshot;
-    Q_UNUSED(allProcesses);
     snapshot.insert("timestamp_utc", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
     snapshot.insert("preset_name", presetName_);
     snapshot.insert("selected_domain", selectedDomain);
     snapshot.insert("processes_visible", visibleProcesses);
-    snapshot.insert("domain_summaries", domainSummaries);
-    snapshot.insert("domains", domainDetails);
-    snapshot.insert("graph", graph);
-    snapshot.insert("tf_nav2", tfNav2);
-    snapshot.insert("system", system);
-    snapshot.insert("logs", logs);
-    snapshot.insert("health", health);
+    for (const QString& section : collectorRegistry_.snapshotSections()) {
+        snapshot.insert(section, sections.value(section).value);
+    }
     snapshot.insert("node_parameters", parameterCache_);
-    snapshot.insert("advanced", advanced);
-    snapshot.insert("fleet", fleet);
-    snapshot.insert("session", session);
-    snapshot.insert("watchdog", watchdog);
+    snapshot.insert("session", sessionRecorder_.status());
+    snapshot.insert("watchdog", sections.value("watchdog").value.toObject());
+    snapshot.insert("governor", sections.value("governor").value.toObject());
+    {
+        QMutexLocker lock(&startupMutex_);
+        QJsonObject warmSections;
+        for (auto it = warmSections_.constBegin(); it != warmSections_.constEnd(); ++it) {
+            warmSections.insert(it.key(), static_cast<double>(it.value()));
+        }
+        snapshot.insert("warm_sections", warmSections);
+    }
     snapshot.insert("sync_version", static_cast<double>(syncVersion_));
     snapshot.insert("process_offset", request_.value("process_offset").toInt(0));
     snapshot.insert("process_limit", request_.value("process_limit").toInt(400));
@@ -139,29 +549,59 @@ QJsonObject RuntimeWorker::buildResponse(
 
 void RuntimeWorker::poll(const QJsonObject& request) {
     const qint64 now = QDateTime::currentMSecsSinceEpoch();
-    if (lastPollEpochMs_ > 0 && (now - lastPollEpochMs_) < minPollIntervalMs_) {
-        const int sleepMs = minPollIntervalMs_ - static_cast<int>(now - lastPollEpochMs_);
-        if (sleepMs > 0) {
-            QThread::msleep(static_cast<unsigned long>(sleepMs));
-        }
+    const qint64 requestedAtMs = request.value("requested_epoch_ms").toInteger(0);
+    if (requestedAtMs > 0) {
+        Telemetry::instance().recordDurationMs(
+            "worker.poll_queue_latency_ms", qMax<qint64>(0, now - requestedAtMs));
     }
+
+    // Latest request wins; a burst collapses into the one already scheduled.
     request_ = request;
-    if (busy_) {
-        pending_ = true;
+    if (pollTimer_->isActive()) {
+        Telemetry::instance().incrementCounter("sync.poll_requests_coalesced");
+        return;
+    }
+    const qint64 delayMs = lastPollEpochMs_ > 0
+        ? qMax<qint64>(0, qMax(pollSpacingMs_, consumerBackoffMs_) - (now - lastPollEpochMs_))
+        : 0;
+    pollDeadlineEpochMs_ = now + delayMs;
+    pollTimer_->start(static_cast<int>(delayMs));
+}
+
+void RuntimeWorker::deliverToMailbox(const QJsonObject& delta) {
+    if (!isSignalConnected(QMetaMethod::fromSignal(&RuntimeWorker::snapshotAvailable))) {
         return;
     }
+    bool behind = true;
+    if (mailbox_.put(delta)) {
+        behind = mailbox_.lastWaitMs() > kConsumerLagMs;
+        emit snapshotAvailable();
+    }
+    if (behind) {
+        consumerBackoffMs_ = qMin(kMaxConsumerBackoffMs, qMax(minPollIntervalMs_, consumerBackoffMs_ * 2));
+    } else {
+        consumerBackoffMs_ = consumerBackoffMs_ / 2 < minPollIntervalMs_ ? 0 : consumerBackoffMs_ / 2;
+    }
+}
+
+void RuntimeWorker::runScheduledPoll() {
+    Telemetry::instance().recordDurationMs(
+        "worker.poll_timer_lateness_ms",
+        qMax<qint64>(0, QDateTime::currentMSecsSinceEpoch() - pollDeadlineEpochMs_));
     pollNow();
 }
 
 void RuntimeWorker::pollNow() {
     QElapsedTimer pollTimer;
     pollTimer.start();
-    busy_ = true;
     pollCounter_++;
     lastPollEpochMs_ = QDateTime::currentMSecsSinceEpoch();
     Telemetry::instance().recordRequest();
     Telemetry::instance().incrementCounter("sync.poll_count");
 
+    updatePollConfig(request_);
+    ensureCollectorLanes();
+
     const bool rosOnly = request_.value("ros_only").toBool(false);
     const QString processQuery = request_.value("process_query").toString();
     const QString processScope = request_.value("process_scope").toString("ROS Only");
@@ -169,250 +609,121 @@ void RuntimeWorker::pollNow() {
     const int processOffset = qMax(0, request_.value("process_offset").toInt(0));
     const int processLimit = qBound(100, request_.value("process_limit").toInt(400), 2000);
     QString selectedDomain = request_.value("selected_domain").toString("0");
-    const int activeTab = request_.value("active_tab").toInt(0);
-    const bool engineerMode = request_.value("engineer_mode").toBool(true);
-    const bool allScopeFastPath =
-        processScope.compare("All Processes", Qt::CaseInsensitive) == 0
-        && activeTab == 0
-        && processQuery.trimmed().isEmpty();
-
-    const bool idleFastPath =
-        consecutiveNoChangePolls_ >= 3
-        && activeTab != 0
-        && activeTab != 1
-        && (pollCounter_ % 2 == 0)
-        && !lastAllProcesses_.isEmpty();
-
-    int filteredTotalCount = 0;
-    if (allScopeFastPath) {
-        const QJsonObject page = processManager_.listProcessesPaged(
-            false, "", false, processOffset, processLimit, false);
-        lastVisibleProcesses_ = page.value("rows").toArray();
-        filteredTotalCount = page.value("total").toInt(lastVisibleProcesses_.size());
-        idleBackoffMs_ = qMax(idleBackoffMs_, 5000);
-        Telemetry::instance().incrementCounter("sync.all_processes_fastpath_hits");
-    } else if (!idleFastPath) {
-        const bool deepRosInspection = processScope.toLower() != "all processes";
-        lastAllProcesses_ = processManager_.listProcesses(false, "", deepRosInspection);
-        lastDomainSummaries_ = rosInspector_.listDomains(lastAllProcesses_);
-    } else {
-        Telemetry::instance().incrementCounter("sync.idle_fastpath_hits");
-    }
 
-    if (!allScopeFastPath) {
-        const QJsonArray filteredProcesses =
-            applyProcessFilter(lastAllProcesses_, rosOnly, processQuery, processScope);
+    // The visible page only depends on the process generation and the
+    // filter, so it is rebuilt (and republished) only when either changes.
+    const SectionStore::Section processSection = sectionStore_.section("processes_all");
+    const QString visiblePageKey = QStringList{
+        QString::number(processSection.version),
+        rosOnly ? "1" : "0",
+        processScope,
+        processQuery,
+        QString::number(processOffset),
+        QString::number(processLimit),
+    }.join(QChar(0x1f));
+    if (visiblePageKey != visiblePageKey_) {
+        const QJsonArray filteredProcesses = applyProcessFilter(
+            processSection.value.toArray(), rosOnly, processQuery, processScope);
         QJsonArray pagedProcesses;
         const int end = qMin(filteredProcesses.size(), processOffset + processLimit);
         for (int i = processOffset; i < end; ++i) {
             pagedProcesses.append(filteredProcesses.at(i));
         }
         lastVisibleProcesses_ = pagedProcesses;
-        filteredTotalCount = filteredProcesses.size();
+        lastFilteredTotalCount_ = filteredProcesses.size();
+        visiblePageKey_ = visiblePageKey;
+        sectionStore_.publish("processes_visible", lastVisibleProcesses_);
+    } else {
+        Telemetry::instance().incrementCounter("sync.visible_page_reused");
     }
+    sectionStore_.publish("session", sessionRecorder_.status());
+
+    // Assemble whatever each lane last published; never wait on a producer.
+    const SectionStore::Sections sections = sectionStore_.sections();
+    const QJsonArray domainSummaries = sections.value("domain_summaries").value.toArray();
 
     QStringList knownDomains;
-    for (const QJsonValue& value : lastDomainSummaries_) {
+    for (const QJsonValue& value : domainSummaries) {
         knownDomains.append(value.toObject().value("domain_id").toString("0"));
     }
-
     if (selectedDomain.isEmpty() || !knownDomains.contains(selectedDomain)) {
         selectedDomain = knownDomains.isEmpty() ? "0" : knownDomains.first();
     }
 
-    const bool skipRosHeavy = allScopeFastPath;
-
-    const bool refreshAllDomainDetails =
-        activeTab == 1 || pollCounter_ % 4 == 0 || lastDomainDetails_.isEmpty();
-    const bool refreshSelectedDomainDetail = activeTab == 2 || activeTab == 3;
-
-    QJsonArray domainDetails;
-    QHash<QString, QJsonObject> detailByDomain;
-    for (const QJsonValue& value : lastDomainDetails_) {
-        const QJsonObject detail = value.toObject();
-        detailByDomain.insert(detail.value("domain_id").toString("0"), detail);
-    }
-
-    if (skipRosHeavy) {
-        domainDetails = lastDomainDetails_;
-    } else if (refreshAllDomainDetails) {
-        detailByDomain.clear();
-        for (const QString& domainId : knownDomains) {
-            detailByDomain.insert(
-                domainId, rosInspector_.inspectDomain(domainId, lastAllProcesses_, false));
-        }
-    } else if (refreshSelectedDomainDetail) {
-        detailByDomain.insert(
-            selectedDomain, rosInspector_.inspectDomain(selectedDomain, lastAllProcesses_, false));
-    }
-
-    if (!skipRosHeavy) {
-        for (const QJsonValue& summaryValue : lastDomainSummaries_) {
-            const QJsonObject summary = summaryValue.toObject();
-            const QString domainId = summary.value("domain_id").toString("0");
-
-            QJsonObject detail = detailByDomain.value(domainId);
-            if (detail.isEmpty()) {
-                detail.insert("domain_id", domainId);
-                detail.insert("nodes", QJsonArray{});
-            }
-
-            detail.insert("ros_process_count", summary.value("ros_process_count"));
-            detail.insert("domain_cpu_percent", summary.value("domain_cpu_percent"));
-            detail.insert("domain_memory_percent", summary.value("domain_memory_percent"));
-            detail.insert("workspace_count", summary.value("workspace_count"));
-            domainDetails.append(detail);
-        }
-    }
-    lastDomainDetails_ = domainDetails;
-
-    // Heavy ROS graph probes are decimated unless the relevant tab is active.
-    const bool needGraph =
-        (engineerMode && (activeTab == 2 || activeTab == 6 || activeTab == 7 || activeTab == 8 || pollCounter_ % 4 == 0))
-        || (!engineerMode && pollCounter_ % (idleBackoffMs_ >= 4000 ? 18 : 10) == 0);
-    const bool needTf =
-        (engineerMode && (activeTab == 3 || activeTab == 6 || activeTab == 7 || activeTab == 8 || pollCounter_ % 5 == 0))
-        || (!engineerMode && pollCounter_ % (idleBackoffMs_ >= 4000 ? 24 : 15) == 0);
-    const bool needLogs =
-        (engineerMode && ((activeTab == 5) || pollCounter_ % 4 == 0))
-        || (!engineerMode && pollCounter_ % (idleBackoffMs_ >= 4000 ? 16 : 8) == 0);
-
-    if (!skipRosHeavy
-        && (needGraph || lastGraph_.isEmpty() || lastGraph_.value("domain_id").toString() != selectedDomain)) {
-        lastGraph_ = rosInspector_.inspectGraph(selectedDomain, lastAllProcesses_);
-    }
-    if (!skipRosHeavy
-        && (needTf || lastTfNav2_.isEmpty() || lastTfNav2_.value("domain_id").toString() != selectedDomain)) {
-        lastTfNav2_ = rosInspector_.inspectTfNav2(selectedDomain);
-    }
-
-    lastSystem_ = systemMonitor_.collectSystem();
-    if (needLogs || lastLogs_.isEmpty()) {
-        lastLogs_ = systemMonitor_.tailDmesg(300);
-    }
-
-    if (!skipRosHeavy) {
-        lastHealth_ = healthMonitor_.evaluate(lastDomainDetails_, lastGraph_, lastTfNav2_);
-    }
-
-    const bool deepSampling =
-        engineerMode && (activeTab == 2 || activeTab == 3 || activeTab == 6 || activeTab == 7
-        || activeTab == 8 || pollCounter_ % 3 == 0);
-    if (!skipRosHeavy) {
-        lastAdvanced_ = diagnosticsEngine_.evaluate(
-            selectedDomain,
-            lastAllProcesses_,
-            lastDomainDetails_,
-            lastGraph_,
-            lastTfNav2_,
-            lastSystem_,
-            lastHealth_,
-            parameterCache_,
-            deepSampling,
-            2000);
-    }
-
-    if (watchdogEnabled_) {
-        applyWatchdog(selectedDomain);
-    }
-
-    if (activeTab == 10 || pollCounter_ % 8 == 0) {
-        lastFleet_ = remoteMonitor_.collectFleetStatus(4500);
-    }
-    if (pollCounter_ % 6 == 0) {
-        remoteMonitor_.resumeQueuedActions(2, 4500);
-    }
-
-    lastWatchdog_ = {
-        {"enabled", watchdogEnabled_},
-        {"last_action_epoch_ms", lastWatchdogActionMs_},
-        {"soft_boundary_warnings",
-         lastAdvanced_.value("soft_safety_boundary").toObject().value("warning_count").toInt()},
-    };
-
-    QJsonObject response = buildResponse(
-        selectedDomain,
-        lastAllProcesses_,
-        lastVisibleProcesses_,
-        lastDomainSummaries_,
-        lastDomainDetails_,
-        lastGraph_,
-        lastTfNav2_,
-        lastSystem_,
-        lastLogs_,
-        lastHealth_,
-        lastAdvanced_,
-        lastFleet_,
-        sessionRecorder_.status(),
-        lastWatchdog_);
-    response.insert("process_total_filtered", filteredTotalCount);
+    QJsonObject response = buildResponse(selectedDomain, lastVisibleProcesses_, sections);
+    response.insert("process_total_filtered", lastFilteredTotalCount_);
     response.insert("process_offset", processOffset);
     response.insert("process_limit", processLimit);
 
-    const QJsonObject sectionHashes = {
-        {"processes_visible", compactHashArray(lastVisibleProcesses_)},
-        {"domain_summaries", compactHashArray(lastDomainSummaries_)},
-        {"domains", compactHashArray(lastDomainDetails_)},
-        {"graph", compactHash(lastGraph_)},
-        {"tf_nav2", compactHash(lastTfNav2_)},
-        {"system", compactHash(lastSystem_)},
-        {"health", compactHash(lastHealth_)},
-        {"advanced", compactHash(lastAdvanced_)},
-        {"fleet", compactHash(lastFleet_)},
-        {"session", compactHash(sessionRecorder_.status())},
-        {"watchdog", compactHash(lastWatchdog_)},
-        {"logs", compactHashText(lastLogs_)},
-    };
-    const QString fingerprint = compactHash(sectionHashes);
+    // Store versions only advance when a section's content hash changed at
+    // publish time, so change detection here is a handful of integer compares.
+    QJsonObject sectionGenerations;
+    for (const QString& key : deltaSections_) {
+        sectionGenerations.insert(key, static_cast<double>(sections.value(key).version));
+    }
+    const QString fingerprint = JsonHash::toHex(JsonHash::hash(sectionGenerations));
     const bool changed = (fingerprint != lastSyncFingerprint_);
     if (changed) {
         syncVersion_++;
         lastSyncFingerprint_ = fingerprint;
-        consecutiveNoChangePolls_ = 0;
-        idleBackoffMs_ = 1000;
-    } else {
-        consecutiveNoChangePolls_++;
-        idleBackoffMs_ = qMin(maxBackoffMs_, idleBackoffMs_ * 2);
+    }
+    idleBackoffMs_ = qMax(suggestedPollIntervalMs(pollConfig()), consumerBackoffMs_);
+    QJsonObject sectionVersions;
+    for (const QString& key : deltaSections_) {
+        const qint64 generation = sections.value(key).version;
+        if (!lastSectionGenerations_.contains(key) || lastSectionGenerations_.value(key) != generation) {
+            lastSectionGenerations_.insert(key, generation);
+            sectionChangeVersions_.insert(key, syncVersion_);
+        }
+        sectionVersions.insert(key, static_cast<double>(sectionChangeVersions_.value(key)));
     }
     response.insert("sync_version", static_cast<double>(syncVersion_));
+    response.insert("section_versions", sectionVersions);
     response.insert("etag", fingerprint);
     response.insert("changed", changed);
-    response.insert("changed_sections", sectionHashes);
+    response.insert("changed_sections", sectionGenerations);
     response.insert("idle_backoff_ms", idleBackoffMs_);
-    response.insert("offline_queue_size", lastFleet_.value("offline_queue_size"));
-
-    if (!changed && sinceVersion == syncVersion_) {
-        response.remove("processes_all");
-        response.remove("processes_visible");
-        response.remove("domain_summaries");
-        response.remove("domains");
-        response.remove("graph");
-        response.remove("tf_nav2");
-        response.remove("system");
-        response.remove("logs");
-        response.remove("health");
-        response.remove("advanced");
-        response.remove("fleet");
-        response.remove("session");
-        response.remove("watchdog");
-        response.remove("node_parameters");
-        response.insert("heartbeat_only", true);
-    }
-
-    penultimateSnapshot_ = previousSnapshot_;
-    previousSnapshot_ = response;
-    sessionRecorder_.recordSample(response);
-
-    emit snapshotReady(response);
+    response.insert(
+        "offline_queue_size", sections.value("fleet").value.toObject().value("offline_queue_size"));
+
+    // History and the recorder keep section references, not copies.
+    SectionStore::Frame frame;
+    frame.meta = response;
+    for (const QString& key : deltaSections_) {
+        frame.meta.remove(key);
+        frame.sections.insert(key, sections.ptr(key));
+    }
+    penultimateFrame_ = previousFrame_;
+    previousFrame_ = frame;
+    sessionRecorder_.recordSample(frame);
+
+    // The UI already holds every section that has not changed since the
+    // version it acknowledged, so only ship the newer ones across threads.
+    const bool fullResync = sinceVersion < 0 || sinceVersion > syncVersion_;
+    QJsonObject delta = response;
+    int emittedSections = 0;
+    for (const QString& key : deltaSections_) {
+        if (!fullResync && sectionChangeVersions_.value(key, syncVersion_) <= sinceVersion) {
+            delta.remove(key);
+        } else {
+            emittedSections++;
+        }
+    }
+    delta.insert("delta", !fullResync);
+    if (emittedSections == 0) {
+        delta.insert("heartbeat_only", true);
+    }
+    Telemetry::instance().incrementCounter("sync.sections_emitted", emittedSections);
+    Telemetry::instance().incrementCounter(
+        "sync.sections_suppressed", deltaSections_.size() - emittedSections);
+    Telemetry::instance().setGauge("sync.last_emitted_sections", emittedSections);
+
+    emit snapshotReady(delta);
+    deliverToMailbox(delta);
     Telemetry::instance().recordDurationMs("sync.duration_ms", pollTimer.elapsed());
     Telemetry::instance().setGauge("sync.idle_backoff_ms", idleBackoffMs_);
-    Telemetry::instance().setGauge("sync.consecutive_no_change", consecutiveNoChangePolls_);
+    Telemetry::instance().setGauge("sync.consumer_backoff_ms", consumerBackoffMs_);
 
-    busy_ = false;
-    if (pending_) {
-        pending_ = false;
-        pollNow();
-    }
 }
 
 void RuntimeWorker::runAction(const QString& action, const QJsonObject& payload) {
@@ -423,62 +734,20 @@ void RuntimeWorker::runAction(const QString& action, const QJsonObject& payload)
     result.insert("action", action);
     result.insert("success", false);
 
-    if (action == "terminate_pid") {
-        const qint64 pid = static_cast<qint64>(payload.value("pid").toDouble(-1));
-        const bool ok = processManager_.terminateProcess(pid);
-        result.insert("success", ok);
-        result.insert("message", ok ? QString("SIGTERM sent to %1").arg(pid)
-                                    : QString("Failed to SIGTERM %1").arg(pid));
-    } else if (action == "kill_pid") {
-        const qint64 pid = static_cast<qint64>(payload.value("pid").toDouble(-1));
-        const bool ok = processManager_.forceKillProcess(pid);
-        result.insert("success", ok);
-        result.insert("message", ok ? QString("SIGKILL sent to %1").arg(pid)
-                                    : QString("Failed to SIGKILL %1").arg(pid));
-    } else if (action == "kill_tree") {
-        const qint64 pid = static_cast<qint64>(payload.value("pid").toDouble(-1));
-        const bool ok = processManager_.killProcessTree(pid, true);
-        result.insert("success", ok);
-        result.insert("message", ok ? QString("Killed process tree for %1").arg(pid)
-                                    : QString("Failed killing process tree for %1").arg(pid));
-    } else if (action == "kill_all_ros") {
-        result = actions_.killAllRosProcesses(lastAllProcesses_);
-        result.insert(
-            "message",
-            QString("Killed %1 ROS processes, %2 failed.")
-                .arg(result.value("killed_count").toInt())
-                .arg(result.value("failed_count").toInt()));
-    } else if (action == "restart_domain") {
-        result = actions_.restartDomain(payload.value("domain_id").toString("0"), lastAllProcesses_);
-        result.insert(
-            "message",
-            QString("Domain %1 restart: %2 terminated.")
-                .arg(payload.value("domain_id").toString("0"))
-                .arg(result.value("terminated_processes").toInt()));
-    } else if (action == "clear_shared_memory") {
-        result = actions_.clearSharedMemory();
-        result.insert("message", "Shared memory cleanup executed.");
-    } else if (action == "restart_workspace") {
-        result = actions_.restartWorkspace(
-            payload.value("workspace_path").toString(),
-            payload.value("relaunch_command").toString(),
-            lastAllProcesses_);
-        result.insert(
-            "message",
-            QString("Workspace restart: %1 terminated.")
-                .arg(result.value("terminated_processes").toInt()));
-    } else if (action == "snapshot_json" || action == "snapshot_yaml") {
+    if (action == "snapshot_json" || action == "snapshot_yaml") {
         const QString format = (action == "snapshot_yaml") ? "yaml" : "json";
-        const QString graphDomain = lastGraph_.value("domain_id").toString("0");
+        const SectionStore::Sections sections = sectionStore_.sections();
+        const QJsonObject graph = sections.value("graph").value.toObject();
+        const QString graphDomain = graph.value("domain_id").toString("0");
 
         // Snapshot action captures parameters for visible graph nodes on demand.
         QJsonObject snapshotParams = parameterCache_;
-        for (const QJsonValue& nodeValue : lastGraph_.value("nodes").toArray()) {
+        for (const QJsonValue& nodeValue : graph.value("nodes").toArray()) {
             const QString nodeName = nodeValue.toObject().value("full_name").toString();
             if (nodeName.isEmpty() || snapshotParams.contains(nodeName)) {
                 continue;
             }
-            const QJsonObject params = rosInspector_.fetchNodeParameters(graphDomain, nodeName);
+            const QJsonObject params = parameterInspector_.fetchNodeParameters(graphDomain, nodeName);
             if (params.value("success").toBool(false)) {
                 snapshotParams.insert(nodeName, params.value("parameters").toString());
                 parameterCacheOrder_.append(nodeName);
@@ -487,20 +756,21 @@ void RuntimeWorker::runAction(const QString& action, const QJsonObject& payload)
         }
         parameterCache_ = snapshotParams;
         pruneParameterCache();
+        publishParameterCache();
 
         const QJsonObject snapshot = snapshotManager_.buildSnapshot(
-            lastAllProcesses_,
-            lastDomainDetails_,
-            lastGraph_,
-            lastTfNav2_,
-            lastSystem_,
-            lastHealth_,
+            sections.value("processes_all").value.toArray(),
+            sections.value("domains").value.toArray(),
+            graph,
+            sections.value("tf_nav2").value.toObject(),
+            sections.value("system").value.toObject(),
+            sections.value("health").value.toObject(),
             snapshotParams);
         QJsonObject enriched = snapshot;
-        enriched.insert("advanced", lastAdvanced_);
-        enriched.insert("fleet", lastFleet_);
+        enriched.insert("advanced", sections.value("advanced").value.toObject());
+        enriched.insert("fleet", sections.value("fleet").value.toObject());
         enriched.insert("session", sessionRecorder_.status());
-        enriched.insert("watchdog", lastWatchdog_);
+        enriched.insert("watchdog", sections.value("watchdog").value.toObject());
         enriched.insert("preset_name", presetName_);
         result = snapshotManager_.exportSnapshot(enriched, format);
         result.insert("action", action);
@@ -510,33 +780,25 @@ void RuntimeWorker::runAction(const QString& action, const QJsonObject& payload)
             payload.value("right_path").toString());
         result.insert("action", action);
     } else if (action == "compare_with_previous") {
-        if (penultimateSnapshot_.isEmpty()) {
+        if (penultimateFrame_.sections.isEmpty()) {
             result.insert("success", false);
             result.insert("error", "No previous snapshot available for diff.");
         } else {
-            result = snapshotDiff_.compare(penultimateSnapshot_, buildResponse(
-                lastGraph_.value("domain_id").toString("0"),
-                lastAllProcesses_,
+            const SectionStore::Sections sections = sectionStore_.sections();
+            result = snapshotDiff_.compare(penultimateFrame_.toJson(), buildResponse(
+                sections.value("graph").value.toObject().value("domain_id").toString("0"),
                 lastVisibleProcesses_,
-                lastDomainSummaries_,
-                lastDomainDetails_,
-                lastGraph_,
-                lastTfNav2_,
-                lastSystem_,
-                lastLogs_,
-                lastHealth_,
-                lastAdvanced_,
-                lastFleet_,
-                sessionRecorder_.status(),
-                lastWatchdog_));
+                sections));
             result.insert("success", true);
         }
         result.insert("action", action);
     } else if (action == "session_start") {
+        recording_ = true;
         result = sessionRecorder_.start(payload.value("session_name").toString("runtime_session"));
         result.insert("success", true);
         result.insert("action", action);
     } else if (action == "session_stop") {
+        recording_ = false;
         result = sessionRecorder_.stop();
         result.insert("success", true);
         result.insert("action", action);
@@ -547,6 +809,7 @@ void RuntimeWorker::runAction(const QString& action, const QJsonObject& payload)
         const QString path = payload.value("path").toString(
             QDir(QDir::currentPath()).filePath("logs/telemetry.json"));
         result = Telemetry::instance().exportToFile(path);
+        result.insert("section_memory", sectionStore_.memoryReport());
         result.insert("action", action);
     } else if (action == "save_preset") {
         result = saveRuntimePreset(payload.value("name").toString("default"));
@@ -554,62 +817,70 @@ void RuntimeWorker::runAction(const QString& action, const QJsonObject& payload)
     } else if (action == "load_preset") {
         result = loadRuntimePreset(payload.value("name").toString("default"));
         result.insert("action", action);
-    } else if (action == "watchdog_enable") {
-        watchdogEnabled_ = true;
-        result.insert("success", true);
-        result.insert("message", "Watchdog enabled.");
-    } else if (action == "watchdog_disable") {
-        watchdogEnabled_ = false;
+    } else if (action == "watchdog_enable" || action == "watchdog_disable") {
+        const bool enabled = action == "watchdog_enable";
+        watchdogEnabled_ = enabled;
+        if (enabled) {
+            seedWatchdog();
+        }
+        publishWatchdogSection();
         result.insert("success", true);
-        result.insert("message", "Watchdog disabled.");
-    } else if (action == "isolate_domain") {
-        const QString domainId = payload.value("domain_id").toString("0");
-        int killed = 0;
-        int failed = 0;
-        for (const QJsonValue& value : lastAllProcesses_) {
-            const QJsonObject proc = value.toObject();
-            if (!proc.value("is_ros").toBool()) {
-                continue;
-            }
-            if (proc.value("ros_domain_id").toString("0") != domainId) {
-                continue;
-            }
-            const qint64 pid = static_cast<qint64>(proc.value("pid").toDouble(-1));
-            if (pid <= 0) {
-                continue;
-            }
-            if (processManager_.killProcessTree(pid, true)) {
-                killed++;
-            } else {
-                failed++;
+        result.insert("message", enabled ? "Watchdog enabled." : "Watchdog disabled.");
+    } else if (action == "watchdog_rules") {
+        QJsonArray rules = payload.value("rules").toArray();
+        if (!payload.contains("rules")) {
+            QFile file(payload.value("path").toString("watchdog_rules.json"));
+            if (file.open(QIODevice::ReadOnly)) {
+                rules = QJsonDocument::fromJson(file.readAll()).array();
             }
         }
-        const QMap<QString, QString> env = {{"ROS_DOMAIN_ID", domainId}};
-        const CommandResult daemonStop = CommandRunner::run("ros2", {"daemon", "stop"}, 3000, env);
-        result.insert("success", failed == 0);
-        result.insert("killed_count", killed);
-        result.insert("failed_count", failed);
-        result.insert("daemon_stop_ok", daemonStop.success());
-        result.insert("message", QString("Domain %1 isolated: %2 killed, %3 failed.")
-                                     .arg(domainId)
-                                     .arg(killed)
-                                     .arg(failed));
+        result = watchdogEngine_.loadRules(rules.isEmpty() ? WatchdogEngine::defaultRules() : rules);
+        if (result.value("success").toBool(false) && watchdogEnabled_.load()) {
+            seedWatchdog();
+        }
+        publishWatchdogSection();
+        result.insert("action", action);
+    } else if (action == "governor_budgets") {
+        ResourceGovernor::Budgets budgets = governor_.budgets();
+        budgets.cpuPercent = payload.value("cpu_percent").toDouble(budgets.cpuPercent);
+        budgets.rssKb = static_cast<qint64>(payload.value("rss_mb").toDouble(budgets.rssKb / 1024.0) * 1024.0);
+        governor_.setBudgets(budgets);
+        const QJsonObject status = governor_.status();
+        sectionStore_.publish("governor", status);
+        result.insert("success", true);
+        result.insert("governor", status);
+    } else if (action == "collector_budget") {
+        if (payload.contains("cpu_percent")) {
+            scheduler_.setBudgetPercent(payload.value("cpu_percent").toDouble());
+        }
+        result.insert("success", true);
+        result.insert("scheduler", scheduler_.status());
+    } else if (action == "collectors") {
+        result.insert("success", true);
+        result.insert("collectors", collectorRegistry_.status());
+        result.insert("scheduler", scheduler_.status());
     } else if (action == "fleet_load_targets") {
+        QMutexLocker lock(&fleetMutex_);
         result = remoteMonitor_.loadTargetsFromFile(payload.value("path").toString("fleet_targets.json"));
         result.insert("action", action);
     } else if (action == "fleet_refresh") {
-        lastFleet_ = remoteMonitor_.collectFleetStatus(4500);
+        QMutexLocker lock(&fleetMutex_);
+        const QJsonObject fleet = remoteMonitor_.collectFleetStatus(4500);
+        sectionStore_.publish("fleet", fleet);
         result.insert("success", true);
-        result.insert("fleet", lastFleet_);
+        result.insert("fleet", fleet);
         result.insert("message", "Fleet refresh complete.");
     } else if (action == "remote_action") {
+        QMutexLocker lock(&fleetMutex_);
         result = remoteMonitor_.executeRemoteAction(
             payload.value("target").toString(),
             payload.value("remote_action").toString(),
             payload.value("domain_id").toString("0"),
             4500);
-        lastFleet_ = remoteMonitor_.collectFleetStatus(4500);
-        result.insert("fleet", lastFleet_);
+        scheduleFleetRetryLocked();
+        const QJsonObject fleet = remoteMonitor_.collectFleetStatus(4500);
+        sectionStore_.publish("fleet", fleet);
+        result.insert("fleet", fleet);
         result.insert("action", action);
     } else {
         result.insert("message", "Unsupported action");
@@ -630,47 +901,218 @@ void RuntimeWorker::runAction(const QString& action, const QJsonObject& payload)
 }
 
 void RuntimeWorker::fetchNodeParameters(const QString& domainId, const QString& nodeName) {
-    QJsonObject result = rosInspector_.fetchNodeParameters(domainId, nodeName);
+    QJsonObject result = parameterInspector_.fetchNodeParameters(domainId, nodeName);
     if (result.value("success").toBool(false)) {
+        const QString previousHash =
+            warmState_.value("parameter_hashes").toObject().value(nodeName).toString();
+        if (!previousHash.isEmpty()) {
+            const QString hash = JsonHash::toHex(JsonHash::hash(result.value("parameters")));
+            result.insert("changed_since_last_run", hash != previousHash);
+        }
         parameterCache_.insert(nodeName, result.value("parameters").toString());
         parameterCacheOrder_.append(nodeName);
         parameterCacheOrder_.removeDuplicates();
         pruneParameterCache();
+        publishParameterCache();
     }
     emit nodeParametersReady(result);
 }
 
-void RuntimeWorker::applyWatchdog(const QString& selectedDomain) {
-    const qint64 now = QDateTime::currentMSecsSinceEpoch();
-    if (now - lastWatchdogActionMs_ < 12000) {
+void RuntimeWorker::handleSectionPublished(
+    const QString& name,
+    const SectionStore::SectionPtr& section) {
+    // Cached values are neither first data nor evidence for the watchdog.
+    if (loadingWarmStart_.load()) {
+        return;
+    }
+    noteFirstData(name);
+    if (!watchdogEnabled_.load() || !watchdogEngine_.dependsOn(name)) {
+        return;
+    }
+    dispatchWatchdog(watchdogEngine_.ingest(name, section->value, section->changedEpochMs));
+    if (watchdogEngine_.nextDeadlineEpochMs() >= 0) {
+        // Held rules fire from the worker's timer, whichever lane published.
+        QMetaObject::invokeMethod(this, [this]() { armWatchdogTimer(); }, Qt::QueuedConnection);
+    }
+}
+
+void RuntimeWorker::noteFirstData(const QString& name) {
+    {
+        QMutexLocker lock(&startupMutex_);
+        // Fresh data replaces the previous run's copy.
+        warmSections_.remove(name);
+        if (firstDataSections_.contains(name)) {
+            return;
+        }
+        firstDataSections_.insert(name);
+    }
+    Telemetry::instance().recordSinceStartup("startup.first_data_ms." + name);
+    // These are published by the poll itself.
+    if (name == "processes_visible" || name == "session" || name == "governor") {
+        return;
+    }
+    QMetaObject::invokeMethod(this, [this]() { pushFirstData(); }, Qt::QueuedConnection);
+}
+
+void RuntimeWorker::pushFirstData() {
+    if (request_.isEmpty()) {
+        return;
+    }
+    // Skips the poll interval: this happens once per section, and views
+    // fill in as each collector finishes instead of on the next refresh.
+    pollTimer_->stop();
+    Telemetry::instance().incrementCounter("startup.first_data_pushes");
+    pollNow();
+}
+
+void RuntimeWorker::loadWarmStart() {
+    warmState_ = warmStartCache_.load();
+    if (warmState_.isEmpty()) {
+        return;
+    }
+    processManager_.importClassifications(warmState_.value("classifications").toArray());
+    scheduler_.importCosts(warmState_.value("collector_costs").toObject());
+    const QJsonObject sections = warmState_.value("sections").toObject();
+    const QJsonObject epochs = warmState_.value("section_epoch_ms").toObject();
+    QHash<QString, qint64> warm;
+    loadingWarmStart_ = true;
+    for (const QString& name : kWarmStartSections) {
+        if (!sections.contains(name)) {
+            continue;
+        }
+        const qint64 cachedAt = epochs.value(name).toInteger(0);
+        sectionStore_.publish(name, WarmStartCache::markCached(sections.value(name), cachedAt));
+        warm.insert(name, cachedAt);
+    }
+    loadingWarmStart_ = false;
+    {
+        QMutexLocker lock(&startupMutex_);
+        warmSections_ = warm;
+    }
+    Telemetry::instance().recordSinceStartup("startup.warm_start_ms");
+    // The poll that started the lanes ships these with its snapshot.
+    Telemetry::instance().setGauge("warm_start.sections_loaded", warm.size());
+}
+
+void RuntimeWorker::saveWarmStart() {
+    QHash<QString, qint64> warm;
+    {
+        QMutexLocker lock(&startupMutex_);
+        warm = warmSections_;
+    }
+    const QJsonObject previousSections = warmState_.value("sections").toObject();
+    const QJsonObject previousEpochs = warmState_.value("section_epoch_ms").toObject();
+    QJsonObject sections;
+    QJsonObject epochs;
+    for (const QString& name : kWarmStartSections) {
+        if (warm.contains(name)) {
+            // Never revalidated this run; keep the copy that was loaded.
+            sections.insert(name, previousSections.value(name));
+            epochs.insert(name, previousEpochs.value(name));
+            continue;
+        }
+        const SectionStore::Section section = sectionStore_.section(name);
+        if (section.version > 0) {
+            sections.insert(name, section.value);
+            epochs.insert(name, static_cast<double>(section.changedEpochMs));
+        }
+    }
+
+    QJsonObject parameterHashes;
+    for (auto it = parameterCache_.constBegin(); it != parameterCache_.constEnd(); ++it) {
+        parameterHashes.insert(it.key(), JsonHash::toHex(JsonHash::hash(it.value())));
+    }
+    const QJsonObject previousHashes = warmState_.value("parameter_hashes").toObject();
+    for (auto it = previousHashes.constBegin();
+         it != previousHashes.constEnd() && parameterHashes.size() < kMaxParameterHashes;
+         ++it) {
+        if (!parameterHashes.contains(it.key())) {
+            parameterHashes.insert(it.key(), it.value());
+        }
+    }
+
+    QJsonObject state;
+    state.insert("sections", sections);
+    state.insert("section_epoch_ms", epochs);
+    state.insert("parameter_hashes", parameterHashes);
+    state.insert("classifications", processManager_.exportClassifications());
+    state.insert("collector_costs", scheduler_.exportCosts());
+    warmStartCache_.save(state);
+}
+
+void RuntimeWorker::seedWatchdog() {
+    watchdogEngine_.resetState();
+    QHash<QString, qint64> warm;
+    {
+        QMutexLocker lock(&startupMutex_);
+        warm = warmSections_;
+    }
+    for (const QString& name : watchdogEngine_.sections()) {
+        const SectionStore::Section section = sectionStore_.section(name);
+        // Sections still holding the previous run's data are not evidence.
+        if (section.version > 0 && !warm.contains(name)) {
+            dispatchWatchdog(watchdogEngine_.ingest(name, section.value, section.changedEpochMs));
+        }
+    }
+    armWatchdogTimer();
+}
+
+void RuntimeWorker::armWatchdogTimer() {
+    const qint64 deadline = watchdogEngine_.nextDeadlineEpochMs();
+    if (deadline < 0 || !watchdogEnabled_.load()) {
+        watchdogTimer_->stop();
         return;
     }
+    const qint64 delayMs = qMax<qint64>(0, deadline - QDateTime::currentMSecsSinceEpoch());
+    watchdogTimer_->start(static_cast<int>(qMin<qint64>(delayMs, 60000)));
+}
 
-    const QString healthStatus = lastHealth_.value("status").toString("healthy");
-    const int softWarnings =
-        lastAdvanced_.value("soft_safety_boundary").toObject().value("warning_count").toInt();
-    const int zombieCount = lastHealth_.value("zombie_nodes").toArray().size();
-    const double cpu = lastSystem_.value("cpu").toObject().value("usage_percent").toDouble();
-
-    bool actionTaken = false;
-    QString actionMessage;
-    if (zombieCount > 0) {
-        QJsonObject result = actions_.restartDomain(selectedDomain, lastAllProcesses_);
-        actionTaken = result.value("success").toBool(false);
-        actionMessage = QString("Watchdog restart domain %1 (%2 zombies)").arg(selectedDomain).arg(zombieCount);
-    } else if (cpu > 95.0 || healthStatus == "critical") {
-        QJsonObject result = actions_.killAllRosProcesses(lastAllProcesses_);
-        actionTaken = result.value("success").toBool(false);
-        actionMessage = "Watchdog emergency stop due to critical load";
-    } else if (softWarnings >= 4) {
-        actionTaken = true;
-        actionMessage = "Watchdog warning escalation without kill action";
-    }
-
-    if (actionTaken) {
+void RuntimeWorker::dispatchWatchdog(const QList<WatchdogEngine::Firing>& firings) {
+    if (firings.isEmpty()) {
+        return;
+    }
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    ActionExecutor* executor = actionExecutor_.get();
+    for (const WatchdogEngine::Firing& firing : firings) {
+        if (firing.action != "warn") {
+            // Same high-priority path as a user's click.
+            const QJsonObject payload{
+                {"domain_id", firing.domainId},
+                {"requested_epoch_ms", static_cast<double>(now)},
+                {"watchdog_rule", firing.ruleId},
+            };
+            const QString action = firing.action;
+            QMetaObject::invokeMethod(
+                executor, [executor, action, payload]() { executor->execute(action, payload); }, Qt::QueuedConnection);
+        }
+        Telemetry::instance().recordEvent("watchdog_fired", {
+            {"rule", firing.ruleId},
+            {"action", firing.action},
+            {"message", firing.message},
+            {"latency_ms", static_cast<double>(firing.latencyMs)},
+        });
+        QMutexLocker lock(&watchdogMutex_);
         lastWatchdogActionMs_ = now;
-        lastWatchdog_.insert("last_action_message", actionMessage);
+        lastWatchdogMessage_ = firing.message;
     }
+    publishWatchdogSection();
+}
+
+void RuntimeWorker::publishWatchdogSection() {
+    QJsonObject watchdog = {
+        {"enabled", watchdogEnabled_.load()},
+        {"soft_boundary_warnings",
+         sectionStore_.value("advanced").toObject().value("soft_safety_boundary").toObject().value("warning_count").toInt()},
+        {"rules", watchdogEngine_.status()},
+    };
+    {
+        QMutexLocker lock(&watchdogMutex_);
+        watchdog.insert("last_action_epoch_ms", lastWatchdogActionMs_);
+        if (!lastWatchdogMessage_.isEmpty()) {
+            watchdog.insert("last_action_message", lastWatchdogMessage_);
+        }
+    }
+    sectionStore_.publish("watchdog", watchdog);
 }
 
 QJsonObject RuntimeWorker::saveRuntimePreset(const QString& name) const {
@@ -692,10 +1134,22 @@ QJsonObject RuntimeWorker::saveRuntimePreset(const QString& name) const {
 
     QJsonObject payload;
     payload.insert("preset_name", preset);
-    payload.insert("selected_domain", lastGraph_.value("domain_id").toString("0"));
-    payload.insert("watchdog_enabled", watchdogEnabled_);
-    payload.insert("expected_profile", diagnosticsEngine_.expectedProfile());
-    payload.insert("remote_targets", remoteMonitor_.targets());
+    payload.insert(
+        "selected_domain", sectionStore_.value("graph").toObject().value("domain_id").toString("0"));
+    payload.insert("watchdog_enabled", watchdogEnabled_.load());
+    payload.insert("watchdog_rules", watchdogEngine_.rules());
+    const ResourceGovernor::Budgets budgets = governor_.budgets();
+    payload.insert("governor_cpu_percent", budgets.cpuPercent);
+    payload.insert("governor_rss_mb", static_cast<double>(budgets.rssKb / 1024));
+    payload.insert("collector_cpu_budget_percent", scheduler_.budgetPercent());
+    {
+        QMutexLocker lock(&configMutex_);
+        payload.insert("expected_profile", expectedProfile_);
+    }
+    {
+        QMutexLocker lock(&fleetMutex_);
+        payload.insert("remote_targets", remoteMonitor_.targets());
+    }
     payload.insert("timestamp_utc", QDateTime::currentDateTimeUtc().toString(Qt::ISODate));
     file.write(QJsonDocument(payload).toJson(QJsonDocument::Indented));
     file.close();
@@ -728,9 +1182,26 @@ QJsonObject RuntimeWorker::loadRuntimePreset(const QString& name) {
         };
     }
     const QJsonObject payload = doc.object();
-    diagnosticsEngine_.setExpectedProfile(payload.value("expected_profile").toObject());
-    remoteMonitor_.setTargets(payload.value("remote_targets").toArray());
+    {
+        // The diagnostics collector applies it before its next pass.
+        QMutexLocker lock(&configMutex_);
+        expectedProfile_ = payload.value("expected_profile").toObject();
+        diagnosticsCollector_->setExpectedProfile(expectedProfile_);
+    }
+    {
+        QMutexLocker lock(&fleetMutex_);
+        remoteMonitor_.setTargets(payload.value("remote_targets").toArray());
+    }
+    if (payload.contains("watchdog_rules")) {
+        watchdogEngine_.loadRules(payload.value("watchdog_rules").toArray());
+    }
     watchdogEnabled_ = payload.value("watchdog_enabled").toBool(false);
+    ResourceGovernor::Budgets budgets = governor_.budgets();
+    budgets.cpuPercent = payload.value("governor_cpu_percent").toDouble(budgets.cpuPercent);
+    budgets.rssKb = static_cast<qint64>(payload.value("governor_rss_mb").toDouble(budgets.rssKb / 1024.0) * 1024.0);
+    governor_.setBudgets(budgets);
+    scheduler_.setBudgetPercent(
+        payload.value("collector_cpu_budget_percent").toDouble(scheduler_.budgetPercent()));
     presetName_ = payload.value("preset_name").toString(preset);
 
     return {
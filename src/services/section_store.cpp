@@ -0,0 +1,150 @@
+#include "rrcc/section_store.hpp"
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QMutexLocker>
+
+#include "rrcc/json_hash.hpp"
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+// Rough in-memory footprint of a JSON value: UTF-16 payload plus a fixed
+// per-element overhead. Good enough to compare sections against each other.
+qint64 approximateBytes(const QJsonValue& value) {
+    constexpr qint64 kElementOverhead = 16;
+    switch (value.type()) {
+    case QJsonValue::String:
+        return kElementOverhead + 2 * value.toString().size();
+    case QJsonValue::Array: {
+        qint64 total = kElementOverhead;
+        for (const QJsonValue& item : value.toArray()) {
+            total += approximateBytes(item);
+        }
+        return total;
+    }
+    case QJsonValue::Object: {
+        qint64 total = kElementOverhead;
+        const QJsonObject object = value.toObject();
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            total += kElementOverhead + 2 * it.key().size() + approximateBytes(it.value());
+        }
+        return total;
+    }
+    default:
+        return kElementOverhead;
+    }
+}
+
+}  // namespace
+
+const SectionStore::Section& SectionStore::Sections::value(const QString& name) const {
+    static const Section kEmpty;
+    const auto it = sections_.constFind(name);
+    if (it == sections_.constEnd() || !it.value()) {
+        return kEmpty;
+    }
+    return *it.value();
+}
+
+void SectionStore::Sections::insert(const QString& name, const SectionPtr& section) {
+    if (section) {
+        sections_.insert(name, section);
+    }
+}
+
+qint64 SectionStore::Sections::approxBytes() const {
+    qint64 total = 0;
+    for (const SectionPtr& section : sections_) {
+        total += section->approxBytes;
+    }
+    return total;
+}
+
+QJsonObject SectionStore::Frame::toJson() const {
+    QJsonObject json = meta;
+    for (const QString& name : sections.names()) {
+        json.insert(name, sections.value(name).value);
+    }
+    return json;
+}
+
+qint64 SectionStore::publish(const QString& name, const QJsonValue& value) {
+    // Hash on the publishing thread, outside the lock.
+    const quint64 hash = JsonHash::hash(value);
+    {
+        QMutexLocker lock(&mutex_);
+        const SectionPtr current = sections_.ptr(name);
+        if (current && current->hash == hash) {
+            const qint64 version = current->version;
+            lock.unlock();
+            Telemetry::instance().incrementCounter("sections.unchanged_publishes");
+            return version;
+        }
+    }
+
+    auto next = std::make_shared<Section>();
+    next->value = value;
+    next->hash = hash;
+    next->changedEpochMs = QDateTime::currentMSecsSinceEpoch();
+    next->approxBytes = approximateBytes(value);
+
+    QMutexLocker lock(&mutex_);
+    next->version = ++latestVersion_;
+    sections_.insert(name, next);
+    const qint64 totalBytes = sections_.approxBytes();
+    lock.unlock();
+    Telemetry::instance().setGauge("sections." + name + ".bytes", static_cast<double>(next->approxBytes));
+    Telemetry::instance().setGauge("sections.total_bytes", static_cast<double>(totalBytes));
+    if (listener_) {
+        listener_(name, next);
+    }
+    return next->version;
+}
+
+SectionStore::Section SectionStore::section(const QString& name) const {
+    QMutexLocker lock(&mutex_);
+    return sections_.value(name);
+}
+
+QJsonValue SectionStore::value(const QString& name) const {
+    QMutexLocker lock(&mutex_);
+    return sections_.value(name).value;
+}
+
+qint64 SectionStore::version(const QString& name) const {
+    QMutexLocker lock(&mutex_);
+    return sections_.value(name).version;
+}
+
+bool SectionStore::contains(const QString& name) const {
+    QMutexLocker lock(&mutex_);
+    return sections_.contains(name);
+}
+
+SectionStore::Sections SectionStore::sections() const {
+    QMutexLocker lock(&mutex_);
+    return sections_;
+}
+
+qint64 SectionStore::latestVersion() const {
+    QMutexLocker lock(&mutex_);
+    return latestVersion_;
+}
+
+QJsonObject SectionStore::memoryReport() const {
+    const Sections current = sections();
+    QJsonObject report;
+    for (const QString& name : current.names()) {
+        const SectionPtr section = current.ptr(name);
+        report.insert(name, QJsonObject{
+            {"bytes", static_cast<double>(section->approxBytes)},
+            {"version", static_cast<double>(section->version)},
+        });
+    }
+    return report;
+}
+
+}  // namespace rrcc
@@ -0,0 +1,142 @@
+#include "rrcc/self_usage.hpp"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QList>
+#include <QStringList>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace rrcc {
+
+namespace {
+
+// Fields of /proc/<pid>/stat after the command name: state, ppid, ...
+QStringList statFields(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    const QString stat = QString::fromUtf8(file.readAll());
+    const int rightParen = stat.lastIndexOf(')');
+    if (rightParen < 0) {
+        return {};
+    }
+    return stat.mid(rightParen + 2).split(' ', Qt::SkipEmptyParts);
+}
+
+// utime + stime of this process and its reaped children, in microseconds.
+qulonglong procCpuUs() {
+    const QStringList fields = statFields("/proc/self/stat");
+    if (fields.size() < 15) {
+        return 0;
+    }
+#ifdef __linux__
+    const long clockTicks = sysconf(_SC_CLK_TCK);
+#else
+    const long clockTicks = 100;
+#endif
+    const qulonglong ticks = fields[11].toULongLong() + fields[12].toULongLong()
+        + fields[13].toULongLong() + fields[14].toULongLong();
+    return clockTicks > 0 ? ticks * 1000000ULL / static_cast<qulonglong>(clockTicks) : 0;
+}
+
+// The cgroup v2 directory of this process, or empty without one.
+QString resolveCgroupDir() {
+    QFile file("/proc/self/cgroup");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine()).trimmed();
+        if (line.startsWith("0::")) {
+            const QString dir = "/sys/fs/cgroup" + line.mid(3);
+            return QFile::exists(dir + "/cpu.stat") ? dir : QString();
+        }
+    }
+    return {};
+}
+
+// True when the cgroup only holds this process and its children, so its
+// counters describe RosScope alone (e.g. a systemd unit for rosscoped).
+bool cgroupIsDedicated(const QString& dir) {
+    QFile file(dir + "/cgroup.procs");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const qint64 self = QCoreApplication::applicationPid();
+    int count = 0;
+    for (const QByteArray& line : file.readAll().split('\n')) {
+        const qint64 pid = line.trimmed().toLongLong();
+        if (pid <= 0) {
+            continue;
+        }
+        if (++count > 64) {
+            return false;
+        }
+        if (pid == self) {
+            continue;
+        }
+        const QStringList fields = statFields(QString("/proc/%1/stat").arg(pid));
+        if (fields.size() < 2 || fields[1].toLongLong() != self) {
+            return false;
+        }
+    }
+    return count > 0;
+}
+
+qulonglong cgroupCpuUs(const QString& dir) {
+    QFile file(dir + "/cpu.stat");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine());
+        if (line.startsWith("usage_usec ")) {
+            return line.section(' ', 1, 1).trimmed().toULongLong();
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+double SelfUsage::sampleCpuPercent() {
+    if (!cgroupResolved_) {
+        cgroupDir_ = resolveCgroupDir();
+        cgroupResolved_ = true;
+    }
+    const bool useCgroup = !cgroupDir_.isEmpty() && cgroupIsDedicated(cgroupDir_);
+    const QString source = useCgroup ? QString("cgroup") : QString("proc");
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qulonglong cpuUs = useCgroup ? cgroupCpuUs(cgroupDir_) : procCpuUs();
+    double percent = -1.0;
+    if (source == lastSource_ && lastEpochMs_ > 0 && now > lastEpochMs_ && cpuUs >= lastCpuUs_) {
+        const double cpuMs = static_cast<double>(cpuUs - lastCpuUs_) / 1000.0;
+        percent = 100.0 * cpuMs / static_cast<double>(now - lastEpochMs_);
+    }
+    lastCpuUs_ = cpuUs;
+    lastEpochMs_ = now;
+    lastSource_ = source;
+    return percent;
+}
+
+qint64 SelfUsage::rssKb() {
+    QFile file("/proc/self/status");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return 0;
+    }
+    while (!file.atEnd()) {
+        const QString line = QString::fromUtf8(file.readLine());
+        if (line.startsWith("VmRSS:")) {
+            return line.section(':', 1).trimmed().section(' ', 0, 0).toLongLong();
+        }
+    }
+    return 0;
+}
+
+}  // namespace rrcc
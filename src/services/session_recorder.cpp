@@ -5,6 +5,9 @@
 #include <QFile>
 #include <QJsonDocument>
 
+#include "rrcc/snapshot_codec.hpp"
+#include "rrcc/telemetry.hpp"
+
 namespace rrcc {
 
 QJsonObject SessionRecorder::start(const QString& sessionName) {
@@ -12,7 +15,9 @@ QJsonObject SessionRecorder::start(const QString& sessionName) {
     sessionName_ = sessionName.trimmed().isEmpty() ? "RosScope_session" : sessionName.trimmed();
     startedUtc_ = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
     endedUtc_.clear();
-    samples_ = QJsonArray{};
+    samples_.clear();
+    sectionRefs_.clear();
+    retainedBytes_ = 0;
     return status();
 }
 
@@ -22,15 +27,44 @@ QJsonObject SessionRecorder::stop() {
     return status();
 }
 
-void SessionRecorder::recordSample(const QJsonObject& snapshot) {
+void SessionRecorder::recordSample(const SectionStore::Frame& frame) {
     if (!active_) {
         return;
     }
-    QJsonObject compact = snapshot;
-    compact.remove("logs");
-    samples_.append(compact);
+    SectionStore::Frame compact = frame;
+    compact.sections.remove("logs");
+    retain(compact);
+    samples_.enqueue(compact);
+    while (samples_.size() > maxSamples_) {
+        release(samples_.dequeue());
+    }
+    Telemetry::instance().setGauge("session.retained_bytes", static_cast<double>(retainedBytes_));
+}
+
+void SessionRecorder::setMaxSamples(int maxSamples) {
+    maxSamples_ = qMax(10, maxSamples);
     while (samples_.size() > maxSamples_) {
-        samples_.removeAt(0);
+        release(samples_.dequeue());
+    }
+}
+
+void SessionRecorder::retain(const SectionStore::Frame& frame) {
+    for (const QString& name : frame.sections.names()) {
+        const SectionStore::SectionPtr section = frame.sections.ptr(name);
+        if (sectionRefs_[section.get()]++ == 0) {
+            retainedBytes_ += section->approxBytes;
+        }
+    }
+}
+
+void SessionRecorder::release(const SectionStore::Frame& frame) {
+    for (const QString& name : frame.sections.names()) {
+        const SectionStore::SectionPtr section = frame.sections.ptr(name);
+        auto it = sectionRefs_.find(section.get());
+        if (it != sectionRefs_.end() && --it.value() == 0) {
+            retainedBytes_ -= section->approxBytes;
+            sectionRefs_.erase(it);
+        }
     }
 }
 
@@ -41,6 +75,7 @@ QJsonObject SessionRecorder::status() const {
         {"started_utc", startedUtc_},
         {"ended_utc", endedUtc_},
         {"sample_count", samples_.size()},
+        {"retained_bytes", static_cast<double>(retainedBytes_)},
     };
 }
 
@@ -52,7 +87,8 @@ QJsonObject SessionRecorder::exportSession(const QString& format) const {
         };
     }
 
-    const QString ext = format.trimmed().toLower() == "yaml" ? "yaml" : "json";
+    const QString normalized = format.trimmed().toLower();
+    const QString ext = (normalized == "yaml" || normalized == "cbor") ? normalized : "json";
     QDir dir(QDir::currentPath());
     if (!dir.exists("sessions")) {
         dir.mkpath("sessions");
@@ -75,9 +111,16 @@ QJsonObject SessionRecorder::exportSession(const QString& format) const {
     payload.insert("session_name", sessionName_);
     payload.insert("started_utc", startedUtc_);
     payload.insert("ended_utc", endedUtc_);
-    payload.insert("samples", samples_);
+    QJsonArray samples;
+    for (const SectionStore::Frame& frame : samples_) {
+        samples.append(frame.toJson());
+    }
+    payload.insert("samples", samples);
 
-    if (ext == "json") {
+    if (ext == "cbor") {
+        // Binary recording: a fraction of the JSON size and much faster to load.
+        file.write(SnapshotCodec::encode(payload, SnapshotCodec::Format::Cbor));
+    } else if (ext == "json") {
         file.write(QJsonDocument(payload).toJson(QJsonDocument::Indented));
     } else {
         // MVP: yaml export writes JSON string payload for compatibility.
@@ -88,6 +131,7 @@ QJsonObject SessionRecorder::exportSession(const QString& format) const {
     return {
         {"success", true},
         {"path", path},
+        {"format", ext},
         {"sample_count", samples_.size()},
     };
 }
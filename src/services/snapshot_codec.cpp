@@ -0,0 +1,57 @@
+#include "rrcc/snapshot_codec.hpp"
+
+#include <QCborMap>
+#include <QCborValue>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+namespace rrcc {
+
+QByteArray SnapshotCodec::encode(const QJsonObject& object, Format format) {
+    if (format == Format::Json) {
+        return QJsonDocument(object).toJson(QJsonDocument::Compact);
+    }
+    // QJsonObject and QCborMap share storage, so the conversion is cheap.
+    // Integral doubles (pids, counts, versions) are written as CBOR integers.
+    return QCborMap::fromJsonObject(object).toCborValue().toCbor(QCborValue::UseIntegers);
+}
+
+bool SnapshotCodec::decode(const QByteArray& bytes, Format format, QJsonObject* out) {
+    if (format == Format::Json) {
+        QJsonParseError error;
+        const QJsonDocument doc = QJsonDocument::fromJson(bytes, &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+            return false;
+        }
+        *out = doc.object();
+        return true;
+    }
+    QCborParserError error;
+    const QCborValue value = QCborValue::fromCbor(bytes, &error);
+    if (error.error != QCborError::NoError || !value.isMap()) {
+        return false;
+    }
+    *out = value.toMap().toJsonObject();
+    return true;
+}
+
+SnapshotCodec::Format SnapshotCodec::formatForPath(const QString& path) {
+    return path.endsWith(".cbor", Qt::CaseInsensitive) ? Format::Cbor : Format::Json;
+}
+
+QString SnapshotCodec::extension(Format format) {
+    return format == Format::Cbor ? "cbor" : "json";
+}
+
+QJsonObject SnapshotCodec::readFile(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    QJsonObject object;
+    decode(file.readAll(), formatForPath(path), &object);
+    return object;
+}
+
+}  // namespace rrcc
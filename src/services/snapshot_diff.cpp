@@ -3,12 +3,13 @@
 #include <QCryptographicHash>
 #include <QFile>
 #include <QJsonArray>
-#include <QJsonDocument>
 #include <QSet>
 #include <QStringList>
 
 #include <algorithm>
 
+#include "rrcc/snapshot_codec.hpp"
+
 namespace rrcc {
 
 namespace {
@@ -123,22 +124,21 @@ QJsonObject SnapshotDiff::compare(const QJsonObject& left, const QJsonObject& ri
 }
 
 QJsonObject SnapshotDiff::compareFiles(const QString& leftPath, const QString& rightPath) const {
-    QFile leftFile(leftPath);
-    QFile rightFile(rightPath);
-    if (!leftFile.open(QIODevice::ReadOnly)) {
+    if (!QFile::exists(leftPath)) {
         return {{"success", false}, {"error", "Failed to open left snapshot."}};
     }
-    if (!rightFile.open(QIODevice::ReadOnly)) {
+    if (!QFile::exists(rightPath)) {
         return {{"success", false}, {"error", "Failed to open right snapshot."}};
     }
 
-    const QJsonDocument leftDoc = QJsonDocument::fromJson(leftFile.readAll());
-    const QJsonDocument rightDoc = QJsonDocument::fromJson(rightFile.readAll());
-    if (!leftDoc.isObject() || !rightDoc.isObject()) {
-        return {{"success", false}, {"error", "Snapshot files must be JSON objects."}};
+    // JSON exports and CBOR recordings can be mixed.
+    const QJsonObject left = SnapshotCodec::readFile(leftPath);
+    const QJsonObject right = SnapshotCodec::readFile(rightPath);
+    if (left.isEmpty() || right.isEmpty()) {
+        return {{"success", false}, {"error", "Snapshot files must be JSON or CBOR objects."}};
     }
 
-    QJsonObject out = compare(leftDoc.object(), rightDoc.object());
+    QJsonObject out = compare(left, right);
     out.insert("success", true);
     out.insert("left_path", leftPath);
     out.insert("right_path", rightPath);
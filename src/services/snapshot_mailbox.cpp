@@ -0,0 +1,66 @@
+#include "rrcc/snapshot_mailbox.hpp"
+
+#include <QDateTime>
+#include <QMutexLocker>
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+bool SnapshotMailbox::put(const QJsonObject& snapshot) {
+    QMutexLocker lock(&mutex_);
+    if (!hasPending_) {
+        pending_ = snapshot;
+        hasPending_ = true;
+        pendingSinceEpochMs_ = QDateTime::currentMSecsSinceEpoch();
+        return true;
+    }
+    pending_ = merge(pending_, snapshot);
+    coalesced_++;
+    lock.unlock();
+    Telemetry::instance().incrementCounter("sync.snapshots_coalesced");
+    return false;
+}
+
+QJsonObject SnapshotMailbox::take() {
+    QMutexLocker lock(&mutex_);
+    if (!hasPending_) {
+        return {};
+    }
+    const QJsonObject snapshot = pending_;
+    pending_ = QJsonObject();
+    hasPending_ = false;
+    lastWaitMs_ = QDateTime::currentMSecsSinceEpoch() - pendingSinceEpochMs_;
+    return snapshot;
+}
+
+bool SnapshotMailbox::hasPending() const {
+    QMutexLocker lock(&mutex_);
+    return hasPending_;
+}
+
+qint64 SnapshotMailbox::lastWaitMs() const {
+    QMutexLocker lock(&mutex_);
+    return lastWaitMs_;
+}
+
+qint64 SnapshotMailbox::coalescedCount() const {
+    QMutexLocker lock(&mutex_);
+    return coalesced_;
+}
+
+QJsonObject SnapshotMailbox::merge(const QJsonObject& older, const QJsonObject& newer) {
+    QJsonObject merged = older;
+    for (auto it = newer.constBegin(); it != newer.constEnd(); ++it) {
+        merged.insert(it.key(), it.value());
+    }
+    // A full snapshot anywhere in the chain makes the merge complete.
+    merged.insert("delta", older.value("delta").toBool(false) && newer.value("delta").toBool(false));
+    merged.insert("changed", older.value("changed").toBool(false) || newer.value("changed").toBool(false));
+    if (!older.value("heartbeat_only").toBool(false) || !newer.value("heartbeat_only").toBool(false)) {
+        merged.remove("heartbeat_only");
+    }
+    return merged;
+}
+
+}  // namespace rrcc
@@ -7,11 +7,14 @@
 #include <QNetworkInterface>
 #include <QStringList>
 
+#include <algorithm>
+
 #ifdef __linux__
 #include <sys/statvfs.h>
 #endif
 
 #include "rrcc/command_runner.hpp"
+#include "rrcc/proc_sampler.hpp"
 
 namespace {
 
@@ -23,57 +26,17 @@ QString readTextFile(const QString& path) {
     return QString::fromUtf8(file.readAll());
 }
 
-QMap<QString, qulonglong> parseMemInfo() {
-    QMap<QString, qulonglong> values;
-    const QString memInfo = readTextFile("/proc/meminfo");
-    for (const QString& line : memInfo.split('\n', Qt::SkipEmptyParts)) {
-        const int idx = line.indexOf(':');
-        if (idx <= 0) {
-            continue;
-        }
-        const QString key = line.left(idx).trimmed();
-        const QString value = line.mid(idx + 1).trimmed().split(' ').value(0);
-        values.insert(key, value.toULongLong());
-    }
-    return values;
-}
-
-QPair<qulonglong, qulonglong> parseCpuTimes() {
-    const QString stat = readTextFile("/proc/stat");
-    const QString first = stat.split('\n').value(0);
-    const QStringList fields = first.split(' ', Qt::SkipEmptyParts);
-    if (fields.size() < 8) {
-        return {0, 0};
-    }
-    qulonglong total = 0;
-    for (int i = 1; i < fields.size(); ++i) {
-        total += fields[i].toULongLong();
-    }
-    const qulonglong idle = fields[4].toULongLong() + fields[5].toULongLong();
-    return {total, idle};
-}
-
 }  // namespace
 
 namespace rrcc {
 
-QJsonObject SystemMonitor::cpuSnapshot() {
-    QJsonObject cpu;
-    const auto [total, idle] = parseCpuTimes();
-    cpu.insert("total_jiffies", static_cast<qint64>(total));
-    cpu.insert("idle_jiffies", static_cast<qint64>(idle));
-    return cpu;
-}
-
-QJsonObject SystemMonitor::memorySnapshot() {
+QJsonObject SystemMonitor::memorySnapshot(const ProcSample& host) {
     QJsonObject mem;
-    const QMap<QString, qulonglong> info = parseMemInfo();
-    const qulonglong total = info.value("MemTotal");
-    const qulonglong available = info.value("MemAvailable");
-    const qulonglong used = (total > available) ? (total - available) : 0;
+    const qulonglong total = host.memTotalKb;
+    const qulonglong used = host.memUsedKb;
 
     mem.insert("total_kb", static_cast<qint64>(total));
-    mem.insert("available_kb", static_cast<qint64>(available));
+    mem.insert("available_kb", static_cast<qint64>(host.memAvailableKb));
     mem.insert("used_kb", static_cast<qint64>(used));
     mem.insert("used_percent", total == 0 ? 0.0 : (100.0 * static_cast<double>(used) / total));
     return mem;
@@ -96,67 +59,6 @@ QJsonObject SystemMonitor::diskSnapshot() {
     return disk;
 }
 
-QJsonArray SystemMonitor::gpuSnapshot() {
-    QJsonArray gpus;
-    const CommandResult result = CommandRunner::run(
-        "nvidia-smi",
-        {"--query-gpu=name,utilization.gpu,memory.used,memory.total", "--format=csv,noheader,nounits"},
-        2500);
-    if (!result.success()) {
-        return gpus;
-    }
-
-    for (const QString& line : result.stdoutText.split('\n', Qt::SkipEmptyParts)) {
-        const QStringList parts = line.split(',', Qt::SkipEmptyParts);
-        if (parts.size() < 4) {
-            continue;
-        }
-        QJsonObject gpu;
-        gpu.insert("name", parts[0].trimmed());
-        gpu.insert("utilization_percent", parts[1].trimmed().toDouble());
-        gpu.insert("memory_used_mb", parts[2].trimmed().toDouble());
-        gpu.insert("memory_total_mb", parts[3].trimmed().toDouble());
-        gpus.append(gpu);
-    }
-    return gpus;
-}
-
-QJsonArray SystemMonitor::usbDevices() {
-    QJsonArray devices;
-    const CommandResult result = CommandRunner::run("lsusb", {}, 2500);
-    if (!result.success()) {
-        return devices;
-    }
-    for (const QString& line : result.stdoutText.split('\n', Qt::SkipEmptyParts)) {
-        devices.append(line.trimmed());
-    }
-    return devices;
-}
-
-QJsonArray SystemMonitor::serialPorts() {
-    QJsonArray ports;
-    const QDir devDir("/dev");
-    const QStringList patterns = {"ttyUSB*", "ttyACM*", "ttyS*", "ttyAMA*"};
-    const QStringList entries = devDir.entryList(patterns, QDir::System | QDir::NoDotAndDotDot);
-    for (const QString& entry : entries) {
-        ports.append("/dev/" + entry);
-    }
-    return ports;
-}
-
-QJsonArray SystemMonitor::canInterfaces() {
-    QJsonArray can;
-    const CommandResult result =
-        CommandRunner::run("ip", {"-details", "-brief", "link", "show", "type", "can"}, 2500);
-    if (!result.success()) {
-        return can;
-    }
-    for (const QString& line : result.stdoutText.split('\n', Qt::SkipEmptyParts)) {
-        can.append(line.trimmed());
-    }
-    return can;
-}
-
 QJsonArray SystemMonitor::networkInterfaces() {
     QJsonArray interfaces;
     const QList<QNetworkInterface> all = QNetworkInterface::allInterfaces();
@@ -185,43 +87,107 @@ QJsonArray SystemMonitor::networkInterfaces() {
 }
 
 QJsonObject SystemMonitor::collectSystem() {
-    QJsonObject out;
+    QJsonObject out = collectCore();
+    addDeviceProbes(&out);
+    return out;
+}
 
-    const auto [currentTotal, currentIdle] = parseCpuTimes();
-    double cpuPercent = 0.0;
-    if (!firstCpuSample_ && currentTotal > previousCpuTotal_) {
-        const qulonglong deltaTotal = currentTotal - previousCpuTotal_;
-        const qulonglong deltaIdle = currentIdle - previousCpuIdle_;
-        cpuPercent =
-            100.0 * (1.0 - (static_cast<double>(deltaIdle) / static_cast<double>(deltaTotal)));
-        if (cpuPercent < 0.0) {
-            cpuPercent = 0.0;
+QJsonObject SystemMonitor::cpuUsage(const CpuTimes& current, const CpuTimes& previous) {
+    QJsonObject cpu;
+    if (current.total <= previous.total) {
+        cpu.insert("usage_percent", 0.0);
+        return cpu;
+    }
+    const double deltaTotal = static_cast<double>(current.total - previous.total);
+    const auto share = [&](CpuTimes::Field field) {
+        const qulonglong now = current.field[field];
+        const qulonglong before = previous.field[field];
+        return now > before ? 100.0 * static_cast<double>(now - before) / deltaTotal : 0.0;
+    };
+    const double idle = current.idle > previous.idle
+        ? 100.0 * static_cast<double>(current.idle - previous.idle) / deltaTotal
+        : 0.0;
+    cpu.insert("usage_percent", std::max(0.0, 100.0 - idle));
+    // user and nice both count as user time, as top reports it.
+    cpu.insert("user_percent", share(CpuTimes::User) + share(CpuTimes::Nice));
+    cpu.insert("system_percent", share(CpuTimes::System));
+    cpu.insert("iowait_percent", share(CpuTimes::IoWait));
+    cpu.insert("irq_percent", share(CpuTimes::Irq));
+    cpu.insert("softirq_percent", share(CpuTimes::SoftIrq));
+    cpu.insert("steal_percent", share(CpuTimes::Steal));
+    return cpu;
+}
+
+QJsonObject SystemMonitor::pressureSnapshot(const ProcSample& host, const ProcSample& previous) {
+    static const char* const kNames[ProcSample::PressureCount] = {"cpu", "io", "memory"};
+    QJsonObject pressure;
+    const qint64 elapsedMs = previous.valid ? host.epochMs - previous.epochMs : 0;
+    for (int i = 0; i < ProcSample::PressureCount; ++i) {
+        const Pressure& now = host.pressure[i];
+        if (!now.available) {
+            continue;
         }
+        const Pressure& before = previous.pressure[i];
+        const auto line = [&](const PressureLine& current, const PressureLine& last) {
+            QJsonObject out;
+            out.insert("avg10", current.avg10);
+            out.insert("avg60", current.avg60);
+            out.insert("avg300", current.avg300);
+            // Stall time since the previous sample, and its share of the wall time.
+            const qulonglong stallUs =
+                before.available && current.totalUs > last.totalUs ? current.totalUs - last.totalUs : 0;
+            out.insert("stall_ms", static_cast<double>(stallUs) / 1000.0);
+            out.insert("stall_percent",
+                       elapsedMs > 0 ? std::min(100.0, static_cast<double>(stallUs) / (10.0 * elapsedMs)) : 0.0);
+            return out;
+        };
+        QJsonObject resource;
+        resource.insert("some", line(now.some, before.some));
+        resource.insert("full", line(now.full, before.full));
+        pressure.insert(kNames[i], resource);
     }
-    previousCpuTotal_ = currentTotal;
-    previousCpuIdle_ = currentIdle;
-    firstCpuSample_ = false;
+    return pressure;
+}
 
-    QJsonObject cpu;
-    cpu.insert("usage_percent", cpuPercent);
+QJsonObject SystemMonitor::collectCore() {
+    QJsonObject out;
+
+    const ProcSample host = ProcSampler::instance().sample();
+    const bool havePrevious = previousHost_.valid;
+    QJsonObject cpu = cpuUsage(host.cpu, havePrevious ? previousHost_.cpu : host.cpu);
+    QJsonArray cores;
+    for (int i = 0; i < host.coreCount; ++i) {
+        // Match by id: a core going offline shifts the later lines up.
+        const CpuTimes* before = &host.cores[i];
+        if (havePrevious) {
+            for (int j = 0; j < previousHost_.coreCount; ++j) {
+                if (previousHost_.coreIds[j] == host.coreIds[i]) {
+                    before = &previousHost_.cores[j];
+                    break;
+                }
+            }
+        }
+        QJsonObject core = cpuUsage(host.cores[i], *before);
+        core.insert("cpu", host.coreIds[i]);
+        cores.append(core);
+    }
+    cpu.insert("cores", cores);
     out.insert("cpu", cpu);
-    out.insert("memory", memorySnapshot());
+    out.insert("memory", memorySnapshot(host));
+    const QJsonObject pressure = pressureSnapshot(host, previousHost_);
+    if (!pressure.isEmpty()) {
+        out.insert("pressure", pressure);
+    }
     out.insert("disk", diskSnapshot());
-    out.insert("gpus", gpuSnapshot());
-    out.insert("usb_devices", usbDevices());
-    out.insert("serial_ports", serialPorts());
-    out.insert("can_interfaces", canInterfaces());
     out.insert("network_interfaces", networkInterfaces());
+    if (host.valid) {
+        previousHost_ = host;
+    }
     return out;
 }
 
-QString SystemMonitor::tailDmesg(int lines) const {
-    const QString cmd = QString("dmesg --ctime --color=never | tail -n %1").arg(lines);
-    const CommandResult result = CommandRunner::runShell(cmd, 4000);
-    if (result.success()) {
-        return result.stdoutText;
-    }
-    return result.stderrText.isEmpty() ? QString("dmesg is unavailable.") : result.stderrText;
+void SystemMonitor::addDeviceProbes(QJsonObject* system) {
+    hardwareProbes_.addTo(system);
 }
 
 }  // namespace rrcc
@@ -9,11 +9,25 @@
 
 namespace rrcc {
 
+Telemetry::Telemetry() {
+    startup_.start();
+}
+
 Telemetry& Telemetry::instance() {
     static Telemetry singleton;
     return singleton;
 }
 
+void Telemetry::markStartup() {
+    QMutexLocker lock(&mutex_);
+    startup_.restart();
+}
+
+void Telemetry::recordSinceStartup(const QString& key) {
+    QMutexLocker lock(&mutex_);
+    gauges_.insert(key, static_cast<double>(startup_.elapsed()));
+}
+
 void Telemetry::incrementCounter(const QString& key, qint64 delta) {
     QMutexLocker lock(&mutex_);
     const qint64 prev = static_cast<qint64>(counters_.value(key).toDouble(0));
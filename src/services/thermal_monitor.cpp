@@ -0,0 +1,345 @@
+#include "rrcc/thermal_monitor.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+int openReadOnly(const QString& path) {
+#ifdef __linux__
+    return ::open(QFile::encodeName(path).constData(), O_RDONLY | O_CLOEXEC);
+#else
+    Q_UNUSED(path);
+    return -1;
+#endif
+}
+
+// One integer from a sysfs attribute, re-read from offset 0; -1 on failure
+// (an offline CPU's policy reads EBUSY).
+qint64 readNumber(int fd) {
+#ifdef __linux__
+    if (fd < 0) {
+        return -1;
+    }
+    char buffer[32];
+    const ssize_t bytes = ::pread(fd, buffer, sizeof(buffer), 0);
+    if (bytes <= 0) {
+        return -1;
+    }
+    const char* p = buffer;
+    const char* end = buffer + bytes;
+    const bool negative = p < end && *p == '-';
+    if (negative) {
+        ++p;
+    }
+    qint64 value = 0;
+    bool any = false;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+        value = value * 10 + (*p - '0');
+        any = true;
+    }
+    if (!any) {
+        return -1;
+    }
+    return negative ? -value : value;
+#else
+    Q_UNUSED(fd);
+    return -1;
+#endif
+}
+
+// Attributes read once at discovery.
+qint64 readNumberOnce(const QString& path) {
+    const int fd = openReadOnly(path);
+    const qint64 value = readNumber(fd);
+#ifdef __linux__
+    if (fd >= 0) {
+        ::close(fd);
+    }
+#endif
+    return value;
+}
+
+QString readTextOnce(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return QString::fromUtf8(file.readAll()).trimmed();
+}
+
+}  // namespace
+
+ThermalMonitor::~ThermalMonitor() {
+    closeAll();
+}
+
+void ThermalMonitor::closeAll() {
+#ifdef __linux__
+    for (const Zone& zone : zones_) {
+        if (zone.tempFd >= 0) {
+            ::close(zone.tempFd);
+        }
+    }
+    for (const Policy& policy : policies_) {
+        for (int fd : {policy.curFd, policy.maxFd}) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+    }
+    for (const CoolingDevice& device : coolingDevices_) {
+        ::close(device.curStateFd);
+    }
+    for (const QVector<int>* fds : {&coreThrottleFds_, &packageThrottleFds_}) {
+        for (int fd : *fds) {
+            ::close(fd);
+        }
+    }
+#endif
+    zones_.clear();
+    policies_.clear();
+    coolingDevices_.clear();
+    coreThrottleFds_.clear();
+    packageThrottleFds_.clear();
+}
+
+void ThermalMonitor::discover() {
+    discovered_ = true;
+
+    const QDir thermalDir("/sys/class/thermal");
+    for (const QString& entry : thermalDir.entryList({"thermal_zone*"}, QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QString base = thermalDir.filePath(entry) + "/";
+        Zone zone;
+        zone.tempFd = openReadOnly(base + "temp");
+        if (zone.tempFd < 0) {
+            continue;
+        }
+        zone.name = readTextOnce(base + "type");
+        if (zone.name.isEmpty()) {
+            zone.name = entry;
+        }
+        for (int trip = 0;; ++trip) {
+            const QString type = readTextOnce(base + QString("trip_point_%1_type").arg(trip));
+            if (type.isEmpty()) {
+                break;
+            }
+            const qint64 temp = readNumberOnce(base + QString("trip_point_%1_temp").arg(trip));
+            // The lowest trip of each kind is where the kernel starts acting.
+            qint64* slot = type == "passive" ? &zone.passiveMilliC
+                : (type == "critical" ? &zone.criticalMilliC : nullptr);
+            if (slot != nullptr && temp > 0 && (*slot < 0 || temp < *slot)) {
+                *slot = temp;
+            }
+        }
+        zones_.append(zone);
+    }
+
+    const QDir cpufreqDir("/sys/devices/system/cpu/cpufreq");
+    for (const QString& entry : cpufreqDir.entryList({"policy*"}, QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QString base = cpufreqDir.filePath(entry) + "/";
+        Policy policy;
+        policy.name = entry;
+        policy.hardwareMaxKhz = readNumberOnce(base + "cpuinfo_max_freq");
+        policy.curFd = openReadOnly(base + "scaling_cur_freq");
+        policy.maxFd = openReadOnly(base + "scaling_max_freq");
+        if (policy.curFd < 0 && policy.maxFd < 0) {
+            continue;
+        }
+        policy.highestMaxKhz = readNumber(policy.maxFd);
+        policies_.append(policy);
+    }
+
+    // The devices that lower CPU frequency for heat; cur_state > 0 means
+    // they are doing it now.
+    for (const QString& entry : thermalDir.entryList({"cooling_device*"}, QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QString base = thermalDir.filePath(entry) + "/";
+        CoolingDevice device;
+        device.type = readTextOnce(base + "type");
+        if (!device.type.contains("cpufreq") && device.type != "Processor") {
+            continue;
+        }
+        device.curStateFd = openReadOnly(base + "cur_state");
+        if (device.curStateFd < 0) {
+            continue;
+        }
+        device.name = entry;
+        device.maxState = readNumberOnce(base + "max_state");
+        coolingDevices_.append(device);
+    }
+
+    // Intel only: counts of PROCHOT / thermal interrupts since boot.
+    const QDir cpuDir("/sys/devices/system/cpu");
+    for (const QString& entry : cpuDir.entryList({"cpu[0-9]*"}, QDir::Dirs | QDir::NoDotAndDotDot)) {
+        const QString base = cpuDir.filePath(entry) + "/thermal_throttle/";
+        const int coreFd = openReadOnly(base + "core_throttle_count");
+        if (coreFd >= 0) {
+            coreThrottleFds_.append(coreFd);
+        }
+        const int packageFd = openReadOnly(base + "package_throttle_count");
+        if (packageFd >= 0) {
+            packageThrottleFds_.append(packageFd);
+        }
+    }
+
+    Telemetry::instance().setGauge("thermal.open_files",
+                                   zones_.size() + policies_.size() * 2 + coolingDevices_.size()
+                                       + coreThrottleFds_.size() + packageThrottleFds_.size());
+}
+
+QJsonObject ThermalMonitor::sample() {
+    if (!discovered_) {
+        discover();
+    }
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    bool throttled = false;
+
+    QJsonArray zones;
+    double maxTempC = 0.0;
+    bool anyTemp = false;
+    for (const Zone& zone : zones_) {
+        const qint64 milliC = readNumber(zone.tempFd);
+        if (milliC < 0) {
+            continue;
+        }
+        const double tempC = static_cast<double>(milliC) / 1000.0;
+        QJsonObject out;
+        out.insert("name", zone.name);
+        out.insert("temp_c", tempC);
+        if (zone.passiveMilliC > 0) {
+            out.insert("passive_c", static_cast<double>(zone.passiveMilliC) / 1000.0);
+            throttled = throttled || milliC >= zone.passiveMilliC;
+        }
+        if (zone.criticalMilliC > 0) {
+            out.insert("critical_c", static_cast<double>(zone.criticalMilliC) / 1000.0);
+        }
+        zones.append(out);
+        maxTempC = anyTemp ? std::max(maxTempC, tempC) : tempC;
+        anyTemp = true;
+    }
+
+    QJsonArray coolingDevices;
+    for (const CoolingDevice& device : coolingDevices_) {
+        const qint64 state = readNumber(device.curStateFd);
+        if (state < 0) {
+            continue;
+        }
+        coolingDevices.append(QJsonObject{
+            {"name", device.name},
+            {"type", device.type},
+            {"cur_state", state},
+            {"max_state", device.maxState},
+        });
+        throttled = throttled || state > 0;
+    }
+
+    QJsonArray cpufreq;
+    double minRatio = 1.0;
+    for (Policy& policy : policies_) {
+        const qint64 curKhz = readNumber(policy.curFd);
+        const qint64 maxKhz = readNumber(policy.maxFd);
+        if (curKhz < 0 && maxKhz < 0) {
+            continue;
+        }
+        QJsonObject out;
+        out.insert("policy", policy.name);
+        out.insert("cur_mhz", static_cast<double>(curKhz) / 1000.0);
+        out.insert("max_mhz", static_cast<double>(maxKhz) / 1000.0);
+        if (policy.hardwareMaxKhz > 0) {
+            out.insert("hw_max_mhz", static_cast<double>(policy.hardwareMaxKhz) / 1000.0);
+            const double ratio = curKhz >= 0 ? static_cast<double>(curKhz) / policy.hardwareMaxKhz : 1.0;
+            // A 2% margin absorbs drivers that report a slightly lower cap.
+            const bool capped = maxKhz > 0 && maxKhz < policy.hardwareMaxKhz * 98 / 100;
+            out.insert("ratio", ratio);
+            out.insert("capped", capped);
+            minRatio = std::min(minRatio, ratio);
+        }
+        // A cap that was there at discovery is configuration, not heat; one
+        // applied since is, unless a cooling device already answers that.
+        const bool limited = maxKhz > 0 && policy.highestMaxKhz > 0 && maxKhz < policy.highestMaxKhz * 98 / 100;
+        policy.highestMaxKhz = std::max(policy.highestMaxKhz, maxKhz);
+        out.insert("limited", limited);
+        throttled = throttled || (limited && coolingDevices_.isEmpty());
+        cpufreq.append(out);
+    }
+
+    qint64 coreCount = 0;
+    for (int fd : coreThrottleFds_) {
+        coreCount += std::max<qint64>(0, readNumber(fd));
+    }
+    // Every CPU in a package reports the same package count.
+    qint64 packageCount = 0;
+    for (int fd : packageThrottleFds_) {
+        packageCount = std::max(packageCount, readNumber(fd));
+    }
+    const qint64 throttleCount = coreCount + packageCount;
+    if (previousThrottleCount_ >= 0 && throttleCount > previousThrottleCount_) {
+        throttled = true;
+    }
+    previousThrottleCount_ = throttleCount;
+
+    if (throttled && !wasThrottled_) {
+        throttleEvents_++;
+        Telemetry::instance().incrementCounter("thermal.throttle_events");
+    }
+    wasThrottled_ = throttled;
+
+    HistoryPoint& point = history_[historyHead_];
+    point.epochMs = nowMs;
+    point.maxTempC = maxTempC;
+    point.freqRatio = minRatio;
+    point.throttled = throttled;
+    historyHead_ = (historyHead_ + 1) % kHistoryCapacity;
+    historySize_ = std::min(historySize_ + 1, kHistoryCapacity);
+
+    QJsonArray historyEpochMs;
+    QJsonArray historyTemp;
+    QJsonArray historyRatio;
+    QJsonArray historyThrottled;
+    const int published = std::min(historySize_, kPublishedHistory);
+    for (int i = published; i > 0; --i) {
+        const HistoryPoint& entry = history_[(historyHead_ - i + kHistoryCapacity) % kHistoryCapacity];
+        historyEpochMs.append(entry.epochMs);
+        historyTemp.append(entry.maxTempC);
+        historyRatio.append(entry.freqRatio);
+        historyThrottled.append(entry.throttled);
+    }
+
+    QJsonObject out;
+    out.insert("zones", zones);
+    out.insert("cpufreq", cpufreq);
+    out.insert("cooling_devices", coolingDevices);
+    if (anyTemp) {
+        out.insert("max_temp_c", maxTempC);
+    }
+    out.insert("min_freq_ratio", minRatio);
+    if (!coreThrottleFds_.isEmpty() || !packageThrottleFds_.isEmpty()) {
+        out.insert("core_throttle_count", coreCount);
+        out.insert("package_throttle_count", packageCount);
+    }
+    out.insert("throttled", throttled);
+    out.insert("throttle_events", throttleEvents_);
+    out.insert("history",
+               QJsonObject{
+                   {"epoch_ms", historyEpochMs},
+                   {"max_temp_c", historyTemp},
+                   {"freq_ratio", historyRatio},
+                   {"throttled", historyThrottled},
+               });
+    return out;
+}
+
+}  // namespace rrcc
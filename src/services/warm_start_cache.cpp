@@ -0,0 +1,90 @@
+#include "rrcc/warm_start_cache.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+
+#include <utility>
+
+#include "rrcc/snapshot_codec.hpp"
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+WarmStartCache::WarmStartCache(QString path)
+    : path_(path.isEmpty() ? QDir(QDir::currentPath()).filePath("state/warm_start.cbor") : std::move(path)) {}
+
+QJsonObject WarmStartCache::load(qint64 maxAgeMs) const {
+    QJsonObject state = SnapshotCodec::readFile(path_);
+    if (state.isEmpty()) {
+        return {};
+    }
+    const qint64 ageMs =
+        QDateTime::currentMSecsSinceEpoch() - state.value("saved_epoch_ms").toInteger(0);
+    if (state.value("version").toInt() != kFormatVersion || ageMs > maxAgeMs) {
+        Telemetry::instance().incrementCounter("warm_start.discarded");
+        return {};
+    }
+    // Start times are only unique within one boot.
+    if (state.value("boot_id").toString() != bootId()) {
+        state.remove("classifications");
+    }
+    Telemetry::instance().setGauge("warm_start.age_ms", static_cast<double>(ageMs));
+    return state;
+}
+
+QJsonObject WarmStartCache::save(const QJsonObject& state) const {
+    QDir dir = QFileInfo(path_).absoluteDir();
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    QFile file(path_);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return {
+            {"success", false},
+            {"error", "Failed to open warm start cache for writing."},
+            {"path", path_},
+        };
+    }
+    QJsonObject stamped = state;
+    stamped.insert("version", kFormatVersion);
+    stamped.insert("boot_id", bootId());
+    stamped.insert("saved_epoch_ms", static_cast<double>(QDateTime::currentMSecsSinceEpoch()));
+    const QByteArray bytes = SnapshotCodec::encode(stamped, SnapshotCodec::formatForPath(path_));
+    file.write(bytes);
+    file.close();
+    Telemetry::instance().setGauge("warm_start.saved_bytes", static_cast<double>(bytes.size()));
+    return {
+        {"success", true},
+        {"path", path_},
+        {"bytes", static_cast<double>(bytes.size())},
+    };
+}
+
+QJsonValue WarmStartCache::markCached(const QJsonValue& value, qint64 cachedEpochMs) {
+    if (value.isObject()) {
+        QJsonObject object = value.toObject();
+        object.insert("cached_epoch_ms", static_cast<double>(cachedEpochMs));
+        return object;
+    }
+    if (value.isArray()) {
+        QJsonArray marked;
+        for (const QJsonValue& item : value.toArray()) {
+            marked.append(item.isObject() ? markCached(item, cachedEpochMs) : item);
+        }
+        return marked;
+    }
+    return value;
+}
+
+QString WarmStartCache::bootId() {
+    QFile file("/proc/sys/kernel/random/boot_id");
+    if (!file.open(QIODevice::ReadOnly)) {
+        return {};
+    }
+    return QString::fromUtf8(file.readAll()).trimmed();
+}
+
+}  // namespace rrcc
@@ -0,0 +1,423 @@
+#include "rrcc/watchdog_engine.hpp"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutexLocker>
+
+#include <utility>
+
+#include "rrcc/telemetry.hpp"
+
+namespace rrcc {
+
+namespace {
+
+const QStringList kActions = {"restart_domain", "kill_all_ros", "warn"};
+
+QJsonValue resolvePath(const QJsonValue& root, const QStringList& path) {
+    QJsonValue current = root;
+    for (const QString& key : path) {
+        current = current.toObject().value(key);
+    }
+    // Arrays compare by their length ("zombie_nodes > 0").
+    if (current.isArray()) {
+        return current.toArray().size();
+    }
+    return current;
+}
+
+bool compare(double lhs, const QString& op, double rhs) {
+    if (op == ">") {
+        return lhs > rhs;
+    }
+    if (op == ">=") {
+        return lhs >= rhs;
+    }
+    if (op == "<") {
+        return lhs < rhs;
+    }
+    if (op == "<=") {
+        return lhs <= rhs;
+    }
+    return qFuzzyCompare(lhs + 1.0, rhs + 1.0);
+}
+
+// Least-squares slope of (epoch ms, value) pairs, per second.
+double slopePerSecond(const QList<QPair<qint64, double>>& series) {
+    if (series.size() < 2) {
+        return 0.0;
+    }
+    const qint64 origin = series.first().first;
+    double sumX = 0.0;
+    double sumY = 0.0;
+    double sumXY = 0.0;
+    double sumXX = 0.0;
+    for (const auto& point : series) {
+        const double x = (point.first - origin) / 1000.0;
+        sumX += x;
+        sumY += point.second;
+        sumXY += x * point.second;
+        sumXX += x * x;
+    }
+    const double n = series.size();
+    const double denominator = n * sumXX - sumX * sumX;
+    return denominator > 0.0 ? (n * sumXY - sumX * sumY) / denominator : 0.0;
+}
+
+}  // namespace
+
+WatchdogEngine::WatchdogEngine() {
+    loadRules(defaultRules());
+}
+
+QJsonArray WatchdogEngine::defaultRules() {
+    return {
+        QJsonObject{
+            {"id", "zombie_nodes"},
+            {"kind", "metric"},
+            {"section", "health"},
+            {"path", "zombie_nodes"},
+            {"op", ">"},
+            {"value", 0},
+            {"action", "restart_domain"},
+        },
+        QJsonObject{
+            {"id", "cpu_critical"},
+            {"kind", "metric"},
+            {"section", "system"},
+            {"path", "cpu.usage_percent"},
+            {"op", ">"},
+            {"value", 95.0},
+            {"action", "kill_all_ros"},
+        },
+        QJsonObject{
+            {"id", "health_critical"},
+            {"kind", "metric"},
+            {"section", "health"},
+            {"path", "status"},
+            {"equals", "critical"},
+            {"action", "kill_all_ros"},
+        },
+        QJsonObject{
+            {"id", "soft_boundary_warnings"},
+            {"kind", "metric"},
+            {"section", "advanced"},
+            {"path", "soft_safety_boundary.warning_count"},
+            {"op", ">="},
+            {"value", 4},
+            {"action", "warn"},
+        },
+    };
+}
+
+bool WatchdogEngine::compileRule(const QJsonObject& json, Rule* rule, QString* error) {
+    rule->source = json;
+    rule->id = json.value("id").toString().trimmed();
+    if (rule->id.isEmpty()) {
+        *error = "Rule without an id.";
+        return false;
+    }
+    rule->action = json.value("action").toString("warn");
+    if (!kActions.contains(rule->action)) {
+        *error = QString("Rule %1: unsupported action %2.").arg(rule->id, rule->action);
+        return false;
+    }
+    rule->domainId = json.value("domain_id").toString();
+    rule->samples = qMax(1, json.value("samples").toInt(1));
+    rule->forMs = qMax<qint64>(0, json.value("for_ms").toInteger(0));
+    rule->cooldownMs = qMax<qint64>(1000, json.value("cooldown_ms").toInteger(12000));
+
+    const QString kind = json.value("kind").toString("metric");
+    if (kind == "metric") {
+        rule->kind = Kind::Metric;
+        rule->section = json.value("section").toString();
+        rule->path = json.value("path").toString().split('.', Qt::SkipEmptyParts);
+        rule->op = json.value("op").toString("==");
+        rule->threshold = json.value("value").toDouble();
+        rule->equals = json.value("equals").toString();
+        if (rule->section.isEmpty() || rule->path.isEmpty()) {
+            *error = QString("Rule %1: metric needs section and path.").arg(rule->id);
+            return false;
+        }
+        if (rule->equals.isEmpty() && !QStringList{">", ">=", "<", "<=", "=="}.contains(rule->op)) {
+            *error = QString("Rule %1: unsupported op %2.").arg(rule->id, rule->op);
+            return false;
+        }
+    } else if (kind == "node_missing") {
+        rule->kind = Kind::NodeMissing;
+        rule->section = "graph";
+        rule->target = json.value("node").toString();
+    } else if (kind == "topic_rate_below") {
+        rule->kind = Kind::TopicRateBelow;
+        rule->section = "advanced";
+        rule->target = json.value("topic").toString();
+        rule->ratio = json.value("ratio").toDouble(0.5);
+        rule->expectedHz = json.value("expected_hz").toDouble(-1.0);
+    } else if (kind == "rss_slope") {
+        rule->kind = Kind::RssSlope;
+        rule->section = "processes_all";
+        rule->target = json.value("process").toString();
+        rule->threshold = json.value("slope_kb_per_s").toDouble();
+        rule->windowMs = qMax<qint64>(5000, json.value("window_ms").toInteger(60000));
+    } else {
+        *error = QString("Rule %1: unsupported kind %2.").arg(rule->id, kind);
+        return false;
+    }
+    if (rule->kind != Kind::Metric && rule->target.isEmpty()) {
+        *error = QString("Rule %1: %2 needs a target.").arg(rule->id, kind);
+        return false;
+    }
+    return true;
+}
+
+QJsonObject WatchdogEngine::loadRules(const QJsonArray& rules) {
+    std::vector<Rule> compiled;
+    QHash<QString, QList<int>> bySection;
+    for (const QJsonValue& value : rules) {
+        Rule rule;
+        QString error;
+        if (!compileRule(value.toObject(), &rule, &error)) {
+            return {{"success", false}, {"error", error}};
+        }
+        bySection[rule.section].append(static_cast<int>(compiled.size()));
+        compiled.push_back(std::move(rule));
+    }
+
+    QMutexLocker lock(&mutex_);
+    rules_ = std::move(compiled);
+    rulesBySection_ = bySection;
+    Telemetry::instance().setGauge("watchdog.rule_count", static_cast<double>(rules_.size()));
+    return {{"success", true}, {"rule_count", static_cast<int>(rules_.size())}};
+}
+
+QJsonArray WatchdogEngine::rules() const {
+    QMutexLocker lock(&mutex_);
+    QJsonArray out;
+    for (const Rule& rule : rules_) {
+        out.append(rule.source);
+    }
+    return out;
+}
+
+bool WatchdogEngine::dependsOn(const QString& section) const {
+    // The graph also tells restart rules which domain is selected.
+    if (section == "graph") {
+        return true;
+    }
+    QMutexLocker lock(&mutex_);
+    return rulesBySection_.contains(section);
+}
+
+QStringList WatchdogEngine::sections() const {
+    QMutexLocker lock(&mutex_);
+    QStringList names = rulesBySection_.keys();
+    if (!names.contains("graph")) {
+        names.prepend("graph");
+    }
+    return names;
+}
+
+void WatchdogEngine::resetState() {
+    QMutexLocker lock(&mutex_);
+    for (Rule& rule : rules_) {
+        rule.active = false;
+        rule.consecutive = 0;
+        rule.series.clear();
+    }
+}
+
+int WatchdogEngine::evaluate(Rule& rule, const QJsonValue& value, qint64 sampleEpochMs) const {
+    switch (rule.kind) {
+    case Kind::Metric: {
+        const QJsonValue metric = resolvePath(value, rule.path);
+        if (metric.isUndefined() || metric.isNull()) {
+            return -1;
+        }
+        if (!rule.equals.isEmpty()) {
+            rule.detail = QString("%1 is %2").arg(rule.path.join('.'), metric.toString());
+            return metric.toString() == rule.equals ? 1 : 0;
+        }
+        rule.detail = QString("%1 = %2").arg(rule.path.join('.')).arg(metric.toDouble());
+        return compare(metric.toDouble(), rule.op, rule.threshold) ? 1 : 0;
+    }
+    case Kind::NodeMissing: {
+        const QJsonObject graph = value.toObject();
+        if (!rule.domainId.isEmpty() && graph.value("domain_id").toString() != rule.domainId) {
+            return -1;
+        }
+        for (const QJsonValue& nodeValue : graph.value("nodes").toArray()) {
+            const QJsonObject node = nodeValue.toObject();
+            if (node.value("full_name").toString() == rule.target
+                || node.value("node_name").toString() == rule.target) {
+                return 0;
+            }
+        }
+        rule.detail = QString("node %1 missing").arg(rule.target);
+        return 1;
+    }
+    case Kind::TopicRateBelow: {
+        const QJsonArray metrics =
+            value.toObject().value("topic_rate_analyzer").toObject().value("topic_metrics").toArray();
+        for (const QJsonValue& metricValue : metrics) {
+            const QJsonObject metric = metricValue.toObject();
+            if (metric.value("topic").toString() != rule.target) {
+                continue;
+            }
+            const double actual = metric.value("actual_hz").toDouble(-1.0);
+            const double expected =
+                rule.expectedHz > 0.0 ? rule.expectedHz : metric.value("expected_hz").toDouble(-1.0);
+            if (actual < 0.0 || expected <= 0.0) {
+                return -1;
+            }
+            rule.detail = QString("%1 at %2 Hz, expected %3 Hz").arg(rule.target).arg(actual).arg(expected);
+            return actual < expected * rule.ratio ? 1 : 0;
+        }
+        // Topics are sampled in turns; absence is not a reading.
+        return -1;
+    }
+    case Kind::RssSlope: {
+        double rssKb = 0.0;
+        bool found = false;
+        for (const QJsonValue& processValue : value.toArray()) {
+            const QJsonObject process = processValue.toObject();
+            if (process.value("node_name").toString() == rule.target
+                || process.value("name").toString() == rule.target) {
+                rssKb += process.value("rss_kb").toDouble();
+                found = true;
+            }
+        }
+        if (!found) {
+            rule.series.clear();
+            return -1;
+        }
+        rule.series.append({sampleEpochMs, rssKb});
+        while (!rule.series.isEmpty() && rule.series.first().first < sampleEpochMs - rule.windowMs) {
+            rule.series.removeFirst();
+        }
+        // Wait for half a window so one allocation burst is not a trend.
+        if (rule.series.size() < 3 || sampleEpochMs - rule.series.first().first < rule.windowMs / 2) {
+            return -1;
+        }
+        const double slope = slopePerSecond(rule.series);
+        rule.detail = QString("%1 RSS growing %2 kB/s").arg(rule.target).arg(slope, 0, 'f', 1);
+        return slope > rule.threshold ? 1 : 0;
+    }
+    }
+    return -1;
+}
+
+QList<WatchdogEngine::Firing> WatchdogEngine::ingest(
+    const QString& section,
+    const QJsonValue& value,
+    qint64 sampleEpochMs) {
+    QList<Firing> firings;
+    QMutexLocker lock(&mutex_);
+    if (section == "graph") {
+        lastDomainId_ = value.toObject().value("domain_id").toString(lastDomainId_);
+    }
+    const QList<int> indexes = rulesBySection_.value(section);
+    for (const int index : indexes) {
+        Rule& rule = rules_[static_cast<size_t>(index)];
+        QElapsedTimer timer;
+        timer.start();
+        const int result = evaluate(rule, value, sampleEpochMs);
+        const qint64 elapsedNs = timer.nsecsElapsed();
+        rule.evaluations++;
+        rule.evalNsTotal += elapsedNs;
+        rule.evalNsMax = qMax(rule.evalNsMax, elapsedNs);
+        const QString prefix = "watchdog.rule." + rule.id;
+        Telemetry::instance().incrementCounter(prefix + ".evaluations");
+        Telemetry::instance().setGauge(prefix + ".eval_us", rule.evalNsTotal / 1000.0 / rule.evaluations);
+        Telemetry::instance().setGauge(prefix + ".eval_us_max", rule.evalNsMax / 1000.0);
+
+        if (result < 0) {
+            continue;
+        }
+        if (result == 0) {
+            rule.active = false;
+            rule.consecutive = 0;
+            continue;
+        }
+        if (!rule.active) {
+            rule.active = true;
+            rule.activeSinceMs = sampleEpochMs;
+        }
+        rule.consecutive++;
+        rule.sampleEpochMs = sampleEpochMs;
+    }
+    fireDueLocked(QDateTime::currentMSecsSinceEpoch(), &firings);
+    return firings;
+}
+
+QList<WatchdogEngine::Firing> WatchdogEngine::tick(qint64 nowEpochMs) {
+    QList<Firing> firings;
+    QMutexLocker lock(&mutex_);
+    fireDueLocked(nowEpochMs, &firings);
+    return firings;
+}
+
+qint64 WatchdogEngine::dueEpochMs(const Rule& rule) const {
+    if (!rule.active || rule.consecutive < rule.samples) {
+        return -1;
+    }
+    qint64 due = qMax(rule.activeSinceMs + rule.forMs, rule.lastFiredMs + rule.cooldownMs);
+    if (rule.action != "warn") {
+        due = qMax(due, lastDestructiveMs_ + rule.cooldownMs);
+    }
+    return due;
+}
+
+void WatchdogEngine::fireDueLocked(qint64 nowEpochMs, QList<Firing>* firings) {
+    for (Rule& rule : rules_) {
+        const qint64 due = dueEpochMs(rule);
+        if (due < 0 || due > nowEpochMs) {
+            continue;
+        }
+        Firing firing;
+        firing.ruleId = rule.id;
+        firing.action = rule.action;
+        firing.domainId = rule.domainId.isEmpty() ? lastDomainId_ : rule.domainId;
+        firing.message = QString("Watchdog rule %1: %2").arg(rule.id, rule.detail);
+        // Measured from when the rule became eligible, not from the poll.
+        firing.latencyMs = nowEpochMs - qMax(rule.activeSinceMs + rule.forMs, rule.sampleEpochMs);
+        firings->append(firing);
+
+        rule.lastFiredMs = nowEpochMs;
+        rule.firedCount++;
+        if (rule.action != "warn") {
+            lastDestructiveMs_ = nowEpochMs;
+        }
+        Telemetry::instance().incrementCounter("watchdog.rule." + rule.id + ".fired");
+        Telemetry::instance().recordDurationMs("watchdog.rule." + rule.id + ".fire_latency_ms", firing.latencyMs);
+    }
+}
+
+qint64 WatchdogEngine::nextDeadlineEpochMs() const {
+    QMutexLocker lock(&mutex_);
+    qint64 next = -1;
+    for (const Rule& rule : rules_) {
+        const qint64 due = dueEpochMs(rule);
+        if (due >= 0 && (next < 0 || due < next)) {
+            next = due;
+        }
+    }
+    return next;
+}
+
+QJsonArray WatchdogEngine::status() const {
+    QMutexLocker lock(&mutex_);
+    QJsonArray out;
+    for (const Rule& rule : rules_) {
+        out.append(QJsonObject{
+            {"id", rule.id},
+            {"action", rule.action},
+            {"section", rule.section},
+            {"active", rule.active},
+            {"fired_count", static_cast<double>(rule.firedCount)},
+            {"last_fired_epoch_ms", static_cast<double>(rule.lastFiredMs)},
+        });
+    }
+    return out;
+}
+
+}  // namespace rrcc
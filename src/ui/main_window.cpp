@@ -20,11 +20,14 @@
 #include <QToolButton>
 #include <QDateTime>
 #include <QElapsedTimer>
-#include <QCryptographicHash>
 #include <QIcon>
 #include <QStyle>
 #include <QVBoxLayout>
 
+#include "rrcc/daemon_client.hpp"
+#include "rrcc/json_hash.hpp"
+#include "rrcc/kernel_log.hpp"
+#include "rrcc/resource_governor.hpp"
 #include "rrcc/telemetry.hpp"
 
 namespace rrcc {
@@ -129,8 +132,7 @@ qint64 pidFromRow(const QTableWidget* table, int row) {
 }
 
 QString hashArray(const QJsonArray& value) {
-    const QByteArray payload = QJsonDocument(value).toJson(QJsonDocument::Compact);
-    return QString::fromLatin1(QCryptographicHash::hash(payload, QCryptographicHash::Sha1).toHex());
+    return JsonHash::toHex(JsonHash::hash(value));
 }
 
 QString readLocalTextFile(const QString& path) {
@@ -171,6 +173,21 @@ QString sparkline(const QVector<double>& values, double maxValue = 100.0) {
     return out;
 }
 
+// False for the empty placeholders a full frame carries before a section
+// has been collected.
+bool hasContent(const QJsonValue& value) {
+    if (value.isArray()) {
+        return !value.toArray().isEmpty();
+    }
+    if (value.isObject()) {
+        return !value.toObject().isEmpty();
+    }
+    if (value.isString()) {
+        return !value.toString().isEmpty();
+    }
+    return !value.isNull() && !value.isUndefined();
+}
+
 QIcon themedIcon(const QWidget* widget, const QString& themeName, QStyle::StandardPixmap fallback) {
     const QIcon icon = QIcon::fromTheme(themeName);
     if (!icon.isNull()) {
@@ -184,8 +201,10 @@ QIcon themedIcon(const QWidget* widget, const QString& themeName, QStyle::Standa
 
 }  // namespace
 
-MainWindow::MainWindow() {
+MainWindow::MainWindow(const QString& attachEndpoint)
+    : attachEndpoint_(attachEndpoint) {
     setupUi();
+    Telemetry::instance().recordSinceStartup("startup.ui_built_ms");
     setupWorker();
     setupConnections();
     applyMode();
@@ -195,7 +214,9 @@ MainWindow::MainWindow() {
 MainWindow::~MainWindow() {
     if (workerThread_ != nullptr) {
         workerThread_->quit();
-        workerThread_->wait(3000);
+        // No timeout: destroying a running QThread aborts. Lanes stop between
+        // probes, so this takes at most one probe's timeout.
+        workerThread_->wait();
     }
 }
 
@@ -281,6 +302,11 @@ void MainWindow::setupUi() {
     healthLabel_->setStyleSheet(
         "font-size:16px;font-weight:800;padding:6px 10px;border-radius:8px;background:#26303a;color:#dce8f5;");
     presetLabel_ = new QLabel("Preset: default");
+    governorLabel_ = new QLabel("Load: normal");
+    governorLabel_->setToolTip("RosScope's own resource governor level");
+    warmStartLabel_ = new QLabel();
+    warmStartLabel_->setStyleSheet("padding:4px 8px;border-radius:6px;background:#2b3340;color:#b8c7d9;");
+    warmStartLabel_->setVisible(false);
     emergencyStopButton_->setMinimumHeight(34);
 
     auto* snapshotMenu = new QMenu(this);
@@ -316,6 +342,10 @@ void MainWindow::setupUi() {
         themedIcon(this, "document-export", QStyle::SP_DialogSaveButton),
         "Export",
         [this]() { sessionExportButton_->click(); });
+    sessionMenu->addAction(
+        themedIcon(this, "document-export", QStyle::SP_DialogSaveButton),
+        "Export as JSON",
+        [this]() { runGlobalAction("session_export", {{"format", "json"}}); });
     sessionMenu->addAction(
         themedIcon(this, "document-export", QStyle::SP_DialogSaveButton),
         "Export Telemetry",
@@ -380,6 +410,8 @@ void MainWindow::setupUi() {
     centerZone->addWidget(presetMenuButton);
     centerZone->addWidget(fleetMenuButton);
     centerZone->addWidget(presetLabel_);
+    centerZone->addWidget(governorLabel_);
+    centerZone->addWidget(warmStartLabel_);
 
     auto* rightZone = new QHBoxLayout();
     rightZone->addWidget(healthLabel_);
@@ -442,6 +474,7 @@ void MainWindow::setupUi() {
     processTable_->horizontalHeader()->setStretchLastSection(true);
     processLayout->addWidget(processTable_, 1);
     applyProcessTableMode();
+    processTab->setProperty("sections", QStringList{"processes_visible", "domain_summaries", "graph", "tf_nav2", "health", "advanced"});
     tabs_->addTab(processTab, "Processes");
 
     auto* domainTab = new QWidget();
@@ -490,6 +523,7 @@ void MainWindow::setupUi() {
     domainControls->addWidget(workspaceRelaunchInput_, 1);
     domainControls->addWidget(restartWorkspaceButton_);
     domainLayout->addLayout(domainControls);
+    domainTab->setProperty("sections", QStringList{"domain_summaries", "domains", "health"});
     tabs_->addTab(domainTab, "ROS Domains");
 
     auto* nodesTab = new QWidget();
@@ -518,6 +552,7 @@ void MainWindow::setupUi() {
     nodeRightLayout->addWidget(paramsText_, 1);
     nodeSplitter->addWidget(nodeRight);
     nodesLayout->addWidget(nodeSplitter, 1);
+    nodesTab->setProperty("sections", QStringList{"domains", "domain_detail", "graph", "advanced"});
     tabs_->addTab(nodesTab, "Nodes & Topics");
 
     auto* tfTab = new QWidget();
@@ -534,6 +569,7 @@ void MainWindow::setupUi() {
     nav2Text_->setPlaceholderText("TF tree");
     tfLayout->addWidget(tfTable_, 2);
     tfLayout->addWidget(nav2Text_, 1);
+    tfTab->setProperty("sections", QStringList{"domain_detail", "tf_nav2"});
     tabs_->addTab(tfTab, "TF");
 
     auto* systemTab = new QWidget();
@@ -591,13 +627,17 @@ void MainWindow::setupUi() {
     hardwareSplitter->addWidget(canText_);
     hardwareSplitter->addWidget(netText_);
     systemLayout->addWidget(hardwareSplitter, 1);
+    systemTab->setProperty("sections", QStringList{"system", "thermal", "can", "processes_visible"});
     tabs_->addTab(systemTab, "System & Hardware");
 
     auto* logsTab = new QWidget();
     auto* logsLayout = new QVBoxLayout(logsTab);
     logsText_ = new QPlainTextEdit();
     logsText_->setReadOnly(true);
+    // Matches the worker's kernel log ring; older lines scroll off.
+    logsText_->setMaximumBlockCount(300);
     logsLayout->addWidget(logsText_, 1);
+    logsTab->setProperty("sections", QStringList{"logs"});
     tabs_->addTab(logsTab, "Logs");
 
     auto* diagnosticsTab = new QWidget();
@@ -614,6 +654,7 @@ void MainWindow::setupUi() {
     diagnosticsTable_->horizontalHeader()->setStretchLastSection(true);
     diagnosticsLayout->addWidget(diagnosticsSummaryLabel_);
     diagnosticsLayout->addWidget(diagnosticsTable_, 1);
+    diagnosticsTab->setProperty("sections", QStringList{"advanced"});
     tabs_->addTab(diagnosticsTab, themedIcon(this, "utilities-system-monitor", QStyle::SP_ComputerIcon), "Diagnostics");
 
     auto* performanceTab = new QWidget();
@@ -630,6 +671,7 @@ void MainWindow::setupUi() {
     performanceTable_->horizontalHeader()->setStretchLastSection(true);
     performanceLayout->addWidget(performanceSummaryLabel_);
     performanceLayout->addWidget(performanceTable_, 1);
+    performanceTab->setProperty("sections", QStringList{"system", "processes_visible", "advanced"});
     tabs_->addTab(performanceTab, themedIcon(this, "office-chart-line", QStyle::SP_ArrowUp), "Performance");
 
     auto* safetyTab = new QWidget();
@@ -646,6 +688,7 @@ void MainWindow::setupUi() {
     safetyTable_->horizontalHeader()->setStretchLastSection(true);
     safetyLayout->addWidget(safetySummaryLabel_);
     safetyLayout->addWidget(safetyTable_, 1);
+    safetyTab->setProperty("sections", QStringList{"health", "advanced", "watchdog"});
     tabs_->addTab(safetyTab, themedIcon(this, "security-high", QStyle::SP_MessageBoxWarning), "Safety");
 
     auto* workspaceTab = new QWidget();
@@ -662,6 +705,7 @@ void MainWindow::setupUi() {
     workspaceTable_->horizontalHeader()->setStretchLastSection(true);
     workspaceLayout->addWidget(workspaceSummaryLabel_);
     workspaceLayout->addWidget(workspaceTable_, 1);
+    workspaceTab->setProperty("sections", QStringList{"advanced"});
     tabs_->addTab(workspaceTab, themedIcon(this, "folder-development", QStyle::SP_DirIcon), "Workspaces");
 
     auto* fleetTab = new QWidget();
@@ -678,6 +722,7 @@ void MainWindow::setupUi() {
     fleetTable_->horizontalHeader()->setStretchLastSection(true);
     fleetLayout->addWidget(fleetSummaryLabel_);
     fleetLayout->addWidget(fleetTable_, 1);
+    fleetTab->setProperty("sections", QStringList{"fleet"});
     tabs_->addTab(fleetTab, themedIcon(this, "network-workgroup", QStyle::SP_DirIcon), "Fleet");
     tabs_->setCurrentIndex(2);
 
@@ -691,6 +736,10 @@ void MainWindow::setupUi() {
     eventLoopLagTimer_->setInterval(1000);
     memoryWatchTimer_ = new QTimer(this);
     memoryWatchTimer_->setInterval(5000);
+    // Zero-delay, so queued arrivals merge in the mailbox before one render.
+    renderTimer_ = new QTimer(this);
+    renderTimer_->setInterval(0);
+    renderTimer_->setSingleShot(true);
     statusBar()->showMessage("Ready");
 
     connect(refreshButton, &QPushButton::clicked, this, [this]() { scheduleRefresh(0, true); });
@@ -706,97 +755,91 @@ void MainWindow::setupUi() {
 }
 
 void MainWindow::setupWorker() {
+    if (!attachEndpoint_.isEmpty()) {
+        daemonClient_ = new DaemonClient(attachEndpoint_, this);
+        daemonClient_->connectToDaemon();
+        mailbox_ = &attachedMailbox_;
+        return;
+    }
     workerThread_ = new QThread(this);
     worker_ = new RuntimeWorker();
+    mailbox_ = worker_->snapshotMailbox();
     worker_->moveToThread(workerThread_);
     connect(workerThread_, &QThread::finished, worker_, &QObject::deleteLater);
     workerThread_->start();
 }
 
 void MainWindow::setupConnections() {
-    connect(this, &MainWindow::pollRequested, worker_, &RuntimeWorker::poll, Qt::QueuedConnection);
-    connect(
-        this,
-        &MainWindow::actionRequested,
-        worker_,
-        &RuntimeWorker::runAction,
-        Qt::QueuedConnection);
-    connect(
-        this,
-        &MainWindow::nodeParametersRequested,
-        worker_,
-        &RuntimeWorker::fetchNodeParameters,
-        Qt::QueuedConnection);
-
-    connect(worker_, &RuntimeWorker::snapshotReady, this, [this](const QJsonObject& snapshot) {
-        refreshInFlight_ = false;
-        renderFromSnapshot(snapshot);
-        if (!isAllProcessesScopeActive()) {
-            scheduleRefresh(refreshIntervalMs_);
-        }
-    });
-    connect(worker_, &RuntimeWorker::actionFinished, this, [this](const QJsonObject& result) {
-        refreshInFlight_ = false;
-        const bool success = result.value("success").toBool(false);
-        const QString action = result.value("action").toString();
-        QString message = result.value("message").toString();
-        if (success && result.contains("path")) {
-            message = QString("Snapshot saved: %1").arg(result.value("path").toString());
-        }
-        if (!success && result.contains("error")) {
-            message = result.value("error").toString();
-        }
-        if (message.isEmpty()) {
-            if (success) {
-                message = QString("Action %1 completed").arg(action);
-            } else {
-                message = QString("Action %1 failed").arg(action);
-            }
-        }
-
-        if (action == "compare_snapshots" || action == "compare_with_previous") {
-            const QJsonObject summary = result.value("summary").toObject();
-            if (diagnosticsSummaryLabel_ != nullptr && !summary.isEmpty()) {
-                diagnosticsSummaryLabel_->setText(
-                    QString("Diagnostics overview | Snapshot diff nodes +%1/-%2, topics +%3/-%4")
-                        .arg(summary.value("nodes_added").toInt(0))
-                        .arg(summary.value("nodes_removed").toInt(0))
-                        .arg(summary.value("topics_added").toInt(0))
-                        .arg(summary.value("topics_removed").toInt(0)));
+    if (daemonClient_ != nullptr) {
+        // Attached mode: the daemon routes control actions to its own executor.
+        connect(this, &MainWindow::pollRequested, daemonClient_, &DaemonClient::poll);
+        connect(this, &MainWindow::actionRequested, daemonClient_, &DaemonClient::runAction);
+        connect(this, &MainWindow::controlActionRequested, daemonClient_, &DaemonClient::runAction);
+        connect(
+            this,
+            &MainWindow::nodeParametersRequested,
+            daemonClient_,
+            &DaemonClient::fetchNodeParameters);
+        connect(daemonClient_, &DaemonClient::snapshotReady, this, &MainWindow::handleSnapshotReady);
+        connect(daemonClient_, &DaemonClient::actionFinished, this, &MainWindow::handleActionFinished);
+        connect(
+            daemonClient_,
+            &DaemonClient::nodeParametersReady,
+            this,
+            &MainWindow::handleNodeParametersReady);
+        connect(
+            daemonClient_,
+            &DaemonClient::connectionChanged,
+            this,
+            [this](bool connected, const QString& message) {
+                showMessage(message, !connected);
+                if (connected) {
+                    // Deltas restart from a full snapshot on a new connection.
+                    markAllPanelsDirty();
+                }
+            });
+    } else {
+        connect(this, &MainWindow::pollRequested, worker_, &RuntimeWorker::poll, Qt::QueuedConnection);
+        connect(
+            this,
+            &MainWindow::actionRequested,
+            worker_,
+            &RuntimeWorker::runAction,
+            Qt::QueuedConnection);
+        connect(
+            this,
+            &MainWindow::nodeParametersRequested,
+            worker_,
+            &RuntimeWorker::fetchNodeParameters,
+            Qt::QueuedConnection);
+        // Process control actions skip the worker queue and run on the executor thread.
+        connect(
+            this,
+            &MainWindow::controlActionRequested,
+            worker_->actionExecutor(),
+            &ActionExecutor::execute,
+            Qt::QueuedConnection);
+        // Pulled from the worker's mailbox rather than queued per poll, so a
+        // slow render never builds a backlog of snapshots.
+        connect(worker_, &RuntimeWorker::snapshotAvailable, renderTimer_, [this]() {
+            if (!renderTimer_->isActive()) {
+                renderTimer_->start();
             }
-        }
-        if ((action == "load_preset" || action == "save_preset") && success && presetLabel_ != nullptr) {
-            presetLabel_->setText(
-                QString("Preset: %1").arg(result.value("preset_name").toString("default")));
-        }
-        if ((action == "fleet_refresh" || action == "remote_action") && result.contains("fleet")) {
-            cachedFleet_ = result.value("fleet").toObject();
-            renderFleetPanel();
-        }
-        if ((action == "watchdog_enable" || action == "watchdog_disable") && watchdogToggleButton_ != nullptr) {
-            const bool enabled = action == "watchdog_enable";
-            watchdogToggleButton_->setText(enabled ? "Watchdog: ON" : "Watchdog: OFF");
-        }
-
-        showMessage(message, !success);
-        scheduleRefresh(300, true);
-    });
-    connect(worker_, &RuntimeWorker::nodeParametersReady, this, [this](const QJsonObject& result) {
-        const QString node = result.value("node").toString();
-        if (result.value("success").toBool(false)) {
-            const QString parameters = result.value("parameters").toString();
-            cachedNodeParameters_.insert(node, parameters);
-            nodeParameterOrder_.append(node);
-            nodeParameterOrder_.removeDuplicates();
-            pruneNodeParameterCache();
-            paramsText_->setPlainText(parameters);
-            showMessage(QString("Loaded parameters for %1").arg(node));
-        } else {
-            paramsText_->setPlainText(result.value("error").toString());
-            showMessage(QString("Failed to load parameters for %1").arg(node), true);
-        }
-    });
+        });
+        connect(worker_, &RuntimeWorker::actionFinished, this, &MainWindow::handleActionFinished);
+        connect(
+            worker_->actionExecutor(),
+            &ActionExecutor::actionFinished,
+            this,
+            &MainWindow::handleActionFinished);
+        connect(
+            worker_,
+            &RuntimeWorker::nodeParametersReady,
+            this,
+            &MainWindow::handleNodeParametersReady);
+    }
 
+    connect(renderTimer_, &QTimer::timeout, this, &MainWindow::renderPendingSnapshot);
     connect(refreshTimer_, &QTimer::timeout, this, [this]() { queueRefresh(); });
     connect(refreshDebounceTimer_, &QTimer::timeout, this, [this]() { queueRefresh(); });
     connect(eventLoopLagTimer_, &QTimer::timeout, this, [this]() {
@@ -808,11 +851,11 @@ void MainWindow::setupConnections() {
         lastLagSampleEpochMs_ = now;
     });
     connect(memoryWatchTimer_, &QTimer::timeout, this, [this]() {
-        const qint64 rssKb = processMemoryRssKb();
-        Telemetry::instance().setGauge("memory.rss_kb", static_cast<double>(rssKb));
+        Telemetry::instance().setGauge("memory.rss_kb", static_cast<double>(SelfUsage::rssKb()));
         Telemetry::instance().exportToFile(
             QDir(QDir::currentPath()).filePath("logs/telemetry_live.json"));
-        if (rssKb > 800000) {
+        // The worker's governor trims its own caches; follow it on the UI side.
+        if (governorLevel_ >= static_cast<int>(ResourceGovernor::Level::ShrinkCaches)) {
             refreshIntervalMs_ = qMin(maxRefreshIntervalMs_, refreshIntervalMs_ + 1000);
             pruneNodeParameterCache();
         }
@@ -879,12 +922,12 @@ void MainWindow::setupConnections() {
     connect(snapshotYamlButton_, &QPushButton::clicked, this, [this]() { runGlobalAction("snapshot_yaml"); });
     connect(compareSnapshotButton_, &QPushButton::clicked, this, [this]() {
         const QString leftPath = QFileDialog::getOpenFileName(
-            this, "Select Older Snapshot", QDir::currentPath(), "JSON Files (*.json)");
+            this, "Select Older Snapshot", QDir::currentPath(), "Snapshots (*.json *.cbor)");
         if (leftPath.isEmpty()) {
             return;
         }
         const QString rightPath = QFileDialog::getOpenFileName(
-            this, "Select Newer Snapshot", QDir::currentPath(), "JSON Files (*.json)");
+            this, "Select Newer Snapshot", QDir::currentPath(), "Snapshots (*.json *.cbor)");
         if (rightPath.isEmpty()) {
             return;
         }
@@ -919,7 +962,7 @@ void MainWindow::setupConnections() {
     });
     connect(sessionStopButton_, &QPushButton::clicked, this, [this]() { runGlobalAction("session_stop"); });
     connect(sessionExportButton_, &QPushButton::clicked, this, [this]() {
-        runGlobalAction("session_export", {{"format", "json"}});
+        runGlobalAction("session_export", {{"format", "cbor"}});
     });
     connect(telemetryExportButton_, &QPushButton::clicked, this, [this]() {
         const QString defaultPath = QDir(QDir::currentPath()).filePath("logs/telemetry.json");
@@ -1054,9 +1097,26 @@ QJsonObject MainWindow::buildPollRequest() const {
     request.insert("process_offset", processOffset_);
     request.insert("process_limit", allProcessesScope ? qMin(processLimit_, 80) : processLimit_);
     request.insert("selected_domain", selectedDomainId());
-    request.insert("engineer_mode", modeCombo_->currentText() == "Engineer");
-    request.insert("active_tab", tabs_->currentIndex());
+    // The visible tab declares what it renders; everything else only feeds
+    // the header and health summary, at a slower rate.
+    const bool engineer = modeCombo_->currentText() == "Engineer";
+    const int backgroundMs = engineer ? 6000 : 12000;
+    QJsonObject interests{
+        {"health", backgroundMs},
+        {"system", backgroundMs},
+        {"watchdog", backgroundMs},
+        {"domain_summaries", backgroundMs},
+    };
+    if (engineer) {
+        interests.insert("advanced", backgroundMs);
+    }
+    const QStringList visibleSections = tabs_->currentWidget()->property("sections").toStringList();
+    for (const QString& section : visibleSections) {
+        interests.insert(section, engineer ? 1000 : 2000);
+    }
+    request.insert("interests", interests);
     request.insert("since_version", static_cast<double>(cachedSyncVersion_));
+    request.insert("requested_epoch_ms", static_cast<double>(QDateTime::currentMSecsSinceEpoch()));
     request.insert("if_none_match", cachedEtag_);
     return request;
 }
@@ -1104,23 +1164,36 @@ bool MainWindow::isAllProcessesScopeActive() const {
         && processScopeCombo_->currentText() == "All Processes";
 }
 
-qint64 MainWindow::processMemoryRssKb() {
-    QFile file("/proc/self/status");
-    if (!file.open(QIODevice::ReadOnly)) {
-        return -1;
+void MainWindow::updateGovernorLabel(const QJsonObject& governor) {
+    governorLevel_ = governor.value("level").toInt(0);
+    const QString name = governor.value("level_name").toString("normal");
+    governorLabel_->setText(QString("Load: %1").arg(QString(name).replace('_', ' ')));
+    governorLabel_->setToolTip(
+        QString("RosScope's own usage: %1% CPU of %2% budget, %3 MB RSS of %4 MB budget")
+            .arg(governor.value("cpu_percent").toDouble(), 0, 'f', 1)
+            .arg(governor.value("cpu_budget_percent").toDouble(), 0, 'f', 0)
+            .arg(governor.value("rss_kb").toDouble() / 1024.0, 0, 'f', 0)
+            .arg(governor.value("rss_budget_kb").toDouble() / 1024.0, 0, 'f', 0));
+    governorLabel_->setStyleSheet(
+        governorLevel_ > 0 ? "padding:4px 8px;border-radius:6px;background:#4a3e20;color:#ffefc0;" : "");
+}
+
+void MainWindow::updateWarmStartLabel(const QJsonObject& warmSections) {
+    warmStartLabel_->setVisible(!warmSections.isEmpty());
+    if (warmSections.isEmpty()) {
+        return;
     }
-    const QString text = QString::fromUtf8(file.readAll());
-    const QStringList lines = text.split('\n', Qt::SkipEmptyParts);
-    for (const QString& line : lines) {
-        if (!line.startsWith("VmRSS:")) {
-            continue;
-        }
-        const QStringList parts = line.split(' ', Qt::SkipEmptyParts);
-        if (parts.size() >= 2) {
-            return parts[1].toLongLong();
+    qint64 oldestMs = 0;
+    for (auto it = warmSections.constBegin(); it != warmSections.constEnd(); ++it) {
+        const qint64 cachedAt = static_cast<qint64>(it.value().toDouble(0));
+        if (oldestMs == 0 || (cachedAt > 0 && cachedAt < oldestMs)) {
+            oldestMs = cachedAt;
         }
     }
-    return -1;
+    warmStartLabel_->setText(
+        QString("Cached from last run (%1), revalidating")
+            .arg(QDateTime::fromMSecsSinceEpoch(oldestMs).toString("HH:mm")));
+    warmStartLabel_->setToolTip("Not yet refreshed: " + warmSections.keys().join(", "));
 }
 
 void MainWindow::updateProcessPaginationLabel() {
@@ -1174,6 +1247,47 @@ void MainWindow::applyProcessTableMode() {
     processTable_->setColumnHidden(11, compact);  // Launch
 }
 
+void MainWindow::markPanelsDirty(const QString& section) {
+    // Section -> panels that read it in their render function.
+    static const QHash<QString, QStringList> kPanelsBySection = {
+        {"processes_visible", {"processes", "system", "performance"}},
+        {"domain_summaries", {"domains"}},
+        {"domains", {"domains", "nodes_topics"}},
+        {"graph", {"processes", "nodes_topics"}},
+        {"tf_nav2", {"tf_nav2"}},
+        {"system", {"system", "performance"}},
+        {"can", {"system"}},
+        {"thermal", {"system"}},
+        {"logs", {"logs"}},
+        {"health", {"processes", "domains", "safety", "health_summary"}},
+        {"advanced",
+         {"processes", "nodes_topics", "diagnostics", "performance", "safety", "workspace",
+          "health_summary"}},
+        {"fleet", {"fleet"}},
+        {"watchdog", {"safety"}},
+    };
+    for (const QString& panel : kPanelsBySection.value(section)) {
+        dirtyPanels_.insert(panel);
+    }
+}
+
+void MainWindow::markAllPanelsDirty() {
+    dirtyPanels_ = {
+        "processes",
+        "domains",
+        "nodes_topics",
+        "tf_nav2",
+        "system",
+        "logs",
+        "diagnostics",
+        "performance",
+        "safety",
+        "workspace",
+        "fleet",
+        "health_summary",
+    };
+}
+
 void MainWindow::renderFromSnapshot(const QJsonObject& snapshot) {
     const QElapsedTimer renderTimer = []() {
         QElapsedTimer t;
@@ -1181,46 +1295,83 @@ void MainWindow::renderFromSnapshot(const QJsonObject& snapshot) {
         return t;
     }();
 
-    if (snapshot.contains("processes_visible")) {
+    // Deltas only carry sections newer than our sync version; merge those and
+    // remember which panels they feed.
+    if (!snapshot.value("delta").toBool(false)) {
+        markAllPanelsDirty();
+    }
+    const QJsonObject sectionVersions = snapshot.value("section_versions").toObject();
+    int mergedSections = 0;
+    auto accept = [&](const QString& section) {
+        if (!snapshot.contains(section)) {
+            return false;
+        }
+        const qint64 version = static_cast<qint64>(sectionVersions.value(section).toDouble(-1));
+        if (version >= 0 && version < cachedSectionVersions_.value(section, -1)) {
+            return false;
+        }
+        cachedSectionVersions_.insert(section, version);
+        markPanelsDirty(section);
+        mergedSections++;
+        if (!firstRenderedSections_.contains(section) && hasContent(snapshot.value(section))) {
+            firstRenderedSections_.insert(section);
+            Telemetry::instance().recordSinceStartup("startup.first_render_ms." + section);
+        }
+        return true;
+    };
+    if (accept("processes_visible")) {
         cachedProcessesVisible_ = snapshot.value("processes_visible").toArray();
     }
-    if (snapshot.contains("domain_summaries")) {
+    if (accept("domain_summaries")) {
         cachedDomainSummaries_ = snapshot.value("domain_summaries").toArray();
         updateProcessScopeOptions();
     }
-    if (snapshot.contains("domains")) {
+    if (accept("domains")) {
         cachedDomains_ = snapshot.value("domains").toArray();
     }
-    if (snapshot.contains("graph")) {
+    if (accept("graph")) {
         cachedGraph_ = snapshot.value("graph").toObject();
     }
-    if (snapshot.contains("tf_nav2")) {
+    if (accept("tf_nav2")) {
         cachedTfNav2_ = snapshot.value("tf_nav2").toObject();
     }
-    if (snapshot.contains("system")) {
+    if (accept("system")) {
         cachedSystem_ = snapshot.value("system").toObject();
     }
-    if (snapshot.contains("health")) {
+    if (accept("thermal")) {
+        cachedThermal_ = snapshot.value("thermal").toObject();
+    }
+    if (accept("can")) {
+        cachedCan_ = snapshot.value("can").toObject();
+    }
+    if (accept("health")) {
         cachedHealth_ = snapshot.value("health").toObject();
     }
-    if (snapshot.contains("advanced")) {
+    if (accept("advanced")) {
         cachedAdvanced_ = snapshot.value("advanced").toObject();
     }
-    if (snapshot.contains("fleet")) {
+    if (accept("fleet")) {
         cachedFleet_ = snapshot.value("fleet").toObject();
     }
-    if (snapshot.contains("session")) {
+    if (accept("session")) {
         cachedSession_ = snapshot.value("session").toObject();
     }
-    if (snapshot.contains("watchdog")) {
+    if (accept("watchdog")) {
         cachedWatchdog_ = snapshot.value("watchdog").toObject();
     }
-    if (snapshot.contains("logs")) {
-        cachedLogs_ = snapshot.value("logs").toString();
+    if (accept("governor")) {
+        updateGovernorLabel(snapshot.value("governor").toObject());
     }
-    if (snapshot.contains("node_parameters")) {
+    if (snapshot.contains("warm_sections")) {
+        updateWarmStartLabel(snapshot.value("warm_sections").toObject());
+    }
+    if (accept("logs")) {
+        cachedLogs_ = snapshot.value("logs").toObject();
+    }
+    if (accept("node_parameters")) {
         cachedNodeParameters_ = snapshot.value("node_parameters").toObject();
     }
+    Telemetry::instance().incrementCounter("ui.render.sections_merged", mergedSections);
     if (snapshot.contains("selected_domain")) {
         currentDomain_ = snapshot.value("selected_domain").toString("0");
     }
@@ -1245,18 +1396,28 @@ void MainWindow::renderFromSnapshot(const QJsonObject& snapshot) {
             cachedWatchdog_.value("enabled").toBool(false) ? "Watchdog: ON" : "Watchdog: OFF");
     }
 
-    renderProcesses();
-    renderDomains();
+    // Only repaint panels whose inputs arrived; hidden tabs keep their dirty
+    // flag until they are enabled again.
+    int renderedPanels = 0;
+    auto renderIfDirty = [&](const QString& panel, void (MainWindow::*render)()) {
+        if (!dirtyPanels_.remove(panel)) {
+            return;
+        }
+        (this->*render)();
+        renderedPanels++;
+    };
+    renderIfDirty("processes", &MainWindow::renderProcesses);
+    renderIfDirty("domains", &MainWindow::renderDomains);
 
     if (tabs_->isTabEnabled(2)) {
-        renderNodesTopics();
+        renderIfDirty("nodes_topics", &MainWindow::renderNodesTopics);
     }
     if (tabs_->isTabEnabled(3)) {
-        renderTfNav2();
+        renderIfDirty("tf_nav2", &MainWindow::renderTfNav2);
     }
-    renderSystemHardware();
+    renderIfDirty("system", &MainWindow::renderSystemHardware);
     if (tabs_->isTabEnabled(5)) {
-        renderLogs();
+        renderIfDirty("logs", &MainWindow::renderLogs);
     }
     const int activeTab = tabs_->currentIndex();
     if (activeTab == 0) {
@@ -1264,13 +1425,15 @@ void MainWindow::renderFromSnapshot(const QJsonObject& snapshot) {
             (processScopeCombo_ != nullptr && processScopeCombo_->currentText() == "All Processes");
         refreshIntervalMs_ = qMax(refreshIntervalMs_, allProcessesScope ? 5000 : 2200);
     }
-    renderDiagnosticsPanel();
-    renderPerformancePanel();
-    renderSafetyPanel();
-    renderWorkspacePanel();
-    renderFleetPanel();
-    renderHealthSummary();
+    renderIfDirty("diagnostics", &MainWindow::renderDiagnosticsPanel);
+    renderIfDirty("performance", &MainWindow::renderPerformancePanel);
+    renderIfDirty("safety", &MainWindow::renderSafetyPanel);
+    renderIfDirty("workspace", &MainWindow::renderWorkspacePanel);
+    renderIfDirty("fleet", &MainWindow::renderFleetPanel);
+    renderIfDirty("health_summary", &MainWindow::renderHealthSummary);
     updateProcessPaginationLabel();
+    Telemetry::instance().incrementCounter("ui.render.panels_rendered", renderedPanels);
+    Telemetry::instance().setGauge("ui.render.last_panels_rendered", renderedPanels);
     Telemetry::instance().recordDurationMs("ui.render.snapshot_ms", renderTimer.elapsed());
 }
 
@@ -1703,28 +1866,41 @@ void MainWindow::renderSystemHardware() {
     const double cpuPct = cpu.value("usage_percent").toDouble();
     const double memPct = mem.value("used_percent").toDouble();
     const double diskPct = disk.value("used_percent").toDouble();
-    appendHistory(&cpuHistory_, cpuPct);
-    appendHistory(&memHistory_, memPct);
-    appendHistory(&diskHistory_, diskPct);
+    const QJsonArray cores = cpu.value("cores").toArray();
+    // The panel also redraws for processes_visible; only a new system sample
+    // adds a history point. Without versions every render counts as new.
+    const qint64 systemVersion = cachedSectionVersions_.value("system", -1);
+    const bool newSample = systemVersion < 0 || systemVersion > historySystemVersion_;
+    historySystemVersion_ = qMax(historySystemVersion_, systemVersion);
+    if (newSample) {
+        appendHistory(&cpuHistory_, cpuPct);
+        appendHistory(&memHistory_, memPct);
+        appendHistory(&diskHistory_, diskPct);
+        for (const QJsonValue& value : cores) {
+            const QJsonObject core = value.toObject();
+            appendHistory(&coreHistory_[core.value("cpu").toInt()], core.value("usage_percent").toDouble());
+        }
 
-    qint64 totalNetBytes = 0;
-    for (const QJsonValue& value : cachedSystem_.value("network_interfaces").toArray()) {
-        const QJsonObject iface = value.toObject();
-        totalNetBytes += static_cast<qint64>(iface.value("rx_bytes").toDouble(0));
-        totalNetBytes += static_cast<qint64>(iface.value("tx_bytes").toDouble(0));
-    }
-    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
-    double netMbps = 0.0;
-    if (previousNetSampleMs_ > 0 && nowMs > previousNetSampleMs_ && totalNetBytes >= previousNetBytes_) {
-        const double dt = static_cast<double>(nowMs - previousNetSampleMs_) / 1000.0;
-        if (dt > 0.0) {
-            const double deltaBytes = static_cast<double>(totalNetBytes - previousNetBytes_);
-            netMbps = (deltaBytes * 8.0) / 1000000.0 / dt;
+        qint64 totalNetBytes = 0;
+        for (const QJsonValue& value : cachedSystem_.value("network_interfaces").toArray()) {
+            const QJsonObject iface = value.toObject();
+            totalNetBytes += static_cast<qint64>(iface.value("rx_bytes").toDouble(0));
+            totalNetBytes += static_cast<qint64>(iface.value("tx_bytes").toDouble(0));
+        }
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        double sampleMbps = 0.0;
+        if (previousNetSampleMs_ > 0 && nowMs > previousNetSampleMs_ && totalNetBytes >= previousNetBytes_) {
+            const double dt = static_cast<double>(nowMs - previousNetSampleMs_) / 1000.0;
+            if (dt > 0.0) {
+                const double deltaBytes = static_cast<double>(totalNetBytes - previousNetBytes_);
+                sampleMbps = (deltaBytes * 8.0) / 1000000.0 / dt;
+            }
         }
+        previousNetBytes_ = totalNetBytes;
+        previousNetSampleMs_ = nowMs;
+        appendHistory(&netHistory_, sampleMbps, 40);
     }
-    previousNetBytes_ = totalNetBytes;
-    previousNetSampleMs_ = nowMs;
-    appendHistory(&netHistory_, netMbps, 40);
+    const double netMbps = netHistory_.isEmpty() ? 0.0 : netHistory_.last();
 
     if (cpuGraphLabel_ != nullptr) {
         cpuGraphLabel_->setText(
@@ -1770,6 +1946,57 @@ void MainWindow::renderSystemHardware() {
                      .arg(memPct, 0, 'f', 1)
                      .arg(diskPct, 0, 'f', 1);
         lines << QString("Load Avg: %1").arg(loadAvg.isEmpty() ? "-" : loadAvg);
+        if (cpu.contains("iowait_percent")) {
+            lines << QString("CPU split: usr %1% | sys %2% | iowait %3% | irq %4% | softirq %5% | steal %6%")
+                         .arg(cpu.value("user_percent").toDouble(), 0, 'f', 1)
+                         .arg(cpu.value("system_percent").toDouble(), 0, 'f', 1)
+                         .arg(cpu.value("iowait_percent").toDouble(), 0, 'f', 1)
+                         .arg(cpu.value("irq_percent").toDouble(), 0, 'f', 1)
+                         .arg(cpu.value("softirq_percent").toDouble(), 0, 'f', 1)
+                         .arg(cpu.value("steal_percent").toDouble(), 0, 'f', 1);
+        }
+        if (!cachedThermal_.isEmpty()) {
+            QStringList parts;
+            if (cachedThermal_.contains("max_temp_c")) {
+                parts << QString("max %1 C").arg(cachedThermal_.value("max_temp_c").toDouble(), 0, 'f', 1);
+            }
+            if (!cachedThermal_.value("cpufreq").toArray().isEmpty()) {
+                parts << QString("CPU freq %1% of max")
+                             .arg(100.0 * cachedThermal_.value("min_freq_ratio").toDouble(1.0), 0, 'f', 0);
+            }
+            if (cachedThermal_.value("throttled").toBool(false)) {
+                parts << "THROTTLED";
+            }
+            parts << QString("%1 throttle events").arg(cachedThermal_.value("throttle_events").toInt());
+            QVector<double> temps;
+            for (const QJsonValue& value :
+                 cachedThermal_.value("history").toObject().value("max_temp_c").toArray()) {
+                temps.append(value.toDouble());
+            }
+            lines << QString("Thermal: %1 [%2]").arg(parts.join(" | "), sparkline(temps, 100.0));
+        }
+        const QJsonObject pressure = cachedSystem_.value("pressure").toObject();
+        if (!pressure.isEmpty()) {
+            QStringList parts;
+            for (const QString& resource : {QString("cpu"), QString("io"), QString("memory")}) {
+                const QJsonObject some = pressure.value(resource).toObject().value("some").toObject();
+                if (!some.isEmpty()) {
+                    parts << QString("%1 %2/%3")
+                                 .arg(resource)
+                                 .arg(some.value("avg10").toDouble(), 0, 'f', 1)
+                                 .arg(some.value("avg60").toDouble(), 0, 'f', 1);
+                }
+            }
+            lines << QString("Pressure (some avg10/avg60 %): %1").arg(parts.join(" | "));
+        }
+        for (const QJsonValue& value : cores) {
+            const QJsonObject core = value.toObject();
+            const int id = core.value("cpu").toInt();
+            lines << QString("cpu%1 %2% [%3]")
+                         .arg(id, -3)
+                         .arg(core.value("usage_percent").toDouble(), 5, 'f', 1)
+                         .arg(sparkline(coreHistory_.value(id)));
+        }
         lines << "Top visible by CPU:";
         const int topN = qMin(6, cachedProcessesVisible_.size());
         for (int i = 0; i < topN; ++i) {
@@ -1789,12 +2016,75 @@ void MainWindow::renderSystemHardware() {
 
     usbText_->setPlainText(joinArrayLines(cachedSystem_.value("usb_devices").toArray()));
     serialText_->setPlainText(joinArrayLines(cachedSystem_.value("serial_ports").toArray()));
-    canText_->setPlainText(joinArrayLines(cachedSystem_.value("can_interfaces").toArray()));
+    const QJsonArray canLinks = cachedCan_.value("interfaces").toArray();
+    if (canLinks.isEmpty()) {
+        canText_->setPlainText(joinArrayLines(cachedSystem_.value("can_interfaces").toArray()));
+    } else {
+        QStringList canLines;
+        for (const QJsonValue& value : canLinks) {
+            const QJsonObject link = value.toObject();
+            QString line = QString("%1 %2").arg(link.value("name").toString(),
+                                                link.value("state").toString(link.value("up").toBool() ? "UP" : "DOWN"));
+            if (link.contains("bitrate")) {
+                line += QString(" %1 kbit/s").arg(link.value("bitrate").toDouble() / 1000.0, 0, 'f', 0);
+            }
+            if (link.contains("bus_load_percent")) {
+                line += QString(" load %1%").arg(link.value("bus_load_percent").toDouble(), 0, 'f', 1);
+            }
+            if (link.contains("rx_fps")) {
+                line += QString(" rx %1/s tx %2/s")
+                            .arg(link.value("rx_fps").toDouble(), 0, 'f', 0)
+                            .arg(link.value("tx_fps").toDouble(), 0, 'f', 0);
+            }
+            const QJsonObject berr = link.value("berr").toObject();
+            if (!berr.isEmpty()) {
+                line += QString(" berr %1/%2").arg(berr.value("tx").toInt()).arg(berr.value("rx").toInt());
+            }
+            canLines << line;
+        }
+        canText_->setPlainText(canLines.join('\n'));
+    }
     netText_->setPlainText(formatNetworkInterfaces(cachedSystem_.value("network_interfaces").toArray()));
 }
 
 void MainWindow::renderLogs() {
-    logsText_->setPlainText(cachedLogs_);
+    const QJsonArray records = cachedLogs_.value("records").toArray();
+    if (cachedLogs_.contains("error")) {
+        logsText_->setPlainText(cachedLogs_.value("error").toString());
+        lastRenderedLogSeq_ = -1;
+        return;
+    }
+    if (records.isEmpty()) {
+        return;
+    }
+    // The section is the whole ring; append only records newer than the last
+    // render. Nothing rendered yet, or a lower last_seq after a source
+    // change, starts the view over.
+    const qint64 lastSeq = static_cast<qint64>(cachedLogs_.value("last_seq").toDouble(-1));
+    if (lastRenderedLogSeq_ < 0 || lastSeq < lastRenderedLogSeq_) {
+        logsText_->clear();
+        lastRenderedLogSeq_ = -1;
+    }
+    QStringList lines;
+    for (const QJsonValue& value : records) {
+        const QJsonObject record = value.toObject();
+        const qint64 seq = static_cast<qint64>(record.value("seq").toDouble());
+        if (seq <= lastRenderedLogSeq_) {
+            continue;
+        }
+        const int level = record.value("level").toInt(6);
+        const QString stamp = QDateTime::fromMSecsSinceEpoch(
+                                  static_cast<qint64>(record.value("epoch_ms").toDouble()))
+                                  .toString("yyyy-MM-dd HH:mm:ss");
+        // Warnings and worse carry their level, as dmesg --level would show them.
+        lines << (level <= 4 ? QString("[%1] %2: %3").arg(stamp, KernelLog::levelName(level),
+                                                             record.value("text").toString())
+                             : QString("[%1] %2").arg(stamp, record.value("text").toString()));
+        lastRenderedLogSeq_ = seq;
+    }
+    if (!lines.isEmpty()) {
+        logsText_->appendPlainText(lines.join('\n'));
+    }
 }
 
 void MainWindow::renderDiagnosticsPanel() {
@@ -2139,9 +2429,110 @@ void MainWindow::runProcessAction(const QString& action) {
 }
 
 void MainWindow::runGlobalAction(const QString& action, const QJsonObject& payload) {
+    if (ActionExecutor::handles(action)) {
+        QJsonObject timed = payload;
+        timed.insert("requested_epoch_ms", static_cast<double>(QDateTime::currentMSecsSinceEpoch()));
+        emit controlActionRequested(action, timed);
+        return;
+    }
     emit actionRequested(action, payload);
 }
 
+void MainWindow::handleSnapshotReady(const QJsonObject& snapshot) {
+    if (attachedMailbox_.put(snapshot) && !renderTimer_->isActive()) {
+        renderTimer_->start();
+    }
+}
+
+void MainWindow::renderPendingSnapshot() {
+    const QJsonObject snapshot = mailbox_->take();
+    if (snapshot.isEmpty()) {
+        return;
+    }
+    Telemetry::instance().setGauge("ui.snapshot_wait_ms", static_cast<double>(mailbox_->lastWaitMs()));
+    refreshInFlight_ = false;
+    QElapsedTimer renderElapsed;
+    renderElapsed.start();
+    renderFromSnapshot(snapshot);
+    if (!isAllProcessesScopeActive()) {
+        // Never ask for data faster than it can be drawn.
+        scheduleRefresh(qMax<int>(refreshIntervalMs_, static_cast<int>(renderElapsed.elapsed() * 2)));
+    }
+}
+
+void MainWindow::handleNodeParametersReady(const QJsonObject& result) {
+    const QString node = result.value("node").toString();
+    if (result.value("success").toBool(false)) {
+        const QString parameters = result.value("parameters").toString();
+        cachedNodeParameters_.insert(node, parameters);
+        nodeParameterOrder_.append(node);
+        nodeParameterOrder_.removeDuplicates();
+        pruneNodeParameterCache();
+        paramsText_->setPlainText(parameters);
+        if (result.value("changed_since_last_run").toBool(false)) {
+            showMessage(QString("Parameters for %1 changed since the last run").arg(node));
+        } else {
+            showMessage(QString("Loaded parameters for %1").arg(node));
+        }
+    } else {
+        paramsText_->setPlainText(result.value("error").toString());
+        showMessage(QString("Failed to load parameters for %1").arg(node), true);
+    }
+}
+
+void MainWindow::handleActionFinished(const QJsonObject& result) {
+    refreshInFlight_ = false;
+    const qint64 requestedAtMs = result.value("requested_epoch_ms").toInteger(0);
+    if (requestedAtMs > 0) {
+        Telemetry::instance().recordDurationMs(
+            "ui.action_roundtrip_ms",
+            QDateTime::currentMSecsSinceEpoch() - requestedAtMs);
+    }
+    const bool success = result.value("success").toBool(false);
+    const QString action = result.value("action").toString();
+    QString message = result.value("message").toString();
+    if (success && result.contains("path")) {
+        message = QString("Snapshot saved: %1").arg(result.value("path").toString());
+    }
+    if (!success && result.contains("error")) {
+        message = result.value("error").toString();
+    }
+    if (message.isEmpty()) {
+        if (success) {
+            message = QString("Action %1 completed").arg(action);
+        } else {
+            message = QString("Action %1 failed").arg(action);
+        }
+    }
+
+    if (action == "compare_snapshots" || action == "compare_with_previous") {
+        const QJsonObject summary = result.value("summary").toObject();
+        if (diagnosticsSummaryLabel_ != nullptr && !summary.isEmpty()) {
+            diagnosticsSummaryLabel_->setText(
+                QString("Diagnostics overview | Snapshot diff nodes +%1/-%2, topics +%3/-%4")
+                    .arg(summary.value("nodes_added").toInt(0))
+                    .arg(summary.value("nodes_removed").toInt(0))
+                    .arg(summary.value("topics_added").toInt(0))
+                    .arg(summary.value("topics_removed").toInt(0)));
+        }
+    }
+    if ((action == "load_preset" || action == "save_preset") && success && presetLabel_ != nullptr) {
+        presetLabel_->setText(
+            QString("Preset: %1").arg(result.value("preset_name").toString("default")));
+    }
+    if ((action == "fleet_refresh" || action == "remote_action") && result.contains("fleet")) {
+        cachedFleet_ = result.value("fleet").toObject();
+        renderFleetPanel();
+    }
+    if ((action == "watchdog_enable" || action == "watchdog_disable") && watchdogToggleButton_ != nullptr) {
+        const bool enabled = action == "watchdog_enable";
+        watchdogToggleButton_->setText(enabled ? "Watchdog: ON" : "Watchdog: OFF");
+    }
+
+    showMessage(message, !success);
+    scheduleRefresh(300, true);
+}
+
 void MainWindow::showMessage(const QString& message, bool error) const {
     if (error) {
         statusBar()->showMessage("ERROR: " + message, 8000);
@@ -0,0 +1,119 @@
+// Compares JSON and CBOR snapshot encodings on a synthetic snapshot with
+// 2000 processes and 200 graph nodes. Build with -DRRCC_BUILD_BENCHMARKS=ON.
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QTextStream>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "rrcc/snapshot_codec.hpp"
+
+using rrcc::SnapshotCodec;
+
+namespace {
+
+QJsonObject buildSnapshot(int processCount, int nodeCount) {
+    QJsonArray processes;
+    for (int i = 0; i < processCount; ++i) {
+        const bool isRos = i % 5 == 0;
+        processes.append(QJsonObject{
+            {"pid", 1000 + i},
+            {"ppid", 1},
+            {"name", QString("proc_%1").arg(i)},
+            {"state", "S"},
+            {"executable", QString("/opt/ros/humble/lib/pkg_%1/node_%1").arg(i % 40)},
+            {"command_line", QString("/opt/ros/humble/lib/pkg_%1/node_%1 --ros-args -r __node:=node_%2")
+                                 .arg(i % 40)
+                                 .arg(i)},
+            {"cpu_percent", (i % 17) * 0.37},
+            {"memory_percent", (i % 11) * 0.21},
+            {"threads", 4 + i % 9},
+            {"uptime_seconds", 3600.5 + i},
+            {"uptime_human", "1h 0m"},
+            {"ros_domain_id", QString::number(i % 3)},
+            {"is_ros", isRos},
+            {"node_name", isRos ? QString("node_%1").arg(i) : QString()},
+            {"namespace", "/"},
+            {"package", isRos ? QString("pkg_%1").arg(i % 40) : QString()},
+            {"workspace_origin", isRos ? "/opt/ros/humble" : ""},
+            {"launch_source", isRos ? "bringup.launch.py" : ""},
+        });
+    }
+
+    QJsonArray nodes;
+    for (int i = 0; i < nodeCount; ++i) {
+        QJsonArray publishers;
+        QJsonArray subscribers;
+        for (int t = 0; t < 6; ++t) {
+            publishers.append(QJsonObject{
+                {"topic", QString("/robot/topic_%1").arg((i + t) % 150)},
+                {"type", "sensor_msgs/msg/LaserScan"},
+            });
+            subscribers.append(QJsonObject{
+                {"topic", QString("/robot/topic_%1").arg((i * 3 + t) % 150)},
+                {"type", "geometry_msgs/msg/Twist"},
+            });
+        }
+        nodes.append(QJsonObject{
+            {"full_name", QString("/robot/node_%1").arg(i)},
+            {"publishers", publishers},
+            {"subscribers", subscribers},
+            {"lifecycle_state", "active"},
+        });
+    }
+
+    return {
+        {"timestamp_utc", "2026-01-01T00:00:00Z"},
+        {"sync_version", 4242},
+        {"processes_visible", processes},
+        {"graph", QJsonObject{{"domain_id", "0"}, {"nodes", nodes}}},
+        {"system", QJsonObject{{"cpu", QJsonObject{{"usage_percent", 37.5}}}}},
+    };
+}
+
+double medianMicros(int iterations, const std::function<void()>& work) {
+    std::vector<double> samples;
+    samples.reserve(static_cast<size_t>(iterations));
+    for (int i = 0; i < iterations; ++i) {
+        QElapsedTimer timer;
+        timer.start();
+        work();
+        samples.push_back(static_cast<double>(timer.nsecsElapsed()) / 1000.0);
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    QTextStream out(stdout);
+    const int iterations = 25;
+    const QJsonObject snapshot = buildSnapshot(2000, 200);
+
+    out << "format  bytes      encode_us  decode_us\n";
+    for (const SnapshotCodec::Format format : {SnapshotCodec::Format::Json, SnapshotCodec::Format::Cbor}) {
+        const QByteArray encoded = SnapshotCodec::encode(snapshot, format);
+        const double encodeUs = medianMicros(iterations, [&]() {
+            SnapshotCodec::encode(snapshot, format);
+        });
+        const double decodeUs = medianMicros(iterations, [&]() {
+            QJsonObject decoded;
+            SnapshotCodec::decode(encoded, format, &decoded);
+            // Touch the result so decoding cannot be skipped lazily.
+            decoded.value("processes_visible").toArray().size();
+        });
+        out << QString("%1%2%3%4\n")
+                   .arg(SnapshotCodec::extension(format), -8)
+                   .arg(encoded.size(), -11)
+                   .arg(qRound(encodeUs), -11)
+                   .arg(qRound(decodeUs));
+    }
+    return 0;
+}
@@ -7,8 +7,41 @@ cd "$ROOT_DIR"
 echo "[perf] building"
 cmake --build build -j"$(nproc)" >/dev/null
 
-echo "[perf] launching app for smoke window (12s)"
-QT_QPA_PLATFORM=offscreen timeout 12s ./build/RosScope >/tmp/RosScope_perf.out 2>/tmp/RosScope_perf.err || true
+if [[ "${1:-}" == "--can" ]]; then
+  # A 100 ms can subscription over JSON frames; the can collector should run
+  # close to 10 times a second.
+  echo "[perf] launching headless daemon with a 100 ms can subscriber (8s)"
+  ./build/rosscoped --socket rosscope-perf --tcp-port 7399 >/tmp/RosScope_perf.out 2>/tmp/RosScope_perf.err &
+  DAEMON_PID=$!
+  sleep 1
+  python3 - <<'PY'
+import json, socket, struct, time
+s = socket.create_connection(("127.0.0.1", 7399))
+body = json.dumps({"type": "subscribe", "sections": ["can"], "interval_ms": 100}).encode()
+s.sendall(struct.pack(">I", len(body) + 1) + b"J" + body)
+s.settimeout(0.5)
+deadline = time.time() + 6
+while time.time() < deadline:
+    try:
+        if not s.recv(65536):
+            break
+    except socket.timeout:
+        pass
+PY
+  kill -INT "$DAEMON_PID" 2>/dev/null || true
+  wait "$DAEMON_PID" 2>/dev/null || true
+  jq '.counters["collector.can.runs"], .counters["collector.can.skips"]' "$ROOT_DIR/logs/telemetry_last_exit.json"
+  echo "[perf] can smoke complete"
+  exit 0
+fi
+
+if [[ "${1:-}" == "--headless" ]]; then
+  echo "[perf] launching headless daemon for smoke window (12s)"
+  timeout -s INT 12s ./build/rosscoped --socket rosscope-perf >/tmp/RosScope_perf.out 2>/tmp/RosScope_perf.err || true
+else
+  echo "[perf] launching app for smoke window (12s)"
+  QT_QPA_PLATFORM=offscreen timeout 12s ./build/RosScope >/tmp/RosScope_perf.out 2>/tmp/RosScope_perf.err || true
+fi
 
 TELEM_FILE="$ROOT_DIR/logs/telemetry_last_exit.json"
 if [[ ! -f "$TELEM_FILE" ]]; then
@@ -24,8 +57,20 @@ echo "[perf] telemetry summary"
 jq '.requests_per_minute,
     .gauges["ui.event_loop_lag_ms"],
     .gauges["memory.rss_kb"],
+    .gauges["daemon.cpu_percent"],
+    .gauges["daemon.rss_kb"],
+    .gauges["sections.total_bytes"],
+    .gauges["session.retained_bytes"],
     .gauges["queue.offline_remote_actions"],
     .durations["sync.duration_ms"],
-    .durations["ui.render.process_list_ms"]' "$TELEM_FILE"
+    .durations["worker.poll_queue_latency_ms"],
+    .durations["worker.poll_timer_lateness_ms"],
+    .durations["actions.click_to_signal_ms"],
+    .counters["actions.click_to_signal_over_budget"],
+    .durations["ui.render.process_list_ms"],
+    .durations["ui.render.snapshot_ms"],
+    .counters["sync.sections_emitted"],
+    .counters["sync.sections_suppressed"],
+    .counters["sections.unchanged_publishes"]' "$TELEM_FILE"
 
 echo "[perf] smoke complete"